@@ -0,0 +1,52 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Muss vor allen System-Headern eingebunden werden (clock_gettime)
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * @brief Monotone Zeit in Sekunden.
+ */
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Einfacher deterministischer Zufallsgenerator (xorshift32).
+ */
+static inline uint32_t bench_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Verhindert, dass der Compiler Benchmark-Ergebnisse wegoptimiert
+extern volatile uint64_t bench_sink;
+
+// Anzahl Allokationen aus dem Projektcode (bench_alloc.c, gelinkt mit --wrap)
+extern volatile uint64_t bench_allocations;
+
+// 1 = Ergebnisse als JSON statt als Tabelle (Option --json)
+extern int bench_json;
+
+// --- Benchmark-Module ---
+int bench_resampler(int argc, char* argv[]);
+int bench_kernels(int argc, char* argv[]);
+int bench_library(int argc, char* argv[]);
+int bench_encoders(int argc, char* argv[]);
+int bench_pocsag(int argc, char* argv[]);
+int bench_crc(int argc, char* argv[]);
+int bench_fsk(int argc, char* argv[]);
+int bench_generator(int argc, char* argv[]);
+int bench_realtime(int argc, char* argv[]);
+
+#endif // BENCH_H
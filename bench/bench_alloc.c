@@ -0,0 +1,39 @@
+#include "bench.h"
+
+#include <stdlib.h>
+
+// Allokationszähler: der Benchmark wird mit -Wl,--wrap=... gelinkt, dadurch
+// landen alle malloc/calloc/realloc/posix_memalign-Aufrufe aus den Objekt-
+// dateien des Projekts hier (Aufrufe innerhalb der libc werden nicht gezählt).
+
+volatile uint64_t bench_allocations = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+int __real_posix_memalign(void** ptr, size_t alignment, size_t size);
+
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t count, size_t size);
+void* __wrap_realloc(void* ptr, size_t size);
+int __wrap_posix_memalign(void** ptr, size_t alignment, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    __atomic_add_fetch(&bench_allocations, 1, __ATOMIC_RELAXED);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    __atomic_add_fetch(&bench_allocations, 1, __ATOMIC_RELAXED);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    __atomic_add_fetch(&bench_allocations, 1, __ATOMIC_RELAXED);
+    return __real_realloc(ptr, size);
+}
+
+int __wrap_posix_memalign(void** ptr, size_t alignment, size_t size) {
+    __atomic_add_fetch(&bench_allocations, 1, __ATOMIC_RELAXED);
+    return __real_posix_memalign(ptr, alignment, size);
+}
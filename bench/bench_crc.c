@@ -0,0 +1,160 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/crc.h"
+#include "../include/encoders/ax25.h"
+
+#define CRC_BUFFER (64 * 1024)
+#define CRC_MAX_CHECK 2048
+#define CRC_ROUNDS 200
+#define CRC_FRAME 330 // Typischer AX.25-UI-Frame (APRS) in Bytes
+#define AX25_GOOD_RESIDUE 0xF0B8 // X.25-Rest über Frame samt FCS (ohne Invertierung)
+
+static const char* const engines[] = { "bitwise", "slice8", "clmul" };
+
+/**
+ * @brief Eine CRC-Familie: Varianten per Name und Prüfwert für "123456789".
+ */
+typedef struct {
+    const char* name;
+    crc16_update_fn (*engine)(const char* name);
+    uint16_t check;
+} crc_family;
+
+static const crc_family families[] = {
+    { "ccitt", crc16_ccitt_engine, 0xD64E },  // CRC-16/GENIBUS
+    { "x25", crc16_x25_engine, 0x906E },      // AX.25-FCS
+};
+
+/**
+ * @brief Prüft eine Variante gegen die bitweise Referenz ihrer Familie.
+ * * Bekannte Prüfwerte, alle Längen 0..CRC_MAX_CHECK mit zufälligem Zwischenstand
+ * und zufällige Aufteilungen in mehrere update-Aufrufe.
+ * @return int 0 bei identischen Ergebnissen, sonst 1.
+ */
+static int verify_engine(const crc_family* family, crc16_update_fn engine, const uint8_t* data) {
+    crc16_update_fn ref = family->engine("bitwise");
+    uint32_t seed = 0x9E3779B9;
+
+    // Prüfwert "123456789" (Start 0xFFFF, invertiert) und leere Eingabe
+    static const uint8_t check[] = "123456789";
+    uint16_t full = (uint16_t) ~engine(AX25_FCS_INIT, check, 9);
+    uint16_t empty = (uint16_t) ~engine(AX25_FCS_INIT, check, 0);
+    if (full != family->check || empty != 0x0000) return 1;
+
+    for (size_t length = 0; length <= CRC_MAX_CHECK; length++) {
+        uint16_t start = (uint16_t) bench_random(&seed);
+        const uint8_t* p = data + (bench_random(&seed) % 16); // auch unausgerichtet
+        if (engine(start, p, length) != ref(start, p, length)) return 1;
+    }
+
+    for (int i = 0; i < 2000; i++) {
+        size_t length = bench_random(&seed) % CRC_MAX_CHECK;
+        uint16_t expected = ref(AX25_FCS_INIT, data, length);
+        uint16_t crc = AX25_FCS_INIT;
+        size_t done = 0;
+        while (done < length) {
+            size_t n = bench_random(&seed) % (length - done + 1);
+            crc = engine(crc, data + done, n);
+            done += n;
+        }
+        if (crc != expected) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Prüft die FCS von ax25_build_frame wie ein Empfänger: die bitweise
+ * X.25-Referenz über Kopf, Info-Feld und FCS muss den festen Rest ergeben.
+ * * Die Frames entsprechen einer APRS-Übertragung mit mehreren Frames, samt
+ * Flag-Bytes und 0xFF-Folgen im Info-Feld.
+ * @return int 0 wenn alle Frames gültig sind, sonst 1.
+ */
+static int verify_ax25_frames(void) {
+    static const ax25_frame frames[] = {
+        { "DL1ABC-1", "APRS", "!5000.00N/00800.00E-Test 1" },
+        { "DL1ABC-1", "APRS", ":DL2XYZ   :Hallo ~~~{1" },
+        { "DL1ABC-1", "APRS", "T#001,\xff\xff\xff,~~~,255" },
+        { "N0CALL", "CQ", "" },
+    };
+    crc16_update_fn ref = crc16_x25_engine("bitwise");
+
+    for (size_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+        uint8_t header[AX25_HEADER_LEN];
+        uint8_t fcs[2];
+        ax25_build_frame(&frames[i], header, fcs);
+
+        uint16_t crc = ref(AX25_FCS_INIT, header, sizeof(header));
+        crc = ref(crc, (const uint8_t*) frames[i].message, strlen(frames[i].message));
+        if (ref(crc, fcs, sizeof(fcs)) != AX25_GOOD_RESIDUE) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Durchsatz einer Variante in MB/s für Blöcke der Länge length.
+ */
+static double measure(const crc_family* family, crc16_update_fn engine, const uint8_t* data, size_t length) {
+    size_t blocks = CRC_BUFFER / length;
+    int rounds = CRC_ROUNDS;
+    if (engine == family->engine("bitwise")) {
+        rounds /= 10;
+    }
+
+    double start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t b = 0; b < blocks; b++) {
+            bench_sink += engine(AX25_FCS_INIT, data + b * length, length);
+        }
+    }
+    double elapsed = bench_now() - start;
+    return (double)(blocks * length) * rounds / elapsed / 1e6;
+}
+
+/**
+ * @brief Prüft alle CRC-16-Varianten der CPU auf Gleichheit mit der Referenz und misst den Durchsatz.
+ */
+int bench_crc(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    uint8_t* data = (uint8_t*) malloc(CRC_BUFFER + 16);
+    if (data == NULL) {
+        fprintf(stderr, "Fehler: Speicherzuweisung fehlgeschlagen.\n");
+        return 1;
+    }
+    uint32_t seed = 0x1234567;
+    for (size_t i = 0; i < CRC_BUFFER + 16; i++) {
+        data[i] = (uint8_t) bench_random(&seed);
+    }
+
+    printf("%-14s %8s %12s %12s   (MB/s, aktiv: %s)\n", "crc16", "ident", "64 KiB", "330 B",
+           crc16_ccitt_engine_name());
+
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+        const crc_family* family = &families[f];
+        for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+            crc16_update_fn engine = family->engine(engines[e]);
+            if (engine == NULL) {
+                continue;
+            }
+
+            int mismatch = verify_engine(family, engine, data);
+            result |= mismatch;
+
+            printf("%-5s %-8s %8s %12.1f %12.1f\n", family->name, engines[e], mismatch ? "FEHLER" : "ok",
+                   measure(family, engine, data, CRC_BUFFER), measure(family, engine, data, CRC_FRAME));
+        }
+    }
+
+    int invalid = verify_ax25_frames();
+    result |= invalid;
+    printf("%-14s %8s\n", "ax25 fcs", invalid ? "FEHLER" : "ok");
+
+    free(data);
+    return result;
+}
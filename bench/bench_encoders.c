@@ -0,0 +1,271 @@
+#define _GNU_SOURCE // syscall(), perf_event_open
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "../include/rawsignal.h"
+#include "../include/kernels.h"
+
+#define ENCODER_MIN_SECONDS 0.25 // Messdauer je Fall (mindestens)
+#define ENCODER_MIN_RENDERS 3
+
+// --- KORPUS ---
+// Feste Nachrichten je Encoder; Änderungen hier machen Ergebnisse zwischen
+// Builds unvergleichbar und sollten daher selten sein.
+#define CORPUS_TEXT "RAWSIGNAL BENCH 0123456789 ALARM FEUERWEHR EINSATZ"
+#define CORPUS_BYTES "The quick brown fox jumps over the lazy dog 0123456789"
+
+typedef enum { ENC_POCSAG, ENC_DTMF, ENC_MORSE, ENC_AFSK1200, ENC_UFSK1200, ENC_FSK9600 } encoder_kind;
+
+typedef struct {
+    const char* name;
+    encoder_kind kind;
+    uint32_t param;   // POCSAG: Baud, MORSE: WPM
+} encoder_case;
+
+static const encoder_case cases[] = {
+    { "POCSAG_512", ENC_POCSAG, 512 },
+    { "POCSAG_1200", ENC_POCSAG, 1200 },
+    { "POCSAG_2400", ENC_POCSAG, 2400 },
+    { "DTMF", ENC_DTMF, 0 },
+    { "MORSE_CW_15", ENC_MORSE, 15 },
+    { "MORSE_CW_25", ENC_MORSE, 25 },
+    { "MORSE_CW_40", ENC_MORSE, 40 },
+    { "AFSK1200", ENC_AFSK1200, 0 },
+    { "UFSK1200", ENC_UFSK1200, 0 },
+    { "FSK9600", ENC_FSK9600, 0 },
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+static int render(rs_context* ctx, const encoder_case* c) {
+    switch (c->kind) {
+        case ENC_POCSAG: return rs_render_pocsag(ctx, c->param, 1234567, 3, CORPUS_TEXT);
+        case ENC_DTMF: return rs_render_dtmf(ctx, "0123456789*#ABCD", 50, 50);
+        case ENC_MORSE: return rs_render_morse(ctx, CORPUS_TEXT, c->param);
+        case ENC_AFSK1200: return rs_render_afsk1200(ctx, "DL1ABC-1", "APRS", CORPUS_BYTES);
+        case ENC_UFSK1200: return rs_render_ufsk1200(ctx, CORPUS_BYTES);
+        default: return rs_render_fsk9600(ctx, "DL1ABC-1", "APRS", CORPUS_BYTES);
+    }
+}
+
+// Callback-Ausgabe: zählt nur, damit der Encoder und nicht memcpy gemessen wird
+typedef struct {
+    uint64_t samples;
+    double start;
+    double firstSample;  // Zeitpunkt des ersten Blocks (< 0 = noch keiner)
+} count_state;
+
+static int count_output(void* user, const int16_t* samples, size_t count) {
+    count_state* st = (count_state*) user;
+    if (st->firstSample < 0) {
+        st->firstSample = bench_now();
+    }
+    st->samples += count;
+    bench_sink += (uint64_t)samples[0];
+    return 0;
+}
+
+// --- HARDWARE-ZÄHLER ---
+// Zyklen und Cache-Misses (nur Userspace) per perf_event_open; ohne Rechte
+// (perf_event_paranoid) oder außerhalb von Linux fehlen sie im Ergebnis.
+
+typedef struct {
+    int cycles;
+    int misses;
+} perf_counters;
+
+#ifdef __linux__
+static int perf_open(uint64_t config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (group < 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+
+static void perf_start(perf_counters* pc) {
+    pc->cycles = -1;
+    pc->misses = -1;
+#ifdef __linux__
+    pc->cycles = perf_open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (pc->cycles < 0) {
+        return;
+    }
+    pc->misses = perf_open(PERF_COUNT_HW_CACHE_MISSES, pc->cycles);
+    ioctl(pc->cycles, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(pc->cycles, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/**
+ * @brief Stoppt die Zähler und liest sie aus (-1 = nicht verfügbar).
+ */
+static void perf_stop(perf_counters* pc, int64_t* cycles, int64_t* misses) {
+    *cycles = -1;
+    *misses = -1;
+#ifdef __linux__
+    if (pc->cycles < 0) {
+        return;
+    }
+    ioctl(pc->cycles, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t value;
+    if (read(pc->cycles, &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+        *cycles = (int64_t)value;
+    }
+    if (pc->misses >= 0 && read(pc->misses, &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+        *misses = (int64_t)value;
+    }
+    close(pc->cycles);
+    if (pc->misses >= 0) {
+        close(pc->misses);
+    }
+#endif
+}
+
+typedef struct {
+    uint64_t renders;
+    uint64_t samplesPerRender;
+    double seconds;
+    double ttfsMin;             // Kürzeste Zeit bis zum ersten Block (s)
+    double allocsPerRender;
+    long peakRssKb;
+    int64_t cycles;             // -1 = nicht verfügbar
+    int64_t cacheMisses;
+} encoder_result;
+
+/**
+ * @brief Misst einen Fall: ein Aufwärm-Durchlauf, dann Wiederholungen bis
+ * ENCODER_MIN_SECONDS erreicht sind.
+ * @return 0 bei Erfolg, 1 wenn der Encoder fehlschlägt.
+ */
+static int measure(rs_context* ctx, const encoder_case* c, encoder_result* r) {
+    count_state st = { 0, 0.0, -1.0 };
+    rs_context_set_output(ctx, count_output, &st);
+
+    // Aufwärmen: Puffer wachsen auf ihre endgültige Größe
+    if (render(ctx, c) != RS_OK) {
+        return 1;
+    }
+    r->samplesPerRender = st.samples;
+    r->ttfsMin = 1e9;
+
+    uint64_t allocsBefore = bench_allocations;
+    perf_counters pc;
+    perf_start(&pc);
+
+    double start = bench_now();
+    double now = start;
+    r->renders = 0;
+    while (r->renders < ENCODER_MIN_RENDERS || now - start < ENCODER_MIN_SECONDS) {
+        st.start = bench_now();
+        st.firstSample = -1.0;
+        if (render(ctx, c) != RS_OK) {
+            perf_stop(&pc, &r->cycles, &r->cacheMisses);
+            return 1;
+        }
+        now = bench_now();
+        if (st.firstSample >= 0 && st.firstSample - st.start < r->ttfsMin) {
+            r->ttfsMin = st.firstSample - st.start;
+        }
+        r->renders++;
+    }
+    r->seconds = now - start;
+
+    perf_stop(&pc, &r->cycles, &r->cacheMisses);
+    r->allocsPerRender = (double)(bench_allocations - allocsBefore) / (double)r->renders;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    r->peakRssKb = usage.ru_maxrss;
+    return 0;
+}
+
+static void print_json_counter(const char* key, int64_t value, double divisor, const char* suffix) {
+    if (value < 0) {
+        printf("\"%s\": null%s", key, suffix);
+    } else {
+        printf("\"%s\": %.4f%s", key, (double)value / divisor, suffix);
+    }
+}
+
+/**
+ * @brief Misst alle Encoder über den festen Korpus (Ausgabe mit nativer Rate,
+ * Callback ohne Kopie). Mit --json als JSON-Dokument, sonst als Tabelle.
+ */
+int bench_encoders(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    rs_context* ctx = rs_context_create(RS_NATIVE_RATE);
+    if (ctx == NULL) {
+        fprintf(stderr, "Fehler: Kontext konnte nicht angelegt werden.\n");
+        return 1;
+    }
+
+    if (bench_json) {
+        printf("{\n  \"benchmark\": \"encoders\",\n  \"kernels\": \"%s\",\n  \"sample_rate\": %u,\n  \"results\": [\n",
+               rs_kernels()->name, (unsigned)RS_NATIVE_RATE);
+    } else {
+        printf("%-16s %10s %10s %10s %10s %10s %10s %12s %12s\n", "encoder", "samples", "Msamples/s",
+               "ns/sample", "ttfs us", "allocs", "rss KiB", "cycles/smp", "misses/rend");
+    }
+
+    int result = 0;
+    for (size_t i = 0; i < NUM_CASES; i++) {
+        encoder_result r;
+        memset(&r, 0, sizeof(r));
+        if (measure(ctx, &cases[i], &r) != 0) {
+            fprintf(stderr, "Fehler: Encoder %s fehlgeschlagen.\n", cases[i].name);
+            result = 1;
+            continue;
+        }
+
+        double samples = (double)r.samplesPerRender * (double)r.renders;
+        double nsPerSample = r.seconds * 1e9 / samples;
+
+        if (bench_json) {
+            printf("    { \"name\": \"%s\", \"samples_per_render\": %llu, \"renders\": %llu, "
+                   "\"samples_per_sec\": %.0f, \"ns_per_sample\": %.4f, \"ttfs_us\": %.3f, "
+                   "\"allocs_per_render\": %.2f, \"peak_rss_kb\": %ld, ",
+                   cases[i].name, (unsigned long long)r.samplesPerRender, (unsigned long long)r.renders,
+                   samples / r.seconds, nsPerSample, r.ttfsMin * 1e6, r.allocsPerRender, r.peakRssKb);
+            print_json_counter("cycles_per_sample", r.cycles, samples, ", ");
+            print_json_counter("cache_misses_per_render", r.cacheMisses, (double)r.renders,
+                               (i + 1 < NUM_CASES) ? " },\n" : " }\n");
+        } else {
+            char cycles[16] = "-";
+            char misses[16] = "-";
+            if (r.cycles >= 0) {
+                snprintf(cycles, sizeof(cycles), "%.2f", (double)r.cycles / samples);
+            }
+            if (r.cacheMisses >= 0) {
+                snprintf(misses, sizeof(misses), "%.0f", (double)r.cacheMisses / (double)r.renders);
+            }
+            printf("%-16s %10llu %10.2f %10.3f %10.1f %10.2f %10ld %12s %12s\n", cases[i].name,
+                   (unsigned long long)r.samplesPerRender, samples / r.seconds / 1e6, nsPerSample,
+                   r.ttfsMin * 1e6, r.allocsPerRender, r.peakRssKb, cycles, misses);
+        }
+    }
+
+    if (bench_json) {
+        printf("  ]\n}\n");
+    }
+
+    rs_context_destroy(ctx);
+    return result;
+}
@@ -0,0 +1,170 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fsk.h"
+#include "../include/oscillator.h"
+
+#define FSK_SAMPLES (4 * 1024 * 1024) // Je Fall, unabhängig von der Symboldauer
+#define FSK_ROUNDS 20
+
+// Größte erlaubte Abweichung zur Referenz: halbe Phasenstufe bei voller
+// Amplitude (32767 * sin(PI / 1024) ~ 100.5) plus Rundung der Tabelle
+#define FSK_MAX_DEVIATION 102
+
+typedef struct {
+    const char* name;
+    double mark;
+    double space;
+    uint32_t baud;
+    uint32_t sampleRate;
+} fsk_case;
+
+static const fsk_case cases[] = {
+    { "afsk1200", 1200, 2200, 1200, 22050 },
+    { "fsk9600", 4800, 8400, 9600, 22050 },
+    { "afsk-48k", 1200, 2200, 1200, 48000 },
+    { "rtty-45", 2125, 2295, 45, 22050 },
+    { "lang-11", 1000, 1200, 11, 22050 },   // 2004.5 Samples, knapp unter dem Puffer
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+/**
+ * @brief Referenz: NCO je Symbol neu eingestellt, Symbol i endet bei Sample
+ * floor((i + 1) * sampleRate / baud).
+ * * Mit sink wird wie früher in den Encodern jedes Symbol einzeln geschrieben.
+ * @return size_t Anzahl Samples.
+ */
+static size_t render_reference(const fsk_case* c, const uint8_t* tones, size_t count, int16_t* out, rs_sink* sink) {
+    rs_oscillator osc;
+    rs_osc_init(&osc, c->mark, c->sampleRate, 1);
+    uint32_t inc[2] = { rs_osc_increment(c->space, c->sampleRate), rs_osc_increment(c->mark, c->sampleRate) };
+
+    size_t start = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t end = (size_t)((uint64_t)(i + 1) * c->sampleRate / c->baud);
+        osc.phase_inc = inc[tones[i]];
+        rs_osc_render(&osc, out + start, end - start);
+        if (sink != NULL) {
+            rs_sink_write(sink, out + start, end - start);
+        }
+        start = end;
+    }
+    return start;
+}
+
+/**
+ * @brief Ungültige Symbollängen muss rs_fsk_table_init ablehnen.
+ * @return int 0 wenn alle abgelehnt werden, sonst 1.
+ */
+static int verify_limits(void) {
+    rs_fsk_table table;
+    int failed = 0;
+    failed |= rs_fsk_table_init(&table, NULL, 1200, 2200, 0, 22050) == 0;
+    failed |= rs_fsk_table_init(&table, NULL, 1200, 2200, 22051, 22050) == 0;
+    failed |= rs_fsk_table_init(&table, NULL, 1000, 1200, 10, 22050) == 0; // 2205 Samples
+    return failed;
+}
+
+/**
+ * @brief Vergleicht den Tabellen-Modulator mit dem NCO und misst Msymbole/s.
+ */
+int bench_fsk(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    printf("%-10s %12s %12s %10s %8s   (Msymbole/s)\n", "fsk", "nco", "tabelle", "max.abw", "ident");
+
+    for (size_t k = 0; k < NUM_CASES; k++) {
+        const fsk_case* c = &cases[k];
+        size_t symbols = FSK_SAMPLES / RS_FSK_SYMBOL_MAX(c->sampleRate, c->baud);
+        size_t samples = (size_t)((uint64_t)symbols * c->sampleRate / c->baud);
+
+        int16_t* storage = (int16_t*) malloc(RS_FSK_TABLE_SAMPLES(c->sampleRate, c->baud) * sizeof(int16_t));
+        int16_t* expected = (int16_t*) malloc(samples * sizeof(int16_t));
+        uint8_t* tones = (uint8_t*) malloc(symbols);
+        uint32_t* words = (uint32_t*) malloc((symbols / 32 + 1) * sizeof(uint32_t));
+        rs_sink memory;
+        if (storage == NULL || expected == NULL || tones == NULL || words == NULL ||
+            rs_sink_init_memory(&memory, RS_BYTE_ORDER_HOST) != 0) {
+            fprintf(stderr, "Fehler: Speicherzuweisung fehlgeschlagen.\n");
+            free(storage);
+            free(expected);
+            free(tones);
+            free(words);
+            return 1;
+        }
+
+        uint32_t seed = 0x51ED270B;
+        memset(words, 0, (symbols / 32 + 1) * sizeof(uint32_t));
+        for (size_t i = 0; i < symbols; i++) {
+            tones[i] = (uint8_t)(bench_random(&seed) & 1);
+            words[i / 32] |= (uint32_t)tones[i] << (i % 32);
+        }
+
+        rs_fsk_table table;
+        int ok = rs_fsk_table_init(&table, storage, c->mark, c->space, c->baud, c->sampleRate) == 0;
+
+        // 1. Abweichung zur Referenz über die ganze Folge (Phase und Symboltakt
+        // laufen exakt weiter, die mittlere Baudrate stimmt)
+        ok &= render_reference(c, tones, symbols, expected, NULL) == samples;
+        rs_fsk_modulator mod;
+        rs_fsk_init(&mod, &table, &memory);
+        for (size_t i = 0; i < symbols; i += 32) {
+            size_t n = (symbols - i < 32) ? symbols - i : 32;
+            rs_fsk_symbols(&mod, words[i / 32], (int)n);
+        }
+        rs_fsk_flush(&mod);
+        rs_sink_flush(&memory);
+
+        int maxDeviation = 0;
+        int lengthOk = memory.memoryFill == samples * sizeof(int16_t);
+        const int16_t* actual = (const int16_t*) memory.memory;
+        for (size_t i = 0; lengthOk && i < samples; i++) {
+            int d = abs(actual[i] - expected[i]);
+            if (d > maxDeviation) {
+                maxDeviation = d;
+            }
+        }
+        ok &= lengthOk && maxDeviation <= FSK_MAX_DEVIATION;
+        result |= !ok;
+
+        // 2. Durchsatz: NCO je Symbol gegen Tabellen-Modulator (beide in den Sink)
+        double start = bench_now();
+        for (int r = 0; r < FSK_ROUNDS; r++) {
+            rs_sink_reset_memory(&memory);
+            render_reference(c, tones, symbols, expected, &memory);
+        }
+        double nco = (double)symbols * FSK_ROUNDS / (bench_now() - start) / 1e6;
+
+        start = bench_now();
+        for (int r = 0; r < FSK_ROUNDS; r++) {
+            rs_sink_reset_memory(&memory);
+            rs_fsk_init(&mod, &table, &memory);
+            for (size_t i = 0; i < symbols; i += 32) {
+                size_t n = (symbols - i < 32) ? symbols - i : 32;
+                rs_fsk_symbols(&mod, words[i / 32], (int)n);
+            }
+            rs_fsk_flush(&mod);
+        }
+        double lookup = (double)symbols * FSK_ROUNDS / (bench_now() - start) / 1e6;
+        bench_sink += memory.memoryFill;
+
+        printf("%-10s %12.1f %12.1f %10d %8s\n", c->name, nco, lookup, maxDeviation, ok ? "ok" : "FEHLER");
+
+        rs_sink_close(&memory);
+        free(storage);
+        free(expected);
+        free(tones);
+        free(words);
+    }
+
+    int limits = verify_limits();
+    printf("%-10s %47s\n", "grenzen", limits ? "FEHLER" : "ok");
+    result |= limits;
+    return result;
+}
@@ -0,0 +1,213 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/rawsignal.h"
+
+#define GENERATOR_CASES 7
+#define GENERATOR_ROUNDS 20
+#define GENERATOR_MAX_BLOCK 16384
+
+static const uint32_t rates[] = { RS_NATIVE_RATE, 48000 };
+static const size_t blocks[] = { 1, 37, 256, 4096, GENERATOR_MAX_BLOCK };
+static const size_t timedBlocks[] = { 64, 1024, GENERATOR_MAX_BLOCK };
+
+static const char* const names[GENERATOR_CASES] = {
+    "POCSAG_1200", "DTMF", "DTMF_LANG", "MORSE_CW", "AFSK1200", "FSK9600", "UFSK1200"
+};
+
+#define LONG_TEXT "RAWSIGNAL GENERATOR PULL API 0123456789 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG"
+
+/**
+ * @brief Rendert Testfall index am Stück (Referenz).
+ */
+static int render_case(rs_context* ctx, int index) {
+    switch (index) {
+        case 0: return rs_render_pocsag(ctx, 1200, 1234567, 3, LONG_TEXT);
+        case 1: return rs_render_dtmf(ctx, "0123456789*#ABCD", 50, 50);
+        case 2: return rs_render_dtmf(ctx, "19#", 1500, 300); // Länger als der Wellenform-Cache
+        case 3: return rs_render_morse(ctx, "CQ CQ DE DL1ABC  TEST", 25);
+        case 4: return rs_render_afsk1200(ctx, "DL1ABC-1", "APRS", LONG_TEXT LONG_TEXT LONG_TEXT);
+        case 5: return rs_render_fsk9600(ctx, "DL1ABC-1", "APRS", LONG_TEXT LONG_TEXT LONG_TEXT);
+        default: return rs_render_ufsk1200(ctx, LONG_TEXT LONG_TEXT);
+    }
+}
+
+/**
+ * @brief Legt den Generator für Testfall index an.
+ */
+static rs_generator* create_case(uint32_t rate, int index) {
+    switch (index) {
+        case 0: return rs_generator_create_pocsag(rate, 1200, 1234567, 3, LONG_TEXT);
+        case 1: return rs_generator_create_dtmf(rate, "0123456789*#ABCD", 50, 50);
+        case 2: return rs_generator_create_dtmf(rate, "19#", 1500, 300);
+        case 3: return rs_generator_create_morse(rate, "CQ CQ DE DL1ABC  TEST", 25);
+        case 4: return rs_generator_create_afsk1200(rate, "DL1ABC-1", "APRS", LONG_TEXT LONG_TEXT LONG_TEXT);
+        case 5: return rs_generator_create_fsk9600(rate, "DL1ABC-1", "APRS", LONG_TEXT LONG_TEXT LONG_TEXT);
+        default: return rs_generator_create_ufsk1200(rate, LONG_TEXT LONG_TEXT);
+    }
+}
+
+/**
+ * @brief Holt die ganze Übertragung in Blöcken von block Samples und vergleicht
+ * sie mit der Referenz (block == 0: wechselnde Blockgrößen 1..997).
+ * @return int 0 bei identischer Ausgabe und RS_OK, sonst 1.
+ */
+static int verify_case(uint32_t rate, int index, size_t block, const int16_t* expected, size_t count,
+                       int16_t* buffer) {
+    rs_generator* gen = create_case(rate, index);
+    if (gen == NULL) {
+        return 1;
+    }
+
+    size_t done = 0;
+    size_t step = 1;
+    int mismatch = 0;
+    for (;;) {
+        size_t want = block;
+        if (block == 0) {
+            step = (step * 7 + 3) % 997;
+            want = step + 1;
+        }
+        size_t n = rs_generator_render(gen, buffer, want);
+        if (n > count - done || memcmp(buffer, expected + done, n * sizeof(int16_t)) != 0) {
+            mismatch = 1;
+            break;
+        }
+        done += n;
+        if (n < want) {
+            break;
+        }
+    }
+
+    // Nach dem Ende liefert der Generator nichts mehr
+    if (rs_generator_render(gen, buffer, 1) != 0 || rs_generator_status(gen) != RS_OK) {
+        mismatch = 1;
+    }
+    rs_generator_destroy(gen);
+    return mismatch || done != count;
+}
+
+/**
+ * @brief Abbruch mitten in der Übertragung und Fehlerfälle der Fabriken.
+ * @return int 0 wenn sich alle Generatoren wie dokumentiert verhalten, sonst 1.
+ */
+static int verify_edge_cases(int16_t* buffer) {
+    int failed = 0;
+
+    // Vorzeitiges destroy nach einem Teil der Ausgabe (Speicher prüft valgrind/ASan)
+    for (int c = 0; c < GENERATOR_CASES; c++) {
+        rs_generator* gen = create_case(48000, c);
+        failed |= gen == NULL || rs_generator_render(gen, buffer, 1000) != 1000;
+        rs_generator_destroy(gen);
+    }
+    rs_generator_destroy(NULL);
+
+    // Ungültige Parameter und leere Nachrichten liefern NULL
+    failed |= rs_generator_create_dtmf(500, "123", 50, 50) != NULL;
+    failed |= rs_generator_create_dtmf(RS_NATIVE_RATE, "123", 0, 50) != NULL;
+    failed |= rs_generator_create_pocsag(RS_NATIVE_RATE, 300, 1234567, 3, "X") != NULL;
+    failed |= rs_generator_create_fsk9600(RS_NATIVE_RATE, "DL1ABC-1", "APRS", "") != NULL;
+    failed |= rs_generator_create_ufsk1200(RS_NATIVE_RATE, "") != NULL;
+    return failed;
+}
+
+/**
+ * @brief Durchsatz des Generators (Msamples/s) bei fester Blockgröße.
+ */
+static double measure_case(uint32_t rate, int index, size_t block, int16_t* buffer) {
+    uint64_t samples = 0;
+    double start = bench_now();
+    for (int r = 0; r < GENERATOR_ROUNDS; r++) {
+        rs_generator* gen = create_case(rate, index);
+        size_t n;
+        while ((n = rs_generator_render(gen, buffer, block)) > 0) {
+            samples += n;
+            bench_sink += (uint64_t)buffer[n - 1];
+        }
+        rs_generator_destroy(gen);
+    }
+    return (double)samples / (bench_now() - start) / 1e6;
+}
+
+/**
+ * @brief Durchsatz von rs_render_* in den Speicher des Kontexts (Msamples/s).
+ */
+static double measure_render(rs_context* ctx, int index) {
+    uint64_t samples = 0;
+    double start = bench_now();
+    for (int r = 0; r < GENERATOR_ROUNDS; r++) {
+        size_t count;
+        render_case(ctx, index);
+        bench_sink += (uint64_t)rs_context_samples(ctx, &count)[0];
+        samples += count;
+    }
+    return (double)samples / (bench_now() - start) / 1e6;
+}
+
+/**
+ * @brief Prüft die Generatoren aller Encoder gegen rs_render_* (bit-identisch
+ * bei jeder Blockgröße, nativ und mit Resampler) und misst den Durchsatz je
+ * Blockgröße im Vergleich zum Rendern am Stück.
+ */
+int bench_generator(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    int16_t* buffer = (int16_t*) malloc(GENERATOR_MAX_BLOCK * sizeof(int16_t));
+    if (buffer == NULL) {
+        fprintf(stderr, "Fehler: Speicherzuweisung fehlgeschlagen.\n");
+        return 1;
+    }
+
+    printf("%-12s %6s %8s %10s %10s %10s %10s %8s   (Msamples/s)\n", "generator", "rate", "samples",
+           "render", "block 64", "block 1k", "block 16k", "ident");
+
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        rs_context* ctx = rs_context_create(rates[r]);
+        if (ctx == NULL) {
+            free(buffer);
+            return 1;
+        }
+
+        for (int c = 0; c < GENERATOR_CASES; c++) {
+            size_t count;
+            if (render_case(ctx, c) != RS_OK) {
+                fprintf(stderr, "Fehler: Referenz für %s fehlgeschlagen.\n", names[c]);
+                result = 1;
+                continue;
+            }
+            const int16_t* samples = rs_context_samples(ctx, &count);
+            int16_t* expected = (int16_t*) malloc(count * sizeof(int16_t));
+            if (expected == NULL) {
+                result = 1;
+                continue;
+            }
+            memcpy(expected, samples, count * sizeof(int16_t));
+
+            int mismatch = verify_case(rates[r], c, 0, expected, count, buffer);
+            for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+                mismatch |= verify_case(rates[r], c, blocks[b], expected, count, buffer);
+            }
+            result |= mismatch;
+
+            printf("%-12s %6u %8zu %10.1f", names[c], rates[r], count, measure_render(ctx, c));
+            for (size_t b = 0; b < sizeof(timedBlocks) / sizeof(timedBlocks[0]); b++) {
+                printf(" %10.1f", measure_case(rates[r], c, timedBlocks[b], buffer));
+            }
+            printf(" %8s\n", mismatch ? "FEHLER" : "ok");
+            free(expected);
+        }
+        rs_context_destroy(ctx);
+    }
+
+    int edge = verify_edge_cases(buffer);
+    printf("%-12s %8s\n", "abbruch", edge ? "FEHLER" : "ok");
+    result |= edge;
+
+    free(buffer);
+    return result;
+}
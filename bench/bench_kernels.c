@@ -0,0 +1,161 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/kernels.h"
+
+#define KERNEL_BLOCK 4096
+#define KERNEL_ROUNDS 4000
+#define FIR_MAX_TAPS 32
+
+static const char* const variants[] = { "scalar", "sse2", "avx2", "neon" };
+
+/**
+ * @brief Zufällige FIR-Koeffizienten in -32767..32767, je Zeile auf Σ|c| < 65536
+ * begrenzt (Vertrag von fir_q15), und Startindizes innerhalb von in.
+ */
+static void random_fir(int16_t* coef, uint32_t* start, size_t taps, size_t count, size_t inLength, uint32_t* seed) {
+    for (size_t i = 0; i < count; i++) {
+        int32_t row[FIR_MAX_TAPS];
+        int32_t sum = 0;
+        for (size_t j = 0; j < taps; j++) {
+            row[j] = (int32_t)(bench_random(seed) % 65536) - 32768;
+            sum += abs(row[j]);
+        }
+        for (size_t j = 0; j < taps; j++) {
+            // Jede zweite Zeile bis an die Grenze, damit die Sättigung greift
+            int64_t c = (int64_t)row[j] * ((i & 1) ? 65535 : 16384) / (sum + 1);
+            coef[i * taps + j] = (int16_t)((c > 32767) ? 32767 : (c < -32767) ? -32767 : c);
+        }
+        start[i] = bench_random(seed) % (uint32_t)(inLength - taps + 1);
+    }
+}
+
+/**
+ * @brief Vergleicht alle Kernels einer Variante mit der skalaren Referenz
+ * (verschiedene Längen, damit auch die Reste hinter den Vektorschleifen geprüft werden).
+ * @return int 0 bei bit-identischen Ergebnissen, sonst 1.
+ */
+static int verify_variant(const rs_kernel_table* k) {
+    const rs_kernel_table* ref = &rs_kernels_scalar;
+    int16_t a[KERNEL_BLOCK], b[KERNEL_BLOCK], expected[KERNEL_BLOCK], actual[KERNEL_BLOCK];
+    static int16_t coef[KERNEL_BLOCK * FIR_MAX_TAPS];
+    static uint32_t start[KERNEL_BLOCK];
+    float f[KERNEL_BLOCK];
+    uint32_t seed = 0x12345678;
+
+    for (size_t i = 0; i < KERNEL_BLOCK; i++) {
+        a[i] = (int16_t)bench_random(&seed);
+        b[i] = (int16_t)bench_random(&seed);
+        // Werte über den ganzen Bereich inkl. Sättigung und exakter .5-Fälle
+        f[i] = (float)((int32_t)(bench_random(&seed) % 140000) - 70000) / ((i % 3) ? 2.0f : 1.7f);
+    }
+
+    for (size_t len = 0; len < 100; len++) {
+        size_t n = (len < 50) ? len : KERNEL_BLOCK - len;
+
+        for (int interp = 0; interp <= 1; interp++) {
+            uint32_t inc = bench_random(&seed);
+            uint32_t p0 = bench_random(&seed);
+            uint32_t p1 = p0;
+            ref->sine(&p0, inc, interp, expected, n);
+            k->sine(&p1, inc, interp, actual, n);
+            if (p0 != p1 || memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+        }
+
+        ref->mix_avg(expected, a, b, n);
+        k->mix_avg(actual, a, b, n);
+        if (memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+
+        ref->add_sat(expected, a, b, n);
+        k->add_sat(actual, a, b, n);
+        if (memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+
+        ref->fill(expected, a[len], n);
+        k->fill(actual, a[len], n);
+        if (memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+
+        ref->float_to_s16(expected, f, n);
+        k->float_to_s16(actual, f, n);
+        if (memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+
+        for (size_t taps = 8; taps <= FIR_MAX_TAPS; taps += 8) {
+            random_fir(coef, start, taps, n, KERNEL_BLOCK, &seed);
+            int shift = 13 + (int)((len + taps / 8) % 3); // Q13..Q15
+            ref->fir_q15(expected, a, start, coef, taps, shift, n);
+            k->fir_q15(actual, a, start, coef, taps, shift, n);
+            if (memcmp(expected, actual, n * sizeof(int16_t)) != 0) return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Misst den Durchsatz eines Kernels in Msamples/s.
+ */
+static double measure(const rs_kernel_table* k, int which) {
+    static int16_t a[KERNEL_BLOCK], b[KERNEL_BLOCK], out[KERNEL_BLOCK];
+    static float f[KERNEL_BLOCK];
+    static int16_t coef[KERNEL_BLOCK * 8];
+    static uint32_t firStart[KERNEL_BLOCK];
+    uint32_t phase = 0;
+
+    for (size_t i = 0; i < KERNEL_BLOCK; i++) {
+        a[i] = (int16_t)(i * 7);
+        b[i] = (int16_t)(i * 13);
+        f[i] = (float)i * 3.7f - 5000.0f;
+        // Pulsformung wie FSK9600: 8 Taps, Start rückt alle ~2,3 Ausgänge ein Symbol vor
+        firStart[i] = (uint32_t)(i * 64 / 147);
+        for (size_t j = 0; j < 8; j++) {
+            coef[i * 8 + j] = (int16_t)(((i + j) % 7) * 600 - 1800);
+        }
+    }
+
+    double start = bench_now();
+    for (int r = 0; r < KERNEL_ROUNDS; r++) {
+        switch (which) {
+            case 0: k->sine(&phase, 0x0DEADBEE, 1, out, KERNEL_BLOCK); break;
+            case 1: k->mix_avg(out, a, b, KERNEL_BLOCK); break;
+            case 2: k->add_sat(out, a, b, KERNEL_BLOCK); break;
+            case 3: k->fill(out, (int16_t)r, KERNEL_BLOCK); break;
+            case 4: k->float_to_s16(out, f, KERNEL_BLOCK); break;
+            default: k->fir_q15(out, a, firStart, coef, 8, 15, KERNEL_BLOCK); break;
+        }
+        bench_sink += (uint64_t)out[r % KERNEL_BLOCK];
+    }
+    double elapsed = bench_now() - start;
+
+    return (double)KERNEL_BLOCK * KERNEL_ROUNDS / elapsed / 1e6;
+}
+
+/**
+ * @brief Prüft alle von der CPU unterstützten Kernel-Varianten auf Bit-Identität
+ * und misst ihren Durchsatz.
+ */
+int bench_kernels(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    rs_kernels_init();
+    printf("%-10s %8s %10s %10s %10s %10s %10s %10s   (Msamples/s, aktiv: %s)\n", "kernels", "ident",
+           "sine", "mix_avg", "add_sat", "fill", "f32->s16", "fir8", rs_kernels()->name);
+
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+        const rs_kernel_table* k = rs_kernels_find(variants[v]);
+        if (k == NULL) {
+            continue;
+        }
+
+        int mismatch = verify_variant(k);
+        result |= mismatch;
+
+        printf("%-10s %8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", k->name, mismatch ? "FEHLER" : "ok",
+               measure(k, 0), measure(k, 1), measure(k, 2), measure(k, 3), measure(k, 4), measure(k, 5));
+    }
+
+    return result;
+}
@@ -0,0 +1,158 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "../include/rawsignal.h"
+
+#define LIBRARY_THREADS 8
+#define LIBRARY_ROUNDS 20
+#define LIBRARY_CASES 6
+#define LIBRARY_RATE 48000
+
+/**
+ * @brief Rendert Testfall index mit dem Kontext ctx.
+ */
+static int render_case(rs_context* ctx, int index) {
+    switch (index) {
+        case 0: return rs_render_pocsag(ctx, 1200, 1234567, 3, "BIBLIOTHEK PARALLEL 0123456789");
+        case 1: return rs_render_pocsag(ctx, 512, 42, 3, "KURZ");
+        case 2: return rs_render_dtmf(ctx, "0123456789*#ABCD", 50, 50);
+        case 3: return rs_render_morse(ctx, "CQ CQ DE DL1ABC", 25);
+        case 4: return rs_render_afsk1200(ctx, "DL1ABC-1", "APRS", "!5000.00N/00800.00E-Test");
+        default: return rs_render_fsk9600(ctx, "DL1ABC-1", "APRS", "rawsignal library");
+    }
+}
+
+typedef struct {
+    int16_t* samples[LIBRARY_CASES];   // Referenz je Testfall (single-threaded)
+    size_t count[LIBRARY_CASES];
+} library_reference;
+
+typedef struct {
+    const library_reference* reference;
+    pthread_t thread;
+    int mismatches;
+    uint64_t samples;
+} library_worker;
+
+typedef struct {
+    const int16_t* expected;   // Nächstes erwartetes Sample
+    size_t remaining;
+    int mismatch;
+} compare_state;
+
+/**
+ * @brief Callback-Ausgabe: vergleicht fortlaufend mit der Referenz.
+ */
+static int compare_output(void* user, const int16_t* samples, size_t count) {
+    compare_state* st = (compare_state*) user;
+    if (count > st->remaining || memcmp(samples, st->expected, count * sizeof(int16_t)) != 0) {
+        st->mismatch = 1;
+        return 1;
+    }
+    st->expected += count;
+    st->remaining -= count;
+    return 0;
+}
+
+/**
+ * @brief Ein Thread mit eigenem Kontext: alle Testfälle im Wechsel aus Speicher-
+ * und Callback-Ausgabe, jedes Ergebnis muss bit-identisch zur Referenz sein.
+ */
+static void* library_thread(void* arg) {
+    library_worker* w = (library_worker*) arg;
+    rs_context* ctx = rs_context_create(LIBRARY_RATE);
+    if (ctx == NULL) {
+        w->mismatches = 1;
+        return NULL;
+    }
+
+    for (int round = 0; round < LIBRARY_ROUNDS; round++) {
+        for (int c = 0; c < LIBRARY_CASES; c++) {
+            const int16_t* expected = w->reference->samples[c];
+            size_t expectedCount = w->reference->count[c];
+
+            if ((round + c) % 2 == 0) {
+                rs_context_set_output(ctx, NULL, NULL);
+                size_t count;
+                int result = render_case(ctx, c);
+                const int16_t* samples = rs_context_samples(ctx, &count);
+                if (result != RS_OK || count != expectedCount ||
+                    memcmp(samples, expected, count * sizeof(int16_t)) != 0) {
+                    w->mismatches++;
+                }
+            } else {
+                compare_state st = { expected, expectedCount, 0 };
+                rs_context_set_output(ctx, compare_output, &st);
+                if (render_case(ctx, c) != RS_OK || st.mismatch || st.remaining != 0) {
+                    w->mismatches++;
+                }
+            }
+            w->samples += expectedCount;
+        }
+    }
+
+    rs_context_destroy(ctx);
+    return NULL;
+}
+
+/**
+ * @brief Prüft die Bibliothek auf Thread-Sicherheit: LIBRARY_THREADS Kontexte
+ * rendern gleichzeitig dieselben Übertragungen und vergleichen mit einer
+ * single-threaded erzeugten Referenz. Meldet zusätzlich den Gesamtdurchsatz.
+ */
+int bench_library(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    library_reference reference;
+    rs_context* ctx = rs_context_create(LIBRARY_RATE);
+    if (ctx == NULL) {
+        fprintf(stderr, "Fehler: Kontext konnte nicht angelegt werden.\n");
+        return 1;
+    }
+    for (int c = 0; c < LIBRARY_CASES; c++) {
+        size_t count;
+        if (render_case(ctx, c) != RS_OK) {
+            fprintf(stderr, "Fehler: Referenz für Testfall %d fehlgeschlagen.\n", c);
+            rs_context_destroy(ctx);
+            return 1;
+        }
+        const int16_t* samples = rs_context_samples(ctx, &count);
+        reference.samples[c] = (int16_t*) malloc(count * sizeof(int16_t));
+        memcpy(reference.samples[c], samples, count * sizeof(int16_t));
+        reference.count[c] = count;
+    }
+    rs_context_destroy(ctx);
+
+    library_worker workers[LIBRARY_THREADS];
+    memset(workers, 0, sizeof(workers));
+
+    double start = bench_now();
+    for (int t = 0; t < LIBRARY_THREADS; t++) {
+        workers[t].reference = &reference;
+        pthread_create(&workers[t].thread, NULL, library_thread, &workers[t]);
+    }
+
+    int mismatches = 0;
+    uint64_t samples = 0;
+    for (int t = 0; t < LIBRARY_THREADS; t++) {
+        pthread_join(workers[t].thread, NULL);
+        mismatches += workers[t].mismatches;
+        samples += workers[t].samples;
+    }
+    double elapsed = bench_now() - start;
+
+    printf("%-16s %8s %8s %14s %10s\n", "library", "threads", "renders", "out Msamples/s", "result");
+    printf("%-16s %8d %8d %14.2f %10s\n", "concurrent", LIBRARY_THREADS,
+           LIBRARY_THREADS * LIBRARY_ROUNDS * LIBRARY_CASES, (double)samples / elapsed / 1e6,
+           mismatches == 0 ? "identisch" : "ABWEICHUNG");
+
+    for (int c = 0; c < LIBRARY_CASES; c++) {
+        free(reference.samples[c]);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
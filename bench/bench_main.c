@@ -0,0 +1,68 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+volatile uint64_t bench_sink = 0;
+int bench_json = 0;
+
+typedef struct {
+    const char* name;
+    int (*run)(int argc, char* argv[]);
+    int json;   // 1 = unterstützt --json
+} bench_entry;
+
+static const bench_entry benches[] = {
+    { "encoders", bench_encoders, 1 },
+    { "resampler", bench_resampler, 0 },
+    { "kernels", bench_kernels, 0 },
+    { "library", bench_library, 0 },
+    { "pocsag", bench_pocsag, 0 },
+    { "crc", bench_crc, 0 },
+    { "fsk", bench_fsk, 0 },
+    { "generator", bench_generator, 0 },
+    { "realtime", bench_realtime, 0 },
+};
+
+#define NUM_BENCHES (sizeof(benches) / sizeof(benches[0]))
+
+/**
+ * @brief Führt alle oder die auf der Kommandozeile genannten Benchmarks aus.
+ * * Nutzung: rawsignal_bench [--json] [NAME ...]
+ * Mit --json laufen ohne Namen nur Benchmarks mit JSON-Ausgabe (encoders).
+ */
+int main(int argc, char* argv[]) {
+    int result = 0;
+
+    if (argc >= 2 && strcmp(argv[1], "--json") == 0) {
+        bench_json = 1;
+        argv[1] = argv[0];
+        argv++;
+        argc--;
+    }
+
+    if (argc < 2) {
+        for (size_t i = 0; i < NUM_BENCHES; i++) {
+            if (!bench_json || benches[i].json) {
+                result |= benches[i].run(argc, argv);
+            }
+        }
+        return result;
+    }
+
+    for (int a = 1; a < argc; a++) {
+        size_t i;
+        for (i = 0; i < NUM_BENCHES; i++) {
+            if (strcmp(argv[a], benches[i].name) == 0) {
+                result |= benches[i].run(argc, argv);
+                break;
+            }
+        }
+        if (i == NUM_BENCHES) {
+            fprintf(stderr, "Fehler: Unbekannter Benchmark '%s'.\n", argv[a]);
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,244 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/encoders/pocsag.h"
+
+// Referenz: die ursprüngliche bitserielle Kodierung (Polynomdivision, Paritäts-
+// schleife, Zeichen Bit für Bit). Dient als Maßstab für Gleichheit und Tempo.
+#define REF_SYNC 0x7CD215D8
+#define REF_IDLE 0x7A89C197
+#define REF_FLAG_MESSAGE 0x100000
+#define REF_CRC_BITS 10
+#define REF_CRC_GENERATOR 0b11101101001
+
+#define CODEWORD_COUNT (1u << 21)
+#define CODEWORD_ROUNDS 8
+#define TEXT_LENGTH 4000
+#define TEXT_ROUNDS 200
+#define TEXT_CASES 3000
+
+static uint32_t ref_crc(uint32_t inputMsg) {
+    uint32_t denominator = REF_CRC_GENERATOR << 20;
+    uint32_t msg = inputMsg << REF_CRC_BITS;
+
+    for (int column = 0; column <= 20; column++) {
+        int msgBit = (msg >> (30 - column)) & 1;
+        if (msgBit != 0) {
+            msg ^= denominator;
+        }
+        denominator >>= 1;
+    }
+    return msg & 0x3FF;
+}
+
+static uint32_t ref_parity(uint32_t x) {
+    uint32_t p = 0;
+    for (int i = 0; i < 32; i++) {
+        p ^= (x & 1);
+        x >>= 1;
+    }
+    return p;
+}
+
+static uint32_t ref_codeword(uint32_t msg) {
+    uint32_t fullCRC = (msg << REF_CRC_BITS) | ref_crc(msg);
+    return (fullCRC << 1) | ref_parity(fullCRC);
+}
+
+static int ref_numeric_code(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    switch (c) {
+        case 'U': case 'u': return 0xB;
+        case ' ': return 0xC;
+        case '-': return 0xD;
+        case ']': case ')': return 0xE;
+        case '[': case '(': return 0xF;
+        default: return -1;
+    }
+}
+
+/**
+ * @brief Bitserielle Textkodierung (Stand vor der Tabellenversion).
+ */
+static uint32_t* ref_encode_text(uint32_t position, const char* str, uint32_t* out, int numeric) {
+    uint32_t word = 0;
+    uint32_t bits = 0;
+    int charBits = numeric ? NUMERIC_BITS_PER_CHAR : TEXT_BITS_PER_CHAR;
+    int padding = 0;
+
+    for (;;) {
+        unsigned char c;
+        if (*str != 0) {
+            c = numeric ? (unsigned char) ref_numeric_code(*str) : (unsigned char) *str;
+            str++;
+        } else if (numeric && bits > 0) {
+            c = 0xC;
+            padding = 1;
+        } else {
+            break;
+        }
+
+        for (int i = 0; i < charBits; i++) {
+            word = (word << 1) | ((c >> i) & 1);
+            if (++bits == TEXT_BITS_PER_WORD) {
+                *out++ = ref_codeword(word | REF_FLAG_MESSAGE);
+                word = 0;
+                bits = 0;
+                if (++position == BATCH_SIZE) {
+                    *out++ = REF_SYNC;
+                    position = 0;
+                }
+            }
+        }
+        if (padding && bits == 0) {
+            break;
+        }
+    }
+
+    if (bits > 0) {
+        word <<= TEXT_BITS_PER_WORD - bits;
+        *out++ = ref_codeword(word | REF_FLAG_MESSAGE);
+        if (++position == BATCH_SIZE) {
+            *out++ = REF_SYNC;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Referenz für eine Übertragung mit einer Seite (wie pocsag_encodeTransmission).
+ */
+static void ref_transmission(uint32_t address, const char* message, uint32_t* out, FunctionCode functionCode) {
+    for (int i = 0; i < PREAMBLE_LENGTH / 32; i++) {
+        *out++ = 0xAAAAAAAA;
+    }
+    uint32_t* batchStart = out;
+    *out++ = REF_SYNC;
+
+    uint32_t offset = (address & 0x7) * FRAME_SIZE;
+    for (uint32_t i = 0; i < offset; i++) {
+        *out++ = REF_IDLE;
+    }
+    *out++ = ref_codeword(((address >> 3) << 2) | functionCode);
+
+    int numeric = functionCode == FUNC_NUMERIC_1 || functionCode == FUNC_NUMERIC_2;
+    out = ref_encode_text((offset + 1) % BATCH_SIZE, message, out, numeric);
+    *out++ = REF_IDLE;
+
+    while ((out - batchStart) % (BATCH_SIZE + 1) != 0) {
+        *out++ = REF_IDLE;
+    }
+}
+
+/**
+ * @brief Zufällige Nachricht: ASCII (alle 7-Bit-Zeichen außer 0) oder numerischer Zeichensatz.
+ */
+static void random_message(char* out, size_t length, int numeric, uint32_t* seed) {
+    static const char numericSet[] = "0123456789U -[]()";
+    for (size_t i = 0; i < length; i++) {
+        out[i] = numeric ? numericSet[bench_random(seed) % (sizeof(numericSet) - 1)]
+                         : (char)(1 + bench_random(seed) % 127);
+    }
+    out[length] = '\0';
+}
+
+/**
+ * @brief Prüft alle 2^21 Datenwörter und zufällige Übertragungen gegen die Referenz
+ * und misst Codewörter/s sowie Zeichen/s.
+ */
+int bench_pocsag(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // 1. Vollständiger Vergleich aller Datenwörter
+    uint32_t mismatches = 0;
+    for (uint32_t data = 0; data < CODEWORD_COUNT; data++) {
+        if (pocsag_encodeCodeword(data) != ref_codeword(data)) {
+            mismatches++;
+        }
+    }
+
+    // 2. Zufällige Übertragungen (Adresse, Funktionscode, Länge 0-200)
+    uint32_t* expected = (uint32_t*) malloc(sizeof(uint32_t) * 8192);
+    uint32_t* actual = (uint32_t*) malloc(sizeof(uint32_t) * 8192);
+    char* message = (char*) malloc(TEXT_LENGTH + 1);
+    if (expected == NULL || actual == NULL || message == NULL) {
+        fprintf(stderr, "Fehler: Speicherzuweisung fehlgeschlagen.\n");
+        free(expected);
+        free(actual);
+        free(message);
+        return 1;
+    }
+
+    uint32_t seed = 0x2545F491;
+    uint32_t textMismatches = 0;
+    for (int i = 0; i < TEXT_CASES; i++) {
+        uint32_t address = bench_random(&seed) % 2097152;
+        FunctionCode functionCode = (FunctionCode)(bench_random(&seed) % 4);
+        int numeric = functionCode == FUNC_NUMERIC_1 || functionCode == FUNC_NUMERIC_2;
+        size_t length = bench_random(&seed) % 201;
+        random_message(message, length, numeric, &seed);
+
+        size_t words = pocsag_messageLength(address, length, functionCode);
+        ref_transmission(address, message, expected, functionCode);
+        pocsag_encodeTransmission(address, message, actual, functionCode);
+        if (memcmp(expected, actual, words * sizeof(uint32_t)) != 0) {
+            textMismatches++;
+        }
+    }
+
+    // 3. Durchsatz der Codewort-Bildung
+    double start = bench_now();
+    for (int r = 0; r < CODEWORD_ROUNDS; r++) {
+        for (uint32_t data = 0; data < CODEWORD_COUNT; data++) {
+            bench_sink += ref_codeword(data ^ (uint32_t)r);
+        }
+    }
+    double refCodewords = (double)CODEWORD_COUNT * CODEWORD_ROUNDS / (bench_now() - start) / 1e6;
+
+    start = bench_now();
+    for (int r = 0; r < CODEWORD_ROUNDS; r++) {
+        for (uint32_t data = 0; data < CODEWORD_COUNT; data++) {
+            bench_sink += pocsag_encodeCodeword(data ^ (uint32_t)r);
+        }
+    }
+    double codewords = (double)CODEWORD_COUNT * CODEWORD_ROUNDS / (bench_now() - start) / 1e6;
+
+    // 4. Durchsatz einer langen Textübertragung (Zeichen/s, inkl. Codewörter)
+    double refChars[2];
+    double chars[2];
+    for (int numeric = 0; numeric <= 1; numeric++) {
+        FunctionCode functionCode = numeric ? FUNC_NUMERIC_1 : FUNC_ALPHA_TEXT;
+        random_message(message, TEXT_LENGTH, numeric, &seed);
+
+        start = bench_now();
+        for (int r = 0; r < TEXT_ROUNDS; r++) {
+            ref_transmission(1234567, message, expected, functionCode);
+            bench_sink += expected[r];
+        }
+        refChars[numeric] = (double)TEXT_LENGTH * TEXT_ROUNDS / (bench_now() - start) / 1e6;
+
+        start = bench_now();
+        for (int r = 0; r < TEXT_ROUNDS; r++) {
+            pocsag_encodeTransmission(1234567, message, actual, functionCode);
+            bench_sink += actual[r];
+        }
+        chars[numeric] = (double)TEXT_LENGTH * TEXT_ROUNDS / (bench_now() - start) / 1e6;
+    }
+
+    free(expected);
+    free(actual);
+    free(message);
+
+    printf("%-12s %12s %12s %12s\n", "pocsag", "bitseriell", "tabelle", "ident");
+    printf("%-12s %12.1f %12.1f %12s   (Mcodewörter/s, alle 2^21 Datenwörter)\n", "codewort",
+           refCodewords, codewords, mismatches == 0 ? "ok" : "FEHLER");
+    printf("%-12s %12.1f %12.1f %12s   (Mzeichen/s, %d Zufallsübertragungen geprüft)\n", "text-ascii",
+           refChars[0], chars[0], textMismatches == 0 ? "ok" : "FEHLER", TEXT_CASES);
+    printf("%-12s %12.1f %12.1f\n", "text-bcd", refChars[1], chars[1]);
+
+    return (mismatches == 0 && textMismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/realtime.h"
+
+#define REALTIME_RATE 48000
+#define REALTIME_SAMPLES (REALTIME_RATE / 2) // 0.5 s je Fall
+#define REALTIME_CHUNK 480                   // 10 ms je Schreibaufruf
+
+typedef struct {
+    long pauseNs;   // Pause nach jedem Chunk (0 = so schnell wie möglich)
+} realtime_case;
+
+/**
+ * @brief Testmuster ohne Nullen, damit eingefügte Stille erkennbar bleibt.
+ */
+static int16_t pattern(size_t i) {
+    return (int16_t)((i * 7919u) % 30000u + 1);
+}
+
+/**
+ * @brief Erzeuger: schreibt das Muster in Chunks, optional gebremst.
+ */
+static int produce(void* user, rs_sink* sink) {
+    const realtime_case* c = (const realtime_case*) user;
+    int16_t chunk[REALTIME_CHUNK];
+
+    for (size_t done = 0; done < REALTIME_SAMPLES; done += REALTIME_CHUNK) {
+        for (size_t i = 0; i < REALTIME_CHUNK; i++) {
+            chunk[i] = pattern(done + i);
+        }
+        if (rs_sink_write(sink, chunk, REALTIME_CHUNK) != 0) {
+            return 1;
+        }
+        if (c->pauseNs > 0) {
+            rs_sink_flush(sink);
+            struct timespec ts = { 0, c->pauseNs };
+            nanosleep(&ts, NULL);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Läuft einen Fall in einen Speicher-Sink und prüft die Ausgabe.
+ * * Ohne Stille muss sie das Muster sein; die Gesamtlänge ist Muster plus
+ * gezählte Stille.
+ * @return int 0 wenn Ausgabe und Statistik stimmen, sonst 1.
+ */
+static int run_case(const char* name, long pauseNs, int expectUnderruns) {
+    realtime_case c = { pauseNs };
+    rs_sink memory;
+    if (rs_sink_init_memory(&memory, RS_BYTE_ORDER_HOST) != 0) {
+        fprintf(stderr, "Fehler: Speicherzuweisung fehlgeschlagen.\n");
+        return 1;
+    }
+
+    rs_realtime_options options;
+    rs_realtime_stats stats;
+    rs_realtime_defaults(&options, REALTIME_RATE, RS_BYTE_ORDER_HOST);
+    double start = bench_now();
+    int failed = rs_realtime_run(&memory, &options, produce, &c, &stats) != 0;
+    double elapsed = bench_now() - start;
+    rs_sink_flush(&memory);
+
+    const int16_t* out = (const int16_t*) memory.memory;
+    size_t count = memory.memoryFill / sizeof(int16_t);
+    size_t next = 0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < count && !failed; i++) {
+        if (out[i] == 0) {
+            zeros++;
+        } else if (next >= REALTIME_SAMPLES || out[i] != pattern(next++)) {
+            failed = 1;
+        }
+    }
+    failed |= next != REALTIME_SAMPLES || zeros != stats.silence || count != stats.samples;
+    failed |= expectUnderruns ? stats.underruns == 0 : stats.underruns != 0;
+
+    // Getaktet: mindestens die Dauer der Ausgabe (abzüglich Vorlauf)
+    failed |= elapsed < (double)count / REALTIME_RATE - options.prefillMs / 1000.0;
+
+    printf("%-10s %8.3f %8llu %10llu %10.3f %10.3f %8s\n", name, elapsed,
+           (unsigned long long)stats.underruns, (unsigned long long)stats.silence,
+           stats.maxJitterNs / 1e6, stats.latencyNs / 1e6, failed ? "FEHLER" : "ok");
+
+    rs_sink_close(&memory);
+    return failed;
+}
+
+/**
+ * @brief Prüft die getaktete Ausgabe: mit schnellem Erzeuger byte-identisch und
+ * ohne Unterlauf, mit halb so schnellem Erzeuger Unterläufe mit Stille.
+ */
+int bench_realtime(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    printf("%-10s %8s %8s %10s %10s %10s %8s   (s / Samples / ms)\n", "realtime", "dauer", "unterl.",
+           "stille", "jitter", "latenz", "ident");
+    result |= run_case("schnell", 0, 0);
+    result |= run_case("langsam", 20000000, 1); // 10 ms Samples je 20 ms
+    return result;
+}
@@ -0,0 +1,156 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/oscillator.h"
+#include "../include/resampler.h"
+
+#define BENCH_INPUT_SECONDS 20
+#define BENCH_BLOCK 4096
+
+typedef struct {
+    uint32_t inRate;
+    uint32_t outRate;
+} ratio_case;
+
+static const ratio_case cases[] = {
+    { 22050, 48000 },
+    { 38400, 22050 },
+    { 22050, 8000 },
+    { 22050, 44100 },
+    { 48000, 22050 },
+};
+
+static const char* const arithNames[] = { "float", "q15" };
+
+/**
+ * @brief Durchsatz eines Rechenwegs in Eingangs-Msamples/s (1 kHz Sinus).
+ * @return double Msamples/s oder -1 wenn der Resampler nicht angelegt werden konnte.
+ */
+static double measure(const ratio_case* c, rs_resampler_arith arith) {
+    rs_resampler* rs = rs_resampler_create_arith(c->inRate, c->outRate, arith);
+    int16_t* out = (rs != NULL) ? (int16_t*) malloc(sizeof(int16_t) * rs_resampler_max_output(rs, BENCH_BLOCK)) : NULL;
+    if (out == NULL) {
+        rs_resampler_free(rs);
+        return -1.0;
+    }
+
+    int16_t in[BENCH_BLOCK];
+    rs_oscillator osc;
+    rs_osc_init(&osc, 1000.0, c->inRate, 1);
+    rs_osc_render(&osc, in, BENCH_BLOCK);
+
+    size_t totalIn = (size_t)c->inRate * BENCH_INPUT_SECONDS;
+    size_t produced = 0;
+
+    double start = bench_now();
+    for (size_t done = 0; done < totalIn; done += BENCH_BLOCK) {
+        produced += rs_resampler_process(rs, in, BENCH_BLOCK, out);
+    }
+    produced += rs_resampler_flush(rs, out);
+    double elapsed = bench_now() - start;
+
+    bench_sink += produced + (uint64_t)out[0];
+    free(out);
+    rs_resampler_free(rs);
+    return (double)totalIn / elapsed / 1e6;
+}
+
+/**
+ * @brief Resampelt dasselbe Signal mit float und Q15 und liefert die größte Abweichung.
+ * * Eingang ist weißes Rauschen mit voller Amplitude, in ungleich großen
+ * Blöcken übergeben (schlechtester Fall für die Koeffizientenrundung).
+ * @return int größte Abweichung in LSB oder -1 bei Fehler (auch ungleiche Längen).
+ */
+static int deviation(const ratio_case* c) {
+    rs_resampler* rs[2];
+    int16_t* out[2];
+    size_t count[2] = { 0, 0 };
+    size_t totalIn = (size_t)c->inRate * 2;
+    int16_t* in = (int16_t*) malloc(sizeof(int16_t) * totalIn);
+
+    for (int a = 0; a < 2; a++) {
+        rs[a] = rs_resampler_create_arith(c->inRate, c->outRate, (rs_resampler_arith)a);
+        out[a] = (rs[a] != NULL) ? (int16_t*) malloc(sizeof(int16_t) * (rs_resampler_max_output(rs[a], totalIn) +
+                                                       rs_resampler_max_output(rs[a], RS_RESAMPLER_CHUNK))) : NULL;
+    }
+
+    int maxDeviation = -1;
+    if (in != NULL && out[0] != NULL && out[1] != NULL) {
+        uint32_t seed = 0x2545F491;
+        for (size_t i = 0; i < totalIn; i++) {
+            in[i] = (int16_t)(bench_random(&seed) % 65535 - 32767);
+        }
+
+        for (int a = 0; a < 2; a++) {
+            size_t done = 0;
+            while (done < totalIn) {
+                size_t n = 1 + bench_random(&seed) % 3000;
+                if (n > totalIn - done) n = totalIn - done;
+                count[a] += rs_resampler_process(rs[a], in + done, n, out[a] + count[a]);
+                done += n;
+            }
+            count[a] += rs_resampler_flush(rs[a], out[a] + count[a]);
+        }
+
+        if (count[0] == count[1]) {
+            maxDeviation = 0;
+            for (size_t i = 0; i < count[0]; i++) {
+                int d = abs(out[0][i] - out[1][i]);
+                if (d > maxDeviation) maxDeviation = d;
+            }
+        }
+    }
+
+    for (int a = 0; a < 2; a++) {
+        free(out[a]);
+        rs_resampler_free(rs[a]);
+    }
+    free(in);
+    return maxDeviation;
+}
+
+/**
+ * @brief Misst den Durchsatz des Polyphasen-Resamplers bei gängigen Raten, mit
+ * float und Q15, und prüft die Abweichung von Q15 gegen die dokumentierte
+ * Schranke (RS_RESAMPLER_Q15_BOUND).
+ */
+int bench_resampler(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int result = 0;
+
+    printf("%-16s %6s %6s %10s %10s %8s %9s %6s   (Eingang Msamples/s, Standard: %s)\n", "resampler", "L/M", "taps",
+           arithNames[0], arithNames[1], "max.abw", "schranke", "ok", arithNames[RS_RESAMPLER_DEFAULT_ARITH]);
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        rs_resampler* rs = rs_resampler_create(cases[c].inRate, cases[c].outRate);
+        if (rs == NULL) {
+            fprintf(stderr, "Fehler: Resampler %u -> %u konnte nicht angelegt werden.\n",
+                    cases[c].inRate, cases[c].outRate);
+            return 1;
+        }
+        char name[32];
+        char ratio[32];
+        snprintf(name, sizeof(name), "%u->%u", cases[c].inRate, cases[c].outRate);
+        snprintf(ratio, sizeof(ratio), "%u/%u", rs->upFactor, rs->downFactor);
+        rs_resampler* q15 = rs_resampler_create_arith(cases[c].inRate, cases[c].outRate, RS_RESAMPLER_Q15);
+        int bound = (q15 != NULL) ? (int)RS_RESAMPLER_Q15_BOUND(q15) : 0;
+        rs_resampler_free(q15);
+        printf("%-16s %6s %6u", name, ratio, rs->tapsPerPhase);
+        rs_resampler_free(rs);
+
+        double speed[2];
+        for (int a = 0; a < 2; a++) {
+            speed[a] = measure(&cases[c], (rs_resampler_arith)a);
+        }
+        int maxDeviation = deviation(&cases[c]);
+        int ok = speed[0] > 0 && speed[1] > 0 && maxDeviation >= 0 && maxDeviation <= bound;
+        result |= !ok;
+
+        printf(" %10.2f %10.2f %8d %9d %6s\n", speed[0], speed[1], maxDeviation, bound, ok ? "ok" : "FEHLER");
+    }
+
+    return result;
+}
@@ -0,0 +1,32 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+
+#include "job.h"
+#include "sink.h"
+
+// --- BATCH-MODUS ---
+// Jobs werden zeilenweise gelesen (eine Zeile = eine Kommandozeile) und im
+// selben Prozess gerendert, wahlweise parallel auf mehreren Worker-Threads.
+#define RS_BATCH_MAX_THREADS 256
+#define RS_BATCH_SLOTS_PER_THREAD 4 // Jobs in Arbeit bzw. wartend je Thread
+
+typedef struct {
+    unsigned int threads;  // Anzahl Worker (1 = sequentiell im Hauptthread)
+    int ordered;           // 1 = gemeinsame Ausgabe in Eingabereihenfolge
+} rs_batch_options;
+
+/**
+ * @brief Liest Jobs aus input und rendert sie.
+ * * defaults liefert Standardoptionen und den Basis-Startwert für die Zufalls-
+ * Stille; jeder Job erhält daraus einen eigenen Startwert (abhängig von der
+ * Zeilennummer), das Ergebnis ist daher unabhängig von der Thread-Anzahl.
+ * Jobs ohne -o schreiben in out: bei ordered in Eingabereihenfolge, sonst in
+ * Fertigstellungsreihenfolge (jeweils ein Job am Stück). Je Job erscheint eine
+ * Ergebniszeile auf stderr.
+ * @return 0, wenn alle Jobs erfolgreich waren, sonst 1.
+ */
+int rs_batch_run(FILE* input, const rs_job* defaults, rs_sink* out, const rs_batch_options* options);
+
+#endif // BATCH_H
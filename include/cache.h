@@ -0,0 +1,55 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- PCM-CACHE ---
+// Gerenderte Übertragungen (ohne End-Stille) liegen inhaltsadressiert in einem
+// Verzeichnis: Dateiname = FNV-1a-64 des Schlüssels (Modulator, Parameter,
+// Ausgaberate, Byte-Reihenfolge), der Schlüssel selbst steht zur Prüfung im
+// Eintrag. Treffer werden per mmap gelesen und kosten nur noch das Kopieren in
+// die Ausgabe. Einträge werden atomar geschrieben (temporäre Datei + rename),
+// mehrere Prozesse und Threads dürfen denselben Cache nutzen. Zum Leeren genügt
+// es, das Verzeichnis zu löschen.
+//
+// Dateiformat (Host-Byte-Reihenfolge):
+//   RS_CACHE_MAGIC (8 Bytes) | Schlüssellänge (u64) | Datenlänge (u64)
+//   | Schlüssel | Auffüllung bis RS_CACHE_ALIGNMENT | PCM-Daten
+#define RS_CACHE_MAGIC "RSPCM001"
+#define RS_CACHE_ALIGNMENT 64
+
+/**
+ * @brief Ein per mmap geöffneter Cache-Eintrag.
+ */
+typedef struct {
+    uint8_t* map;            // Gesamte Datei (NULL = kein Eintrag)
+    size_t mapBytes;
+    const uint8_t* data;     // PCM-Daten innerhalb von map
+    size_t dataBytes;
+} rs_cache_entry;
+
+/**
+ * @brief FNV-1a (64 Bit) über len Bytes.
+ */
+uint64_t rs_cache_hash(const void* data, size_t len);
+
+/**
+ * @brief Sucht den Eintrag zum Schlüssel key (keyLen Bytes, darf '\0' enthalten).
+ * * Beschädigte Einträge und Hash-Kollisionen gelten als Fehlschlag.
+ * @return 1 bei Treffer (entry gültig bis rs_cache_release), 0 sonst.
+ */
+int rs_cache_lookup(const char* dir, const char* key, size_t keyLen, rs_cache_entry* entry);
+
+/**
+ * @brief Gibt einen Eintrag aus rs_cache_lookup() frei.
+ */
+void rs_cache_release(rs_cache_entry* entry);
+
+/**
+ * @brief Legt len Bytes PCM unter dem Schlüssel key ab (Verzeichnis wird bei Bedarf angelegt).
+ * @return 0 bei Erfolg, sonst errno.
+ */
+int rs_cache_store(const char* dir, const char* key, size_t keyLen, const uint8_t* data, size_t len);
+
+#endif // CACHE_H
@@ -0,0 +1,18 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+
+// CPU-Merkmale (Bitmaske), einmalig per CPUID (x86) bzw. HWCAP (ARM) ermittelt
+#define RS_CPU_SSE2 (1u << 0)
+#define RS_CPU_AVX2 (1u << 1)
+#define RS_CPU_NEON (1u << 2)
+#define RS_CPU_PCLMUL (1u << 3) // PCLMULQDQ samt SSSE3 (pshufb)
+
+/**
+ * @brief Liefert die Merkmale der CPU, auf der das Programm läuft.
+ * @return uint32_t Bitmaske aus RS_CPU_*.
+ */
+uint32_t rs_cpu_features(void);
+
+#endif // CPU_H
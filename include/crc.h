@@ -5,8 +5,78 @@
 #include <stddef.h>
 
 #define CRC16_CCITT_POLY 0x1021
+#define CRC16_X25_POLY 0x8408   // CRC16_CCITT_POLY bitgespiegelt
 #define AX25_FCS_INIT 0xFFFF
 
+// --- CRC-16-CCITT (MSB zuerst, Start 0xFFFF, Ergebnis invertiert) ---
+// Inkrementell: crc = crc16_ccitt_init(); crc = crc16_ccitt_update(crc, ...)
+// beliebig oft; crc16_ccitt_final(crc) liefert die FCS. Die Berechnung läuft
+// über die schnellste Variante der CPU (PCLMULQDQ, sonst Slice-by-8-Tabellen),
+// alle Varianten liefern dasselbe Ergebnis wie die bitweise Referenz.
+
+/**
+ * @brief Signatur einer CRC-Variante (Zwischenstand crc, ohne Invertierung).
+ */
+typedef uint16_t (*crc16_update_fn)(uint16_t crc, const uint8_t* data, size_t length);
+
+static inline uint16_t crc16_ccitt_init(void) {
+    return AX25_FCS_INIT;
+}
+
+/**
+ * @brief Rechnet length weitere Bytes in den Zwischenstand crc ein.
+ */
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t* data, size_t length);
+
+static inline uint16_t crc16_ccitt_final(uint16_t crc) {
+    // Die finale CRC wird invertiert (XOR mit 0xFFFF)
+    return (uint16_t) ~crc;
+}
+
+/**
+ * @brief CRC-16-CCITT eines vollständigen Puffers (init, update, final).
+ */
 uint16_t crc16_ccitt(const uint8_t *data, size_t length);
 
-#endif // CRC_H
\ No newline at end of file
+/**
+ * @brief Liefert eine Variante per Name ("bitwise", "slice8", "clmul"), falls die CPU sie unterstützt.
+ * @return crc16_update_fn oder NULL.
+ */
+crc16_update_fn crc16_ccitt_engine(const char* name);
+
+/**
+ * @brief Name der aktiven Variante.
+ */
+const char* crc16_ccitt_engine_name(void);
+
+// --- CRC-16/X.25 (LSB zuerst, Start 0xFFFF, Ergebnis invertiert) ---
+// Die AX.25-FCS: HDLC sendet jedes Byte LSB zuerst, die CRC läuft daher
+// bitgespiegelt (Polynom CRC16_X25_POLY, Prüfwert "123456789" = 0x906E).
+// Schnittstelle und Varianten wie bei crc16_ccitt_*, aktiv ist dieselbe
+// Variante (crc16_ccitt_engine_name).
+
+static inline uint16_t crc16_x25_init(void) {
+    return AX25_FCS_INIT;
+}
+
+/**
+ * @brief Rechnet length weitere Bytes in den Zwischenstand crc ein.
+ */
+uint16_t crc16_x25_update(uint16_t crc, const uint8_t* data, size_t length);
+
+static inline uint16_t crc16_x25_final(uint16_t crc) {
+    return (uint16_t) ~crc;
+}
+
+/**
+ * @brief CRC-16/X.25 eines vollständigen Puffers (init, update, final).
+ */
+uint16_t crc16_x25(const uint8_t* data, size_t length);
+
+/**
+ * @brief Liefert eine Variante per Name ("bitwise", "slice8", "clmul"), falls die CPU sie unterstützt.
+ * @return crc16_update_fn oder NULL.
+ */
+crc16_update_fn crc16_x25_engine(const char* name);
+
+#endif // CRC_H
@@ -4,6 +4,10 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "../sink.h"
+#include "../fsk.h"
+#include "ax25.h"
+
 // --- AFSK1200 (AX.25) Konstanten ---
 
 // Die Baudrate für AFSK (Bits pro Sekunde)
@@ -13,18 +17,79 @@
 #define AFSK_MARK_FREQ 1200
 #define AFSK_SPACE_FREQ 2200
 
+// Flags zwischen zwei Frames einer Übertragung (Ende des einen = Start des nächsten)
+#define AFSK_SEPARATOR_FLAGS 1
+
+// Bytes Info-Feld je rs_afsk1200_step()
+#define AFSK1200_STEP_BYTES 64
+
+// Framer-Zustand je Aufruf (keine globalen Variablen, damit mehrere Jobs
+// parallel rendern können)
+typedef struct {
+    rs_fsk_modulator mod;
+    const hdlc_tables* tables;
+    uint64_t pending;     // Gepackte, noch nicht modulierte Töne (LSB zuerst)
+    int pendingCount;
+    uint32_t level;       // Letzter Ton (NRZI), 1 = Mark
+    uint32_t ones;        // Aufeinanderfolgende 1-Bits (Bit-Stuffing)
+} hdlc_state;
+
+/**
+ * @brief Zustand einer AFSK1200-Übertragung; rs_afsk1200_step() setzt sie fort.
+ */
+typedef struct {
+    hdlc_state hdlc;
+    const ax25_frame* frames;   // Bleiben beim Aufrufer
+    size_t count;
+    size_t frame;               // Aktueller Frame
+    int started;                // 1 = Präambel gesendet
+    uint8_t header[AX25_HEADER_LEN];
+    uint8_t fcs[2];
+    const uint8_t* info;
+    size_t infoLength;
+    size_t infoPosition;        // Nächstes Byte des Info-Felds
+} rs_afsk1200_stream;
+
+/**
+ * @brief Bereitet eine Übertragung mit count Frames vor (noch keine Ausgabe).
+ * @return 0 bei Erfolg, 1 wenn count == 0.
+ */
+int rs_afsk1200_init(rs_afsk1200_stream* stream, rs_sink* sink, const ax25_frame* frames, size_t count);
+
+/**
+ * @brief Schreibt den nächsten Abschnitt (höchstens AFSK1200_STEP_BYTES Bytes
+ * Info-Feld plus Flags, Kopf und FCS an den Framegrenzen) in den Sink.
+ * @return 1, solange weitere Abschnitte folgen; 0 nach dem letzten.
+ */
+int rs_afsk1200_step(rs_afsk1200_stream* stream);
+
 /**
  * @brief Kodiert die übergebenen Daten in einen AX.25-Frame und generiert
- * das AFSK1200-Audiosignal direkt an stdout (S16_LE).
+ * das AFSK1200-Audiosignal über den Sink.
  *
  * Die Funktion übernimmt die gesamte Verarbeitung: AX.25-Frame-Erstellung,
  * CRC-Berechnung, Bit-Stuffing, NRZI-Kodierung und AFSK-Modulation.
  *
+ * @param sink Ziel der PCM-Samples.
  * @param tx_call Sender-Rufzeichen (z.B. "DL1ABC-1").
  * @param dest_call Empfänger-Rufzeichen (z.B. "APRS").
  * @param message Die zu übertragende Nachricht (Info-Feld).
  * @return int 0 bei Erfolg, 1 bei Fehler.
  */
-int rs_encode_afsk1200(const char* tx_call, const char* dest_call, const char* message);
+int rs_encode_afsk1200(rs_sink* sink, const char* tx_call, const char* dest_call, const char* message);
+
+/**
+ * @brief Sendet mehrere AX.25-Frames in einer Übertragung.
+ *
+ * Eine gemeinsame Präambel, danach die Frames getrennt durch
+ * AFSK_SEPARATOR_FLAGS Flags und ein abschließendes Flag. Bit-Stuffing und
+ * NRZI laufen byteweise über Tabellen.
+ *
+ * @param sink Ziel der PCM-Samples.
+ * @param frames Die Frames in Sendereihenfolge.
+ * @param count Anzahl Frames (mindestens 1).
+ * @return int 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_encode_afsk1200_frames(rs_sink* sink, const ax25_frame* frames, size_t count);
 
 #endif // AFSK1200_H
\ No newline at end of file
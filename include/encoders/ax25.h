@@ -0,0 +1,48 @@
+#ifndef AX25_H
+#define AX25_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- AX.25 / HDLC (gemeinsam für AFSK1200 und FSK9600) ---
+
+#define AX25_FLAG 0x7E
+#define AX25_ADDR_LEN 7
+#define AX25_HEADER_LEN (2 * AX25_ADDR_LEN + 2)
+
+/**
+ * @brief Ein AX.25-UI-Frame einer Übertragung.
+ */
+typedef struct {
+    const char* txCall;     // Sender-Rufzeichen (z.B. "DL1ABC-1")
+    const char* destCall;   // Empfänger-Rufzeichen (z.B. "APRS")
+    const char* message;    // Info-Feld
+} ax25_frame;
+
+// --- HDLC-TABELLEN ---
+// Bit-Stuffing und NRZI je Byte: Eintrag [Einsen davor][Byte] enthält die
+// NRZI-Pegel (LSB zuerst, Startpegel 0), ihre Anzahl (8-10) und die Einsen
+// danach. Bei Startpegel 1 sind alle Pegel invertiert.
+#define HDLC_LEVELS(entry) ((entry) & 0x3FF)
+#define HDLC_COUNT(entry) (((entry) >> 16) & 0xF)
+#define HDLC_ONES(entry) ((entry) >> 24)
+#define HDLC_MAX_BITS 10    // Ein Byte mit zwei Stopf-Bits
+
+typedef struct {
+    uint32_t entry[5][256];
+    uint32_t flag;          // Flag ohne Stuffing, gleiche Kodierung
+} hdlc_tables;
+
+/**
+ * @brief Die HDLC-Tabellen: beim ersten Aufruf berechnet, danach nur gelesen.
+ */
+const hdlc_tables* hdlc_get_tables(void);
+
+/**
+ * @brief Baut Kopf (Adressen, Control UI, PID) und FCS eines UI-Frames.
+ * * Die CRC läuft inkrementell über Kopf und Info-Feld, das Info-Feld wird nicht kopiert.
+ * @param fcs Erhält die FCS, niederwertiges Byte zuerst.
+ */
+void ax25_build_frame(const ax25_frame* frame, uint8_t header[AX25_HEADER_LEN], uint8_t fcs[2]);
+
+#endif // AX25_H
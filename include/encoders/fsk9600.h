@@ -2,18 +2,85 @@
 #define FSK9600_H
 
 #include <stdint.h>
+#include <stddef.h>
 
-// FSK9600 Konstanten
+#include "../sink.h"
+#include "../kernels.h"
+#include "ax25.h"
+
+// FSK9600 Konstanten (G3RUH: verwürfeltes Basisband, kein Ton-FSK)
 #define FSK9600_BAUD_RATE 9600
-#define FSK9600_MARK_FREQ 4800    // Logisch '1'
-#define FSK9600_SPACE_FREQ 8400   // Logisch '0'
+#define FSK9600_PREAMBLE_FLAGS 16   // 0x7E vor dem Frame (Synchronisation des Descramblers, das letzte ist das Start-Flag)
+#define FSK9600_TAIL_FLAGS 2        // 0x7E nach dem Frame
+#define FSK9600_ROLLOFF 0.5         // Raised-Cosine-Rolloff der Pulsformung
+#define FSK9600_AMPLITUDE 32767     // Symbolwert vor der Pulsformung (±)
+#define FSK9600_STEP_BYTES 64       // Bytes je rs_fsk9600_step() (512-640 Symbole)
+
+// --- POLYPHASEN-PULSFORMUNG ---
+// 9600 / 22050 = 64 / 147: alle 147 Ausgangssamples (eine Periode) fallen
+// wieder 64 Symbole exakt auf das Raster. Jedes Ausgangssample hat damit eine
+// von 147 festen Phasen mit eigener Koeffizientenzeile über FSK9600_SHAPER_TAPS Symbole.
+#define FSK9600_SHAPER_PHASES 147
+#define FSK9600_SHAPER_SYMBOLS 64
+#define FSK9600_SHAPER_TAPS 8       // Raised Cosine über ±4 Symbole
+#define FSK9600_SHAPER_CHUNK 8      // Perioden je Sink-Schreibvorgang
+
+// Symbolpuffer: FSK9600_SHAPER_TAPS - 1 Symbole Überhang zur nächsten Periode;
+// ein gestopftes Byte (bis HDLC_MAX_BITS Symbole) darf über den Chunk hinausragen
+#define FSK9600_SYMBOL_HISTORY (FSK9600_SHAPER_TAPS - 1)
+#define FSK9600_SYMBOL_CHUNK (FSK9600_SHAPER_CHUNK * FSK9600_SHAPER_SYMBOLS + FSK9600_SYMBOL_HISTORY)
+#define FSK9600_SYMBOL_CAPACITY (FSK9600_SYMBOL_CHUNK + HDLC_MAX_BITS - 1)
+
+/**
+ * @brief Zustand einer Übertragung: AX.25-Frame, Bit-Stuffing, NRZI-Pegel,
+ * Scrambler-Historie und Symbolpuffer; rs_fsk9600_step() setzt sie fort.
+ */
+typedef struct {
+    rs_sink* sink;
+    const rs_kernel_table* kernels;
+    const hdlc_tables* tables;
+    uint8_t header[AX25_HEADER_LEN];
+    uint8_t fcs[2];
+    const uint8_t* info;    // Info-Feld, bleibt beim Aufrufer
+    size_t infoLength;
+    size_t position;        // Nächstes Byte der Übertragung (inkl. Flags, Kopf, FCS)
+    uint32_t ones;          // Aufeinanderfolgende 1-Bits (Bit-Stuffing)
+    uint32_t level;         // Letzter NRZI-Pegel (0 oder 1)
+    uint32_t history;       // Letzte 17 Scrambler-Ausgangsbits, ältestes in Bit 0
+    size_t symbols;         // Gesendete Symbole (ohne Vorlauf)
+    size_t emitted;         // Geschriebene Samples
+    size_t fill;
+    int16_t symbol[FSK9600_SYMBOL_CAPACITY];
+    int16_t out[FSK9600_SHAPER_CHUNK * FSK9600_SHAPER_PHASES];
+} rs_fsk9600_stream;
+
+/**
+ * @brief Bereitet eine Übertragung vor (noch keine Ausgabe); Kopf und FCS
+ * werden sofort berechnet, die Zeichenketten des Frames bleiben beim Aufrufer.
+ * @return 0 bei Erfolg, 1 bei leerer Nachricht.
+ */
+int rs_fsk9600_init(rs_fsk9600_stream* stream, rs_sink* sink, const ax25_frame* frame);
+
+/**
+ * @brief Schreibt die nächsten FSK9600_STEP_BYTES Bytes in den Sink, nach dem
+ * letzten Byte auch den Ausklang des Pulsformers.
+ * @return 1, solange weitere Abschnitte folgen; 0 nach dem letzten.
+ */
+int rs_fsk9600_step(rs_fsk9600_stream* stream);
 
 /**
- * @brief Enkodiert eine Nachricht als FSK9600-Signal und schreibt PCM auf stdout.
- * 
- * @param message Die zu sendende Nachricht (Bytes).
+ * @brief Sendet einen AX.25-UI-Frame als G3RUH-kompatibles FSK9600-Basisband
+ * und schreibt PCM in den Sink.
+ * * Frame (LSB zuerst) -> Bit-Stuffing und NRZI (HDLC-Tabellen wie AFSK1200)
+ * -> Scrambler 1 + x^12 + x^17 -> Raised-Cosine-Pulsformung bei SAMPLE_RATE.
+ * Die Symbolzeitpunkte liegen exakt auf dem 9600-Baud-Raster (Polyphasen-FIR),
+ * auch wenn SAMPLE_RATE kein Vielfaches ist.
+ * @param sink Ziel der PCM-Samples.
+ * @param tx_call Sender-Rufzeichen (z.B. "DL1ABC-1").
+ * @param dest_call Empfänger-Rufzeichen (z.B. "APRS").
+ * @param message Die zu sendende Nachricht (Info-Feld).
  * @return 0 bei Erfolg, 1 bei Fehler.
  */
-int rs_encode_fsk9600(const char* message);
+int rs_encode_fsk9600(rs_sink* sink, const char* tx_call, const char* dest_call, const char* message);
 
 #endif // FSK9600_H
@@ -5,10 +5,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "../signal_generator.h"
+#include "../sink.h"
+
 // Morsecode Konstanten (Timing basiert auf der 'Dit'-Dauer)
 // Wir verwenden WPM (Words Per Minute) basierend auf dem Wort "PARIS".
-// Standard-Werte bei 22050 Hz Sampling-Rate.
-#define SAMPLE_RATE 22050
+// Standard-Werte bei SAMPLE_RATE (signal_generator.h).
 #define DOT_LENGTH_MS 50 // Standard 'Dit'-Dauer in Millisekunden
 #define DOT_SAMPLES (SAMPLE_RATE * DOT_LENGTH_MS / 1000)
 
@@ -25,33 +27,79 @@
 #define WORD_GAP_SAMPLES (DOT_SAMPLES * 7)
 #define ELEMENT_GAP_SAMPLES DOT_SAMPLES
 
-// Struktur zur Darstellung des Morsecodes
-// max. 6 Elemente (z.B. '5' ist '.....', '/' ist '-..-.')
-#define MAX_MORSE_LENGTH 6
+// --- STREAMING-ENCODER ---
+// Der Text wird zeichenweise (in beliebigen Stücken) gelesen und direkt in den
+// Sink geschrieben. Speicherbedarf: nur die Dit-/Dah-Vorlagen, unabhängig von
+// der Länge der Nachricht.
 typedef struct {
-    uint8_t length; // Länge des Codes (z.B. 4 für '....')
-    bool elements[MAX_MORSE_LENGTH]; // true = Dah, false = Dit
-} MorseCode;
+    rs_sink* sink;
+    const int16_t* dit;       // Vorlage eines Dits (dotSamples Samples)
+    const int16_t* dah;       // Vorlage eines Dahs (3 * dotSamples Samples)
+    size_t dotSamples;
+    size_t pendingDots;       // Noch nicht ausgegebene Pause (in Dits)
+    bool previousWasSpace;
+    uint64_t samples;         // Bisher geschriebene Samples
+    const char* text;         // Aktuelle Zeichen (morse_streamSetText, bleiben beim Aufrufer)
+    size_t length;
+    size_t position;          // Nächstes Zeichen in text
+    uint8_t code;             // Offene Elemente des aktuellen Zeichens (1 = keine)
+} morse_stream;
 
 /**
- * @brief Kodiert einen gegebenen ASCII-String in eine Sequenz von Morse-Elementen
- * und generiert das rohe Audiosignal (PCM).
+ * @brief Anzahl Samples, die morse_streamInit() für die Vorlagen benötigt.
  *
- * @param message Die zu sendende ASCII-Nachricht (nur Buchstaben A-Z, Zahlen 0-9, Leerzeichen).
  * @param wpm Die Geschwindigkeit in Wörtern pro Minute.
- * @param out Zeiger auf den Speicherort, an dem das PCM-Signal gespeichert wird.
- * @param buffer_size Die maximale Größe des Ausgabepuffers.
- * @return size_t Die tatsächlich geschriebene Anzahl von PCM-Samples (oder 0 bei Fehler).
+ * @return size_t 4 Dits (Dit + Dah) oder 0 bei wpm == 0.
  */
-size_t morse_encodeTransmission(const char* message, uint32_t wpm, int16_t* out, size_t buffer_size);
+size_t morse_templateSamples(uint32_t wpm);
 
 /**
- * @brief Berechnet die erforderliche Puffergröße für die vollständige Nachricht.
+ * @brief Bereitet einen Morse-Strom vor und rendert die Dit-/Dah-Vorlagen.
  *
- * @param message Die Nachricht.
+ * @param stream Der Zustand des Stroms.
+ * @param sink Ziel der PCM-Samples.
  * @param wpm Die Geschwindigkeit in Wörtern pro Minute.
- * @return size_t Die erforderliche Anzahl von 16-Bit-Samples.
+ * @param templates Speicher für morse_templateSamples(wpm) Samples (bleibt beim Aufrufer).
+ * @return int 0 bei Erfolg, -1 bei ungültigen Parametern.
+ */
+int morse_streamInit(morse_stream* stream, rs_sink* sink, uint32_t wpm, int16_t* templates);
+
+/**
+ * @brief Kodiert die nächsten Zeichen der Nachricht und schreibt sie in den Sink.
+ * * Darf beliebig oft aufgerufen werden; Pausen über Stückgrenzen hinweg bleiben korrekt.
+ * Unbekannte Zeichen werden mit einer Warnung übersprungen.
+ *
+ * @param stream Der Zustand des Stroms.
+ * @param text Die Zeichen (nur Buchstaben A-Z, Zahlen 0-9, . , ? / und Leerzeichen).
+ * @param length Anzahl Zeichen in text.
+ */
+void morse_streamWrite(morse_stream* stream, const char* text, size_t length);
+
+/**
+ * @brief Übergibt Zeichen für die schrittweise Ausgabe mit morse_streamStep().
+ *
+ * @param stream Der Zustand des Stroms.
+ * @param text Die Zeichen (bleiben bis zum letzten Schritt beim Aufrufer).
+ * @param length Anzahl Zeichen in text.
+ */
+void morse_streamSetText(morse_stream* stream, const char* text, size_t length);
+
+/**
+ * @brief Gibt das nächste Element (Dit oder Dah, samt Pausen davor) in den Sink aus.
+ * * Ein Schritt schreibt höchstens 10 Dits Pause, ein Dah und eine Element-Lücke; unbekannte Zeichen
+ * werden mit einer Warnung übersprungen.
+ *
+ * @param stream Der Zustand des Stroms.
+ * @return true, solange weitere Elemente folgen können; false, wenn text verbraucht ist.
+ */
+bool morse_streamStep(morse_stream* stream);
+
+/**
+ * @brief Schließt den Strom ab (ohne Zeichen-Lücke nach dem letzten Zeichen).
+ *
+ * @param stream Der Zustand des Stroms.
+ * @return uint64_t Die Anzahl insgesamt geschriebener PCM-Samples.
  */
-size_t morse_messageLength(const char* message, uint32_t wpm);
+uint64_t morse_streamFinish(morse_stream* stream);
 
-#endif // MORSE_H
\ No newline at end of file
+#endif // MORSE_H
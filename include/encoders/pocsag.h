@@ -10,6 +10,7 @@
 #define FRAME_SIZE 2        // 2 Wörter pro Frame
 #define TEXT_BITS_PER_WORD 20
 #define TEXT_BITS_PER_CHAR 7
+#define NUMERIC_BITS_PER_CHAR 4 // BCD bei FUNC_NUMERIC_1/FUNC_NUMERIC_2
 
 // Funktionscodes (Bit 1-2 des Adresswort-Datenfeldes)
 typedef enum {
@@ -19,6 +20,24 @@ typedef enum {
     FUNC_ALPHA_TEXT = 3
 } FunctionCode;
 
+// Eine Seite (Adresse + Nachricht). Mehrere Seiten können sich denselben
+// Nachrichtentext teilen (Gruppenruf an mehrere Capcodes).
+typedef struct {
+    uint32_t address;           // 21-Bit-Adresse (Capcode)
+    FunctionCode functionCode;
+    const char* message;
+} pocsag_page;
+
+/**
+ * @brief Kodiert 21 Datenbits zu einem 32-Bit-Codewort (BCH(31,21)-Prüfbits und gerade Parität).
+ */
+uint32_t pocsag_encodeCodeword(uint32_t data);
+
+/**
+ * @brief Prüft, ob ein Zeichen im numerischen Zeichensatz liegt (0-9, U, Leerzeichen, -, [ ] ( )).
+ */
+int pocsag_isNumericChar(char c);
+
 /**
  * @brief Berechnet die Gesamtlänge der POCSAG-Übertragung in 32-Bit-Wörtern.
  */
@@ -34,4 +53,21 @@ void pocsag_encodeTransmission(
     FunctionCode functionCode
 );
 
+/**
+ * @brief Legt die Sendereihenfolge mehrerer Seiten fest und berechnet die Länge der Übertragung.
+ * * Jedes Adresswort muss im Frame (address & 7) stehen. Statt bis dorthin mit
+ * IDLE aufzufüllen, wird als nächstes die Seite gesendet, deren Frame zuerst
+ * erreicht wird; Seiten desselben Frames bleiben in Eingabereihenfolge.
+ * @param order Ausgabe: count Indizes in pages in Sendereihenfolge.
+ * @return Die Gesamtlänge in 32-Bit-Wörtern (Präambel, SYNC- und Füllwörter eingeschlossen).
+ */
+size_t pocsag_planPages(const pocsag_page* pages, size_t count, size_t* order);
+
+/**
+ * @brief Kodiert mehrere Seiten in einer Übertragung (eine Präambel, ein SYNC je Batch).
+ * @param order Die Sendereihenfolge aus pocsag_planPages().
+ * @param out Puffer mit der von pocsag_planPages() gelieferten Länge.
+ */
+void pocsag_encodePages(const pocsag_page* pages, const size_t* order, size_t count, uint32_t* out);
+
 #endif // POCSAG_H
\ No newline at end of file
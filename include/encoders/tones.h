@@ -4,15 +4,80 @@
 #include <stdio.h> // Für int
 #include <unistd.h> // Für usleep (obwohl oft in der .c-Datei, hier zur Vollständigkeit)
 
+#include "../sink.h"
+#include "../signal_generator.h"
+#include "../oscillator.h"
+#include "../kernels.h"
+
+// Ton-Wellenformen der 16 Ziffern werden bis zu dieser Länge (1 s) zwischengespeichert
+#define RS_DTMF_DIGITS 16
+#define RS_DTMF_CACHE_MAX_SAMPLES SAMPLE_RATE
+
+/**
+ * @brief Zwischengespeicherte Ton-Wellenformen der 16 Ziffern für eine Tondauer.
+ * * Mit { 0 } initialisieren; wird zwischen Aufrufen wiederverwendet.
+ */
+typedef struct {
+    int16_t* pcm;            // RS_DTMF_DIGITS * toneSamples Samples, Reihenfolge Reihe * 4 + Spalte
+    size_t capacity;         // Samples in pcm
+    size_t toneSamples;      // Tondauer, für die pcm gilt
+    uint32_t ready;          // Bit n = Wellenform der Ziffer n ist gerendert
+} rs_dtmf_cache;
+
+typedef enum {
+    RS_DTMF_NEXT_DIGIT = 0,
+    RS_DTMF_TONE,
+    RS_DTMF_PAUSE
+} rs_dtmf_part;
+
+/**
+ * @brief Zustand einer DTMF-Sequenz; rs_dtmf_step() setzt sie fort.
+ */
+typedef struct {
+    rs_sink* sink;
+    const rs_kernel_table* kernels;
+    rs_dtmf_cache* cache;
+    const char* next;           // Nächste Ziffer (bleibt beim Aufrufer)
+    size_t toneSamples;
+    size_t pauseSamples;
+    rs_dtmf_part part;          // Aktueller Abschnitt
+    size_t offset;              // Bereits geschriebene Samples des Abschnitts
+    const int16_t* waveform;    // Zwischengespeicherter Ton oder NULL (dann Oszillatoren)
+    rs_oscillator oscLow;
+    rs_oscillator oscHigh;
+} rs_dtmf_stream;
+
+/**
+ * @brief Bereitet eine DTMF-Sequenz vor (noch keine Ausgabe).
+ * * Parameter wie rs_encode_dtmf().
+ */
+void rs_dtmf_init(rs_dtmf_stream* stream, rs_sink* sink, const char* digits,
+                  int tone_duration_ms, int pause_duration_ms, rs_dtmf_cache* cache);
+
+/**
+ * @brief Schreibt den nächsten Abschnitt (höchstens PCM_BLOCK_SAMPLES Samples
+ * Ton oder Pause) in den Sink. Unbekannte Ziffern werden gemeldet und übersprungen.
+ * @return 1, solange weitere Abschnitte folgen; 0 nach dem letzten.
+ */
+int rs_dtmf_step(rs_dtmf_stream* stream);
+
 /**
  * @brief Codiert und sendet eine Sequenz von DTMF-Tönen (Dual-Tone Multi-Frequency).
  * * Diese Funktion generiert die Audiosignale für DTMF-Ziffern und gibt sie als
- * Raw-Audio-Daten an stdout aus.
- * * @param digits Eine Zeichenkette der zu sendenden Ziffern (0-9, *, #, A-D).
+ * Raw-Audio-Daten über den Sink aus.
+ * * @param sink Ziel der PCM-Samples.
+ * @param digits Eine Zeichenkette der zu sendenden Ziffern (0-9, *, #, A-D).
  * @param tone_duration_ms Die Dauer eines Tones in Millisekunden (z.B. 50ms).
  * @param pause_duration_ms Die Pause zwischen den Tönen in Millisekunden (z.B. 50ms).
- * @return 0 bei Erfolg, ungleich 0 bei unbekanntem Zeichen.
+ * @param cache Wellenform-Cache (NULL = jeden Ton neu rendern).
+ * @return 0 bei Erfolg, ungleich 0 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_encode_dtmf(rs_sink* sink, const char *digits, int tone_duration_ms, int pause_duration_ms,
+                   rs_dtmf_cache* cache);
+
+/**
+ * @brief Gibt den Speicher des Wellenform-Caches frei.
  */
-int rs_encode_dtmf(const char *digits, int tone_duration_ms, int pause_duration_ms);
+void rs_dtmf_cache_free(rs_dtmf_cache* cache);
 
 #endif // TONES_H
\ No newline at end of file
@@ -2,19 +2,49 @@
 #define UFSK1200_H
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "../sink.h"
+#include "../fsk.h"
 
 // UFSK1200 Konstanten  
 #define UFSK1200_BAUD_RATE 1200
 #define UFSK1200_MARK_FREQ 1200    // Logisch '1'
 #define UFSK1200_SPACE_FREQ 2200   // Logisch '0'
+#define UFSK1200_STEP_BYTES 64     // Bytes je rs_ufsk1200_step()
+
+/**
+ * @brief Zustand einer UFSK1200-Übertragung; rs_ufsk1200_step() setzt sie fort.
+ */
+typedef struct {
+    rs_fsk_modulator mod;
+    const char* message;     // Bleibt beim Aufrufer
+    size_t length;
+    size_t position;         // Nächstes Byte
+    int preambleSent;
+} rs_ufsk1200_stream;
+
+/**
+ * @brief Bereitet eine Übertragung vor (noch keine Ausgabe).
+ * @return 0 bei Erfolg, 1 bei leerer Nachricht.
+ */
+int rs_ufsk1200_init(rs_ufsk1200_stream* stream, rs_sink* sink, const char* message);
+
+/**
+ * @brief Schreibt den nächsten Abschnitt (Präambel bzw. bis zu
+ * UFSK1200_STEP_BYTES Bytes) in den Sink.
+ * @return 1, solange weitere Abschnitte folgen; 0 nach dem letzten.
+ */
+int rs_ufsk1200_step(rs_ufsk1200_stream* stream);
 
 /**
- * @brief Enkodiert eine Nachricht als UFSK1200-Signal und schreibt PCM auf stdout.
+ * @brief Enkodiert eine Nachricht als UFSK1200-Signal und schreibt PCM in den Sink.
  * UFSK1200 ist eine einfachere Version von AFSK1200 ohne HDLC-Framing.
  * 
+ * @param sink Ziel der PCM-Samples.
  * @param message Die zu sendende Nachricht (Bytes).
  * @return 0 bei Erfolg, 1 bei Fehler.
  */
-int rs_encode_ufsk1200(const char* message);
+int rs_encode_ufsk1200(rs_sink* sink, const char* message);
 
 #endif // UFSK1200_H
@@ -0,0 +1,140 @@
+#ifndef FSK_H
+#define FSK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sink.h"
+
+// --- FSK-SYMBOLTABELLEN ---
+// Ein phasenkontinuierlicher FSK-Modulator mit zwei Tönen erzeugt pro Symbol
+// immer dieselbe Folge, sobald Ton und Startphase feststehen. Die Startphase
+// wird deshalb auf RS_FSK_PHASE_BUCKETS Stufen gerundet (so fein wie die
+// Sinustabelle des NCO), und jedes Symbol ist eine Blockkopie aus der Tabelle.
+// Die exakte Phase läuft im Modulator weiter, der Rundungsfehler summiert sich
+// also nicht über die Übertragung auf.
+#define RS_FSK_PHASE_BITS 10
+#define RS_FSK_PHASE_BUCKETS (1u << RS_FSK_PHASE_BITS)
+#define RS_FSK_BUCKET_SHIFT (32 - RS_FSK_PHASE_BITS)
+
+// Blöcke liegen im Abstand von ganzen 8er-Gruppen (16 Byte), damit ein Symbol
+// mit festen 16-Byte-Kopien geschrieben werden kann
+#define RS_FSK_STRIDE(samplesPerSymbol) (((samplesPerSymbol) + 7) & ~(size_t)7)
+
+// Längstes Symbol: sampleRate / baud aufgerundet. Bei gebrochenem Verhältnis
+// (1200 Baud bei 22050 Hz = 18.375 Samples) wechseln sich Symbole mit 18 und
+// 19 Samples ab, so dass die mittlere Baudrate exakt stimmt.
+#define RS_FSK_SYMBOL_MAX(sampleRate, baud) (((size_t)(sampleRate) + (baud) - 1) / (baud))
+
+// Benötigte Samples für die Tabelle eines Modulators (beide Töne, alle Phasen)
+#define RS_FSK_TABLE_SAMPLES(sampleRate, baud) \
+    (2 * RS_FSK_PHASE_BUCKETS * RS_FSK_STRIDE(RS_FSK_SYMBOL_MAX(sampleRate, baud)))
+
+// Ausgabepuffer des Modulators; zugleich die größte erlaubte Symbollänge
+#define RS_FSK_BUFFER_SAMPLES 2048
+
+/**
+ * @brief Vorgerenderte Symbolblöcke eines Modulators (nach dem Aufbau nur gelesen).
+ */
+typedef struct {
+    const int16_t* blocks;      // [Ton][Phasenstufe][stride], Ton 0 = Space, 1 = Mark
+    size_t samplesPerSymbol;    // sampleRate / baud (abgerundet)
+    size_t stride;
+    uint32_t advance[2];        // Phasenfortschritt je kurzem Symbol (Space, Mark)
+    uint32_t increment[2];      // Phasenfortschritt je Sample (für das Zusatz-Sample)
+    uint32_t remainder;         // sampleRate % baud: Symboltakt-Rest je Symbol
+    uint32_t baud;
+} rs_fsk_table;
+
+/**
+ * @brief Zustand eines Modulators je Aufruf: Phase und Ausgabepuffer.
+ */
+typedef struct {
+    const rs_fsk_table* table;
+    rs_sink* sink;
+    uint32_t phase;
+    uint32_t clock;             // Gebrochener Symboltakt (0 .. baud - 1)
+    size_t fill;
+    int16_t buffer[RS_FSK_BUFFER_SAMPLES + 8];  // + 8: Überhang der 16-Byte-Kopien
+} rs_fsk_modulator;
+
+/**
+ * @brief Rendert die Symbolblöcke für zwei Töne in storage.
+ * * Ein Symbol dauert sampleRate / baud Samples; bei gebrochenem Verhältnis
+ * verlängert ein Bresenham-Takt einzelne Symbole um ein Sample. storage muss
+ * RS_FSK_TABLE_SAMPLES(sampleRate, baud) Samples fassen und bleibt so lange
+ * gültig wie die Tabelle.
+ * @param mark Frequenz für logisch 1 (Hz).
+ * @param space Frequenz für logisch 0 (Hz).
+ * @return int 0 bei Erfolg, 1 wenn ein Symbol kürzer als ein Sample oder länger
+ * als RS_FSK_BUFFER_SAMPLES wäre (storage bleibt dann unberührt).
+ */
+int rs_fsk_table_init(rs_fsk_table* table, int16_t* storage, double mark, double space,
+                       uint32_t baud, uint32_t sampleRate);
+
+/**
+ * @brief Startet einen Modulator mit Phase 0, der in sink schreibt.
+ */
+void rs_fsk_init(rs_fsk_modulator* mod, const rs_fsk_table* table, rs_sink* sink);
+
+/**
+ * @brief Gibt die gepufferten Samples an den Sink weiter.
+ * @return int 0 bei Erfolg, sonst 1 (Fehler steht in sink->error).
+ */
+int rs_fsk_flush(rs_fsk_modulator* mod);
+
+/**
+ * @brief Hängt count Symbole (1-32) an, Töne aus bits mit dem LSB zuerst
+ * (0 = Space, 1 = Mark).
+ * * Phase, Symboltakt und Füllstand bleiben in der Schleife in Registern.
+ */
+static inline void rs_fsk_symbols(rs_fsk_modulator* mod, uint32_t bits, int count) {
+    const rs_fsk_table* table = mod->table;
+    const size_t samplesPerSymbol = table->samplesPerSymbol;
+    const size_t stride = table->stride;
+    const uint32_t remainder = table->remainder;
+    const uint32_t baud = table->baud;
+    // Platz für das längste Symbol (höchstens RS_FSK_BUFFER_SAMPLES, siehe Init)
+    const int16_t* end = mod->buffer + RS_FSK_BUFFER_SAMPLES - samplesPerSymbol - (remainder != 0);
+
+    uint32_t phase = mod->phase;
+    uint32_t clock = mod->clock;
+    int16_t* out = mod->buffer + mod->fill;
+    for (int n = 0; n < count; n++) {
+        if (out > end) {
+            mod->fill = (size_t)(out - mod->buffer);
+            rs_fsk_flush(mod);
+            out = mod->buffer;
+        }
+        uint32_t tone = (bits >> n) & 1;
+
+        // Symboltakt: Zusatz-Sample, sobald sich der Rest zu einem Symbol summiert
+        clock += remainder;
+        uint32_t extra = (clock >= baud);
+        clock -= extra ? baud : 0;
+
+        // Auf die nächste Phasenstufe runden (Überlauf am Periodenende ist gewollt)
+        uint32_t bucket = (phase + (1u << (RS_FSK_BUCKET_SHIFT - 1))) >> RS_FSK_BUCKET_SHIFT;
+        const int16_t* block = table->blocks + ((size_t)tone * RS_FSK_PHASE_BUCKETS + bucket) * stride;
+        for (size_t i = 0; i < stride; i += 8) {
+            memcpy(out + i, block + i, 8 * sizeof(int16_t));
+        }
+
+        out += samplesPerSymbol + extra;
+        phase += table->advance[tone] + (extra ? table->increment[tone] : 0);
+    }
+
+    mod->phase = phase;
+    mod->clock = clock;
+    mod->fill = (size_t)(out - mod->buffer);
+}
+
+/**
+ * @brief Hängt ein Symbol an (tone: 0 = Space, 1 = Mark).
+ */
+static inline void rs_fsk_symbol(rs_fsk_modulator* mod, int tone) {
+    rs_fsk_symbols(mod, (uint32_t)tone, 1);
+}
+
+#endif // FSK_H
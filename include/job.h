@@ -0,0 +1,166 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "sink.h"
+#include "encoders/tones.h"
+#include "encoders/pocsag.h"
+#include "encoders/afsk1200.h"
+#include "encoders/morse.h"
+
+// --- JOBS ---
+// Ein Job ist eine vollständige Übertragung: Optionen, Modulator, Parameter und
+// Ausgabeziel, genau wie die Kommandozeile von rawsignal_tx. Im Batch-Modus
+// wird je Eingabezeile ein Job gelesen und im selben Prozess gerendert.
+#define RS_JOB_MAX_ARGS 32
+
+// Rückgabewerte von rs_job_parse() und rs_job_render()
+#define RS_JOB_OK 0
+#define RS_JOB_FAILED 1  // Kodierung oder Ausgabe fehlgeschlagen
+#define RS_JOB_INVALID 2 // Ungültige Optionen oder Parameter
+#define RS_JOB_SKIPPED (-1) // Leerzeile oder Kommentar (nur rs_job_run_line)
+
+typedef struct {
+    uint32_t outputRate;     // Ausgabe-Abtastrate (-r)
+    rs_byte_order order;     // Byte-Reihenfolge (-L/-B)
+    const char* outputPath;  // Ausgabedatei (-o), NULL = gemeinsamer Sink
+    int quiet;               // 1 = keine "Info:"-Zeilen (Batch-Modus)
+    unsigned int seed;       // Startwert für die zufällige End-Stille (rand_r)
+    unsigned int repeat;     // Anzahl Wiederholungen (--repeat, Standard 1)
+    uint32_t intervalMs;     // Pause zwischen Wiederholungen (--interval)
+    const char* cacheDir;    // PCM-Cache (--cache), NULL = aus
+    int argc;                // Anzahl Argumente ab dem Modulator
+    char** argv;             // argv[0] = Modulator, danach seine Parameter
+} rs_job;
+
+/**
+ * @brief Zwischen Jobs wiederverwendete Puffer (wachsen nur, werden nie verkleinert).
+ */
+typedef struct {
+    uint32_t* words;         // POCSAG-Codewörter
+    size_t wordsCapacity;
+    pocsag_page* pages;      // POCSAG-Seiten einer Übertragung
+    size_t pagesCapacity;
+    size_t* order;           // Sendereihenfolge der Seiten
+    size_t orderCapacity;
+    char* text;              // Zerlegte Kopie der POCSAG-Parameter
+    size_t textCapacity;
+    ax25_frame* frames;      // AX.25-Frames einer AFSK1200-Übertragung
+    size_t framesCapacity;
+    int16_t* pcm;            // Morse-Vorlagen (Dit + Dah)
+    size_t pcmCapacity;
+    rs_dtmf_cache dtmf;      // DTMF-Wellenformen je Ziffer
+    char* key;               // Cache-Schlüssel
+    size_t keyCapacity;
+    rs_sink signal;          // Einmal gerenderte Übertragung (--repeat, Cache)
+    int signalReady;         // 1 = signal ist initialisiert
+} rs_job_buffers;
+
+/**
+ * @brief Wertet nur die Optionen (-r, -L/-B, -o, --repeat, --interval, --cache) am Anfang von argv aus.
+ * @return Anzahl verbrauchter Argumente oder -1 bei Fehler (Meldung auf stderr).
+ */
+int rs_job_parse_options(rs_job* job, int argc, char** argv);
+
+/**
+ * @brief Wertet Optionen und Modulator aus argv aus (ohne Programmnamen).
+ * * Felder von job, die vor dem Aufruf gesetzt sind, dienen als Standardwerte.
+ * job->argv zeigt anschließend in das übergebene argv.
+ * @return RS_JOB_OK oder RS_JOB_INVALID (Meldung bereits auf stderr).
+ */
+int rs_job_parse(rs_job* job, int argc, char** argv);
+
+/**
+ * @brief Zerlegt eine Jobzeile in Argumente (in-place).
+ * * Trennung an Leerraum; '...' und "..." fassen Leerzeichen ein, \ maskiert das
+ * nächste Zeichen. Leere Zeilen und Kommentare (#) ergeben 0 Argumente.
+ * @return Anzahl Argumente oder -1 bei Fehler (offenes Anführungszeichen, zu viele).
+ */
+int rs_job_split_line(char* line, char** argv, int maxArgs);
+
+/**
+ * @brief Rendert einen Job samt zufälliger End-Stille in den Sink.
+ * * Stellt die Abtastrate des Sinks auf job->outputRate ein und beendet den
+ * Abschnitt mit rs_sink_end_segment(); der Sink bleibt offen. Die Übertragung
+ * ist ein eigener Abschnitt vor der End-Stille. Mit --repeat oder --cache wird
+ * sie nur einmal gerendert (bzw. aus dem Cache gelesen) und job->repeat-mal
+ * ausgegeben, getrennt durch job->intervalMs Stille.
+ * @return RS_JOB_OK, RS_JOB_FAILED oder RS_JOB_INVALID.
+ */
+int rs_job_render(const rs_job* job, rs_sink* sink, rs_job_buffers* buffers);
+
+// --- MODULATOR-EINSTIEGSPUNKTE ---
+// Prüfen die Parameter und schreiben die Übertragung in den Sink, ohne
+// Abtastrate, End-Stille oder Abschnittsende anzufassen. Gemeinsam genutzt von
+// rs_job_render() und der Bibliothek (rawsignal.h).
+// Rückgabe jeweils RS_JOB_OK, RS_JOB_FAILED oder RS_JOB_INVALID.
+
+int rs_job_render_pocsag(rs_sink* sink, rs_job_buffers* buffers, uint32_t baudRate,
+                         uint32_t address, uint32_t functionCode, const char* message);
+int rs_job_render_pocsag_pages(rs_sink* sink, rs_job_buffers* buffers, uint32_t baudRate,
+                               const pocsag_page* pages, size_t count);
+int rs_job_render_dtmf(rs_sink* sink, rs_job_buffers* buffers, const char* digits, int toneMs, int pauseMs);
+int rs_job_render_morse(rs_sink* sink, rs_job_buffers* buffers, const char* message, uint32_t wpm);
+int rs_job_render_afsk1200(rs_sink* sink, const char* txCall, const char* destCall, const char* message);
+int rs_job_render_afsk1200_frames(rs_sink* sink, const ax25_frame* frames, size_t count);
+int rs_job_render_fsk9600(rs_sink* sink, const char* txCall, const char* destCall, const char* message);
+
+// Prüfung und Vorbereitung ohne Ausgabe, für die schrittweisen Generatoren
+// (rawsignal.h). Meldungen wie bei den Einstiegspunkten oben.
+
+/**
+ * @brief Prüft POCSAG-Seiten und kodiert sie in buffers->words.
+ * @param words Erhält die Anzahl Codewörter.
+ */
+int rs_job_encode_pocsag_pages(rs_job_buffers* buffers, uint32_t baudRate,
+                               const pocsag_page* pages, size_t count, size_t* words);
+int rs_job_check_dtmf(int toneMs, int pauseMs);
+int rs_job_check_ax25_frames(const ax25_frame* frames, size_t count);
+
+/**
+ * @brief Prüft wpm und startet einen Morse-Strom (Vorlagen in buffers->pcm).
+ */
+int rs_job_open_morse(morse_stream* stream, rs_sink* sink, rs_job_buffers* buffers, uint32_t wpm);
+
+/**
+ * @brief Zerlegt, prüft und rendert eine Jobzeile (Batch-Modus und Dienst).
+ * * Der Job erhält den Startwert rs_job_seed(defaults->seed, number). Jobs mit -o
+ * schreiben in einen eigenen Datei-Sink, alle anderen in shared. job und args
+ * (RS_JOB_MAX_ARGS Einträge) nehmen den geparsten Job auf und zeigen in line.
+ * @param stream 1 = shared ist ein gemeinsamer Ausgabestrom (Batch): Jobs ohne -o
+ * dürfen Rate und Byte-Reihenfolge dann nicht ändern (sonst RS_JOB_INVALID).
+ * 0 = shared gehört nur diesem Job (Dienst-Antwort).
+ * @param samples Ausgegebene Samples des Jobs.
+ * @return RS_JOB_OK, RS_JOB_FAILED, RS_JOB_INVALID oder RS_JOB_SKIPPED.
+ */
+int rs_job_run_line(char* line, unsigned long number, const rs_job* defaults,
+                    rs_job* job, char** args, rs_sink* shared, int stream,
+                    rs_job_buffers* buffers, uint64_t* samples);
+
+/**
+ * @brief Leitet den Startwert für Job Nummer number aus einem Basis-Startwert ab.
+ * * Batch und Server nutzen dieselbe Ableitung, das Ergebnis hängt damit nur von
+ * --seed und der Job-Nummer ab, nicht von der Thread-Anzahl.
+ */
+unsigned int rs_job_seed(unsigned int base, unsigned long number);
+
+/**
+ * @brief Gibt die Ergebniszeile eines Jobs auf stderr aus.
+ * * Format: "JOB <n> OK <MODULATOR> <Samples> Samples <ms> ms [-> DATEI]"
+ * bzw. "JOB <n> FEHLER <ungültig|fehlgeschlagen>".
+ */
+void rs_job_report(unsigned long number, const rs_job* job, int result, uint64_t samples, double ms);
+
+/**
+ * @brief Kurzbeschreibung eines Ergebnisses ("ok", "ungültig", "fehlgeschlagen").
+ */
+const char* rs_job_result_text(int result);
+
+/**
+ * @brief Gibt die wiederverwendeten Puffer frei.
+ */
+void rs_job_buffers_free(rs_job_buffers* buffers);
+
+#endif // JOB_H
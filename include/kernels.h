@@ -0,0 +1,91 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- SAMPLE-KERNELS ---
+// Innere Schleifen der Signalerzeugung als Funktionstabelle. Neben der skalaren
+// Referenz gibt es SSE2/AVX2-Varianten (x86-64) und NEON (ARM). Die Variante wird
+// beim Start einmalig anhand der CPU gewählt (rs_kernels_init) und kann über die
+// Umgebungsvariable RS_KERNELS (scalar, sse2, avx2, neon) erzwungen werden.
+// Alle Varianten liefern bit-identische Ergebnisse zur skalaren Referenz.
+
+typedef struct {
+    const char* name;
+
+    /**
+     * @brief Sinus-Block aus der NCO-Tabelle; *phase wird um count * inc weitergeschaltet.
+     */
+    void (*sine)(uint32_t* phase, uint32_t inc, int interpolate, int16_t* out, size_t count);
+
+    /**
+     * @brief Zwei Töne mischen: out = (a + b) / 2 (Ganzzahldivision wie in C).
+     */
+    void (*mix_avg)(int16_t* out, const int16_t* a, const int16_t* b, size_t count);
+
+    /**
+     * @brief Zwei Signale addieren mit Sättigung auf den int16-Bereich.
+     */
+    void (*add_sat)(int16_t* out, const int16_t* a, const int16_t* b, size_t count);
+
+    /**
+     * @brief Konstanten Wert count-mal schreiben (Rechteck-Läufe, Stille).
+     */
+    void (*fill)(int16_t* out, int16_t value, size_t count);
+
+    /**
+     * @brief float -> int16: floor(x + 0.5), gesättigt auf den int16-Bereich.
+     */
+    void (*float_to_s16)(int16_t* out, const float* in, size_t count);
+
+    /**
+     * @brief Polyphasen-FIR mit Festkomma-Koeffizienten in Q<shift> (Pulsformung,
+     * Q15-Resampler): out[i] = sat((Summe über j von in[start[i] + j] *
+     * coef[i * taps + j] + 2^(shift-1)) >> shift).
+     * * taps ist ein Vielfaches von 8, shift liegt in 1..15, die Koeffizienten in
+     * -32767..32767. Die Beträge einer Koeffizientenzeile summieren sich auf
+     * weniger als 65536, die Summe läuft damit in 32 Bit nicht über.
+     */
+    void (*fir_q15)(int16_t* out, const int16_t* in, const uint32_t* start,
+                    const int16_t* coef, size_t taps, int shift, size_t count);
+} rs_kernel_table;
+
+extern const rs_kernel_table rs_kernels_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+extern const rs_kernel_table rs_kernels_sse2;
+extern const rs_kernel_table rs_kernels_avx2;
+#endif
+#if defined(__ARM_NEON)
+extern const rs_kernel_table rs_kernels_neon;
+#endif
+
+/**
+ * @brief Wählt die beste unterstützte Variante (oder RS_KERNELS) und merkt sie sich.
+ */
+void rs_kernels_init(void);
+
+/**
+ * @brief Liefert die Variante mit dem angegebenen Namen, falls die CPU sie unterstützt.
+ * @return const rs_kernel_table* Tabelle oder NULL.
+ */
+const rs_kernel_table* rs_kernels_find(const char* name);
+
+// Aktive Variante (gesetzt durch rs_kernels_init)
+extern const rs_kernel_table* rs_active_kernels;
+
+/**
+ * @brief Liefert die aktive Variante; initialisiert beim ersten Aufruf.
+ * * Thread-sicher: Der Zeiger wird atomar gelesen und geschrieben. Laufen zwei
+ * Threads gleichzeitig in die Initialisierung, wählen beide dieselbe Tabelle.
+ */
+static inline const rs_kernel_table* rs_kernels(void) {
+    const rs_kernel_table* k = __atomic_load_n(&rs_active_kernels, __ATOMIC_ACQUIRE);
+    if (k == NULL) {
+        rs_kernels_init();
+        k = __atomic_load_n(&rs_active_kernels, __ATOMIC_ACQUIRE);
+    }
+    return k;
+}
+
+#endif // KERNELS_H
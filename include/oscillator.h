@@ -0,0 +1,84 @@
+#ifndef OSCILLATOR_H
+#define OSCILLATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- NCO (Numerically Controlled Oscillator) ---
+// 32-Bit-Phasenakkumulator: 2^32 entspricht einer vollen Periode (2*PI).
+// Die oberen RS_SINE_TABLE_BITS Bits adressieren die Sinustabelle, die
+// restlichen Bits dienen optional als Anteil für die lineare Interpolation.
+#define RS_SINE_TABLE_BITS 10
+#define RS_SINE_TABLE_SIZE (1u << RS_SINE_TABLE_BITS)
+#define RS_PHASE_FRAC_BITS (32 - RS_SINE_TABLE_BITS)
+
+/**
+ * @brief Zustand eines Oszillators. Alle Felder sind ganzzahlig, die Ausgabe
+ * ist daher auf jeder Plattform bit-identisch.
+ */
+typedef struct {
+    uint32_t phase;       // Aktuelle Phase (2^32 = 2*PI)
+    uint32_t phase_inc;   // Phaseninkrement pro Sample
+    int interpolate;      // 1 = lineare Interpolation zwischen Tabellenwerten
+} rs_oscillator;
+
+/**
+ * @brief Rechnet eine Frequenz in ein Phaseninkrement pro Sample um.
+ * @param frequency Die Frequenz des Tons (Hz).
+ * @param sample_rate Die Abtastrate.
+ * @return uint32_t Phaseninkrement (2^32 = eine Periode pro Sample).
+ */
+uint32_t rs_osc_increment(double frequency, uint32_t sample_rate);
+
+/**
+ * @brief Initialisiert einen Oszillator mit Phase 0.
+ */
+void rs_osc_init(rs_oscillator* osc, double frequency, uint32_t sample_rate, int interpolate);
+
+/**
+ * @brief Wechselt die Frequenz, ohne die Phase zu verändern (phasenkontinuierlich).
+ */
+void rs_osc_set_frequency(rs_oscillator* osc, double frequency, uint32_t sample_rate);
+
+// Sinustabelle mit RS_SINE_TABLE_SIZE + 1 Einträgen (Amplitude MAX_PCM_VALUE)
+extern const int16_t rs_sine_table[RS_SINE_TABLE_SIZE + 1];
+
+/**
+ * @brief Liefert das Sample für eine beliebige Phase (ohne Zustand).
+ */
+static inline int16_t rs_sine_lookup(uint32_t phase, int interpolate) {
+    uint32_t index = phase >> RS_PHASE_FRAC_BITS;
+    int32_t a = rs_sine_table[index];
+
+    if (!interpolate) {
+        return (int16_t)a;
+    }
+
+    // Lineare Interpolation mit den oberen 15 Bits des Phasenrests
+    int32_t frac = (int32_t)((phase >> (RS_PHASE_FRAC_BITS - 15)) & 0x7FFF);
+    int32_t b = rs_sine_table[index + 1];
+    return (int16_t)(a + (((b - a) * frac) >> 15));
+}
+
+/**
+ * @brief Erzeugt das nächste 16-bit PCM Sample und schaltet die Phase weiter.
+ */
+static inline int16_t rs_osc_next(rs_oscillator* osc) {
+    int16_t sample = rs_sine_lookup(osc->phase, osc->interpolate);
+    osc->phase += osc->phase_inc;
+    return sample;
+}
+
+/**
+ * @brief Erzeugt count Samples am Stück in den Puffer out.
+ */
+void rs_osc_render(rs_oscillator* osc, int16_t* out, size_t count);
+
+/**
+ * @brief Lässt die Phase um count Samples weiterlaufen, ohne Samples zu erzeugen.
+ */
+static inline void rs_osc_skip(rs_oscillator* osc, size_t count) {
+    osc->phase += (uint32_t)(osc->phase_inc * (uint64_t)count);
+}
+
+#endif // OSCILLATOR_H
@@ -0,0 +1,166 @@
+#ifndef RAWSIGNAL_H
+#define RAWSIGNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --- LIBRAWSIGNAL ---
+// Öffentliche Schnittstelle von librawsignal.a / librawsignal.so: die Encoder
+// im eigenen Prozess, ohne Pipe und ohne globalen Zustand. Alles, was eine
+// Übertragung braucht (Puffer, Resampler, Ausgabe), liegt in einem rs_context
+// des Aufrufers. Verschiedene Kontexte dürfen gleichzeitig in verschiedenen
+// Threads rendern; ein einzelner Kontext ist nicht für parallele Aufrufe gedacht.
+//
+// Ausgabe ist Mono-PCM (int16, Host-Byte-Reihenfolge) mit der Abtastrate des
+// Kontexts. Ohne Callback sammelt der Kontext jede Übertragung im Speicher
+// (rs_context_samples), mit Callback werden die Samples blockweise übergeben.
+// Anders als die Kommandozeile hängen die rs_render_*-Funktionen keine
+// zufällige End-Stille an. Wer die Samples selbst abholen will (eigene
+// Blockgröße, Mischen, Takten, vorzeitiges Ende), nimmt einen rs_generator.
+
+// Rückgabewerte der rs_render_*-Funktionen
+#define RS_OK 0
+#define RS_FAILED 1   // Kodierung, Speicher oder Callback fehlgeschlagen
+#define RS_INVALID 2  // Ungültige Parameter
+
+#define RS_NATIVE_RATE 22050 // Interne Abtastrate der Encoder
+
+typedef struct rs_context rs_context;
+
+/**
+ * @brief Nimmt einen Block Samples entgegen (Callback-Ausgabe).
+ * @return 0 zum Fortfahren; jeder andere Wert bricht die Übertragung mit RS_FAILED ab.
+ */
+typedef int (*rs_output_fn)(void* user, const int16_t* samples, size_t count);
+
+/**
+ * @brief Legt einen Kontext an.
+ * @param sampleRate Ausgabe-Abtastrate in Hz (1000-384000, 0 = RS_NATIVE_RATE).
+ * @return Der Kontext oder NULL bei ungültiger Rate bzw. Speichermangel.
+ */
+rs_context* rs_context_create(uint32_t sampleRate);
+
+/**
+ * @brief Gibt einen Kontext samt aller Puffer frei (NULL ist erlaubt).
+ */
+void rs_context_destroy(rs_context* ctx);
+
+/**
+ * @brief Leitet die Ausgabe an output um (NULL = wieder im Speicher sammeln).
+ */
+void rs_context_set_output(rs_context* ctx, rs_output_fn output, void* user);
+
+/**
+ * @brief Ergebnis der letzten Übertragung im Speichermodus.
+ * * Der Zeiger bleibt bis zum nächsten rs_render_*-Aufruf bzw. bis
+ * rs_context_destroy() gültig.
+ * @param count Erhält die Anzahl Samples.
+ */
+const int16_t* rs_context_samples(const rs_context* ctx, size_t* count);
+
+/**
+ * @brief POCSAG-Nachricht (512/1200/2400 Baud, Adresse 21 Bit, Funktion 0-3).
+ */
+int rs_render_pocsag(rs_context* ctx, uint32_t baudRate, uint32_t address,
+                     uint32_t functionCode, const char* message);
+
+/**
+ * @brief DTMF-Sequenz (0-9, *, #, A-D) mit Ton- und Pausendauer in ms.
+ */
+int rs_render_dtmf(rs_context* ctx, const char* digits, int toneMs, int pauseMs);
+
+/**
+ * @brief Morse-Nachricht mit wpm Wörtern pro Minute (1-60).
+ */
+int rs_render_morse(rs_context* ctx, const char* message, uint32_t wpm);
+
+/**
+ * @brief AX.25-UI-Frame als AFSK1200 (Bell 202).
+ */
+int rs_render_afsk1200(rs_context* ctx, const char* txCall, const char* destCall, const char* message);
+
+/**
+ * @brief AX.25-UI-Frame als FSK9600 (G3RUH-Basisband, experimentell).
+ */
+int rs_render_fsk9600(rs_context* ctx, const char* txCall, const char* destCall, const char* message);
+
+/**
+ * @brief Rohe Bytes als UFSK1200 (experimentell).
+ */
+int rs_render_ufsk1200(rs_context* ctx, const char* message);
+
+// --- GENERATOREN (PULL-SCHNITTSTELLE) ---
+// Ein Generator liefert eine Übertragung auf Abruf: rs_generator_render() gibt
+// jeweils die nächsten count Samples in den Puffer des Aufrufers. Blockgröße,
+// Takt und Abbruch bestimmt der Aufrufer; intern rückt der Encoder nur so weit
+// vor, wie Samples angefordert werden (einige Tausend Samples je Schritt), die
+// Übertragung liegt nie vollständig im Speicher. Die Samples sind bit-identisch
+// zu rs_render_* mit derselben Abtastrate. Parameter werden beim Anlegen
+// kopiert. Ein Generator gehört einem Thread; verschiedene Generatoren dürfen
+// parallel rendern.
+
+typedef struct rs_generator rs_generator;
+
+/**
+ * @brief Generator für eine POCSAG-Nachricht (Parameter wie rs_render_pocsag).
+ * @param sampleRate Ausgabe-Abtastrate in Hz (1000-384000, 0 = RS_NATIVE_RATE).
+ * @return Der Generator oder NULL bei ungültigen Parametern (Meldung auf stderr)
+ * bzw. Speichermangel. Gilt ebenso für alle rs_generator_create_*.
+ */
+rs_generator* rs_generator_create_pocsag(uint32_t sampleRate, uint32_t baudRate, uint32_t address,
+                                         uint32_t functionCode, const char* message);
+
+/**
+ * @brief Generator für eine DTMF-Sequenz (Parameter wie rs_render_dtmf).
+ */
+rs_generator* rs_generator_create_dtmf(uint32_t sampleRate, const char* digits, int toneMs, int pauseMs);
+
+/**
+ * @brief Generator für eine Morse-Nachricht (Parameter wie rs_render_morse).
+ */
+rs_generator* rs_generator_create_morse(uint32_t sampleRate, const char* message, uint32_t wpm);
+
+/**
+ * @brief Generator für einen AX.25-UI-Frame als AFSK1200 (Parameter wie rs_render_afsk1200).
+ */
+rs_generator* rs_generator_create_afsk1200(uint32_t sampleRate, const char* txCall,
+                                           const char* destCall, const char* message);
+
+/**
+ * @brief Generator für FSK9600 (Parameter wie rs_render_fsk9600).
+ */
+rs_generator* rs_generator_create_fsk9600(uint32_t sampleRate, const char* txCall,
+                                          const char* destCall, const char* message);
+
+/**
+ * @brief Generator für UFSK1200 (Parameter wie rs_render_ufsk1200).
+ */
+rs_generator* rs_generator_create_ufsk1200(uint32_t sampleRate, const char* message);
+
+/**
+ * @brief Schreibt die nächsten (höchstens count) Samples der Übertragung nach out.
+ * @return Anzahl geschriebener Samples; weniger als count nur am Ende der
+ * Übertragung (oder nach einem Fehler), danach 0.
+ */
+size_t rs_generator_render(rs_generator* gen, int16_t* out, size_t count);
+
+/**
+ * @brief Zustand eines Generators: RS_OK oder RS_FAILED (Kodierung oder Speicher
+ * fehlgeschlagen; die Übertragung ist dann abgebrochen).
+ */
+int rs_generator_status(const rs_generator* gen);
+
+/**
+ * @brief Gibt einen Generator frei, auch vor dem Ende der Übertragung (NULL ist erlaubt).
+ */
+void rs_generator_destroy(rs_generator* gen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RAWSIGNAL_H
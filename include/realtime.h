@@ -0,0 +1,73 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "sink.h"
+
+// --- ECHTZEIT-AUSGABE (--realtime) ---
+// Ein Erzeuger-Thread rendert vorab in einen lock-freien SPSC-Ring, der
+// aufrufende Thread gibt daraus im Takt der Ausgaberate Blöcke frei
+// (clock_nanosleep auf absolute CLOCK_MONOTONIC-Termine). Nachgeschaltete
+// Geräte (SDR, Soundkarte) bekommen die Samples so gleichmäßig, wie sie sie
+// verbrauchen; die Latenz bis zum ersten Block ist durch den Vorlauf begrenzt.
+#define RS_REALTIME_BLOCK_MS 10      // Freigabe-Intervall
+#define RS_REALTIME_BUFFER_MS 2000   // Ringgröße (Vorsprung des Erzeugers)
+#define RS_REALTIME_PREFILL_MS 100   // Vorlauf vor dem ersten Block
+
+/**
+ * @brief Erzeuger: rendert die ganze Ausgabe in sink (läuft im eigenen Thread).
+ * * Der Sink wird danach von rs_realtime_run geschlossen.
+ * @return int Ergebnis, das rs_realtime_run zurückgibt.
+ */
+typedef int (*rs_realtime_producer)(void* user, rs_sink* sink);
+
+typedef struct {
+    uint32_t rate;           // Ausgaberate (Samples/s), bestimmt den Takt
+    rs_byte_order order;     // Byte-Reihenfolge der Ausgabe
+    uint32_t blockMs;        // Freigabe-Intervall
+    uint32_t bufferMs;       // Ringgröße (mindestens zwei Sink-Blöcke)
+    uint32_t prefillMs;      // Vorlauf vor dem ersten Block
+    int lockMemory;          // 1 = mlockall (--mlock)
+} rs_realtime_options;
+
+typedef struct {
+    uint64_t blocks;         // Freigegebene Blöcke
+    uint64_t samples;        // Ausgegebene Samples (inkl. eingefügter Stille)
+    uint64_t underruns;      // Blöcke, für die der Ring nicht genug Samples hatte
+    uint64_t silence;        // Dabei eingefügte Stille (Samples)
+    uint64_t latencyNs;      // Start bis zur Freigabe des ersten Blocks
+    uint64_t maxJitterNs;    // Größte Verspätung gegenüber dem Termin
+    uint64_t sumJitterNs;    // Summe der Verspätungen (für den Mittelwert)
+    size_t capacity;         // Ringgröße in Samples
+    size_t minFill;          // Füllstand (Samples) bei der Freigabe, solange der
+    size_t maxFill;          // Erzeuger läuft: kleinster, größter
+    uint64_t sumFill;        // und Summe
+    uint64_t fillBlocks;     // über so viele Blöcke (für den Mittelwert)
+    int fifo;                // 1 = Freigabe lief mit SCHED_FIFO
+    int locked;              // 1 = mlockall war erfolgreich
+} rs_realtime_stats;
+
+/**
+ * @brief Setzt die Standardwerte (RS_REALTIME_*) für rate und order.
+ */
+void rs_realtime_defaults(rs_realtime_options* options, uint32_t rate, rs_byte_order order);
+
+/**
+ * @brief Rendert per producer in einen Ring und gibt ihn getaktet an out aus.
+ * * Fehlen zum Termin Samples (Erzeuger zu langsam), wird der Block mit Stille
+ * aufgefüllt und als Unterlauf gezählt; ohne Unterlauf ist die Ausgabe
+ * byte-identisch zur ungetakteten. SCHED_FIFO wird versucht und bei fehlender
+ * Berechtigung still ausgelassen. out wird nicht geschlossen.
+ * @return int Ergebnis des Erzeugers, 1 bei Fehlern der Echtzeit-Ausgabe.
+ */
+int rs_realtime_run(rs_sink* out, const rs_realtime_options* options, rs_realtime_producer producer,
+                    void* user, rs_realtime_stats* stats);
+
+/**
+ * @brief Gibt die Statistik als "Info:"-Zeilen auf stderr aus.
+ */
+void rs_realtime_report(const rs_realtime_stats* stats, uint32_t rate);
+
+#endif // REALTIME_H
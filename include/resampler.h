@@ -0,0 +1,106 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- Rationaler Polyphasen-Resampler ---
+// Umrechnung inRate -> outRate mit L/M = outRate/inRate (gekürzt).
+// Das Tiefpassfilter (Kaiser-gefenstertes Sinc) wird einmalig beim Anlegen
+// berechnet und als Filterbank mit L Phasen abgelegt.
+#define RS_RESAMPLER_ZERO_CROSSINGS 16  // Nulldurchgänge des Sinc je Seite
+#define RS_RESAMPLER_KAISER_BETA 8.0    // ca. 80 dB Sperrdämpfung
+#define RS_RESAMPLER_PASSBAND 0.90      // Grenzfrequenz relativ zur halben Zielrate
+#define RS_RESAMPLER_CHUNK 1024         // Interne Blockgröße (Eingangs-Samples)
+#define RS_RESAMPLER_BLOCK 256          // Ausgangs-Samples je Kernel-Aufruf
+
+/**
+ * @brief Rechenweg der Filterung.
+ * * RS_RESAMPLER_FLOAT rechnet das Skalarprodukt in float, RS_RESAMPLER_Q15 mit
+ * Festkomma-Koeffizienten und 32-Bit-Ganzzahlen über den fir_q15-Kernel (ohne
+ * FPU, bit-identisch auf allen Plattformen). Die Koeffizienten liegen in Q15,
+ * bei Filtern mit großer Betragssumme in Q14 (Überlaufschutz des Kernels). Die
+ * Abweichung zwischen beiden Wegen beträgt höchstens RS_RESAMPLER_Q15_BOUND LSB.
+ */
+typedef enum {
+    RS_RESAMPLER_FLOAT,
+    RS_RESAMPLER_Q15
+} rs_resampler_arith;
+
+#define RS_RESAMPLER_Q15_BOUND(rs) (((rs)->tapsPerPhase << 14 >> (rs)->fracBits) + 1)
+
+// Standard für rs_resampler_create(): mit FIXED_POINT=1 (RS_FIXED_POINT) Q15
+#ifdef RS_FIXED_POINT
+#define RS_RESAMPLER_DEFAULT_ARITH RS_RESAMPLER_Q15
+#else
+#define RS_RESAMPLER_DEFAULT_ARITH RS_RESAMPLER_FLOAT
+#endif
+
+/**
+ * @brief Zustand eines Resamplers (Filterbank + Verlauf der Eingangs-Samples).
+ */
+typedef struct {
+    uint32_t inRate;
+    uint32_t outRate;
+    uint32_t upFactor;       // L
+    uint32_t downFactor;     // M
+    uint32_t tapsPerPhase;   // K
+    rs_resampler_arith arith;
+    float* bank;             // L * K Koeffizienten, je Phase in Faltungsreihenfolge
+    float* history;          // (K - 1) + RS_RESAMPLER_CHUNK Eingangs-Samples
+    uint32_t tapsQ15;        // K auf ein Vielfaches von 8 aufgerundet (Nullen am Ende)
+    int fracBits;            // Q-Format der Festkomma-Koeffizienten (15 oder 14)
+    int16_t* bankQ15;        // Q15-Zeilen in Ausgabereihenfolge (siehe slot)
+    int16_t* historyQ15;     // wie history, plus tapsQ15 - K Samples Überhang
+    uint32_t slot;           // Zeile in bankQ15 für das nächste Ausgangs-Sample
+    size_t historyFill;      // Gültige Samples in history
+    uint32_t phase;          // Aktuelle Filterphase (0 .. L-1)
+    size_t inputPos;         // Index des nächsten benötigten Eingangs-Samples in history
+    uint64_t totalIn;        // Bisher übergebene Eingangs-Samples
+    uint64_t totalOut;       // Bisher erzeugte Ausgangs-Samples
+} rs_resampler;
+
+/**
+ * @brief Legt einen Resampler an und berechnet die Filterbank.
+ * @return rs_resampler* Zeiger auf den Resampler oder NULL bei Fehler.
+ */
+rs_resampler* rs_resampler_create(uint32_t inRate, uint32_t outRate);
+
+/**
+ * @brief Wie rs_resampler_create(), aber mit festem Rechenweg (z.B. für Vergleiche).
+ */
+rs_resampler* rs_resampler_create_arith(uint32_t inRate, uint32_t outRate, rs_resampler_arith arith);
+
+/**
+ * @brief Setzt den Stream-Zustand zurück (neuer Stream), die Filterbank bleibt erhalten.
+ */
+void rs_resampler_reset(rs_resampler* rs);
+
+/**
+ * @brief Gibt den Resampler und seine Filterbank frei.
+ */
+void rs_resampler_free(rs_resampler* rs);
+
+/**
+ * @brief Obere Schranke für die Anzahl Ausgangs-Samples bei inCount Eingangs-Samples.
+ */
+size_t rs_resampler_max_output(const rs_resampler* rs, size_t inCount);
+
+/**
+ * @brief Verarbeitet einen Block Eingangs-Samples (Streaming).
+ * * Alle Eingangs-Samples werden übernommen; out muss mindestens
+ * rs_resampler_max_output(rs, inCount) Samples fassen.
+ * @return size_t Anzahl geschriebener Ausgangs-Samples.
+ */
+size_t rs_resampler_process(rs_resampler* rs, const int16_t* in, size_t inCount, int16_t* out);
+
+/**
+ * @brief Schiebt den Filter-Nachlauf aus (Ende des Streams).
+ * * Nach dem Aufruf entspricht die Gesamtzahl der Ausgangs-Samples
+ * round(totalIn * outRate / inRate). out muss
+ * rs_resampler_max_output(rs, RS_RESAMPLER_CHUNK) Samples fassen.
+ * @return size_t Anzahl geschriebener Ausgangs-Samples.
+ */
+size_t rs_resampler_flush(rs_resampler* rs, int16_t* out);
+
+#endif // RESAMPLER_H
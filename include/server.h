@@ -0,0 +1,37 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "job.h"
+
+// --- GENERATOR-DIENST ---
+// rawsignal_tx --serve PFAD lauscht auf einem UNIX-Domain-Socket. Protokoll
+// (zeilenbasiert, beliebig viele Anfragen je Verbindung, nacheinander):
+//
+//   Anfrage:  eine Jobzeile wie im Batch-Modus, abgeschlossen mit '\n'
+//             z.B. "POCSAG 1200 1234567:3:'HALLO WELT'\n"
+//   Antwort:  "OK <BYTES>\n", gefolgt von genau BYTES Bytes PCM
+//             (BYTES = 0, wenn der Job per -o in eine Datei schreibt)
+//             oder "ERR <ungültig|fehlgeschlagen>\n"
+//
+// Ein epoll-Loop bedient alle Verbindungen in einem Thread; Puffer, Speicher-
+// Sinks und Resampler-Filterbänke bleiben zwischen Anfragen erhalten.
+#define RS_SERVE_MAX_CLIENTS 1024
+#define RS_SERVE_MAX_REQUEST (64 * 1024) // Maximale Länge einer Anfragezeile
+
+/**
+ * @brief Startet den Dienst auf dem Socket path (bis SIGINT/SIGTERM).
+ * * Eine veraltete Socket-Datei unter path wird ersetzt. defaults liefert die
+ * Standardoptionen und den Basis-Startwert für die Zufalls-Stille.
+ * @return 0 bei regulärem Ende, 1 bei Fehler.
+ */
+int rs_serve(const char* path, const rs_job* defaults);
+
+/**
+ * @brief Kleiner Client: sendet Jobs an einen laufenden Dienst und schreibt das PCM nach stdout.
+ * * Mit argc > 0 bilden argv die eine Jobzeile, sonst wird je Zeile von stdin
+ * ein Job gesendet.
+ * @return 0, wenn alle Jobs erfolgreich waren, sonst 1.
+ */
+int rs_client_run(const char* path, int argc, char** argv);
+
+#endif // SERVER_H
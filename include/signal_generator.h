@@ -9,6 +9,7 @@
 #define SAMPLE_RATE 22050 
 #define SYMRATE 38400
 #define MAX_PCM_VALUE 32767 // Amplitude (Signed 16-bit)
+#define PCM_BLOCK_SAMPLES 4096 // Blockgröße für die Streaming-Ausgabe
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -22,6 +23,37 @@ size_t pcmTransmissionLength(
         uint32_t baudRate,
         size_t transmissionLength);
 
+/**
+ * @brief Zustand des Streaming-Renderers für POCSAG-Codewörter.
+ * Der Speicherbedarf ist unabhängig von der Länge der Übertragung.
+ */
+typedef struct {
+    const uint32_t* transmission; // Codewörter (MSB zuerst gesendet)
+    size_t totalBits;             // Anzahl Bits der Übertragung
+    size_t totalSamples;          // Anzahl Ausgabe-Samples (pcmTransmissionLength)
+    size_t sampleIndex;           // Bereits erzeugte Samples
+    size_t bitIndex;              // Aktuelles Bit
+    uint64_t clock;               // Gebrochener Bit-Takt (Position im aktuellen Bit)
+    uint64_t clockStep;           // Fortschritt pro Ausgabe-Sample
+    uint64_t clockPeriod;         // Länge eines Bits
+} pcmStream;
+
+/**
+ * @brief Initialisiert den Streaming-Renderer für eine POCSAG-Übertragung.
+ */
+void pcmStreamInit(
+        pcmStream* stream,
+        uint32_t sampleRate,
+        uint32_t baudRate,
+        const uint32_t* transmission,
+        size_t transmissionLength);
+
+/**
+ * @brief Erzeugt die nächsten (höchstens maxSamples) PCM-Samples der Übertragung.
+ * @return size_t Anzahl geschriebener Samples (0 = Übertragung vollständig).
+ */
+size_t pcmStreamRender(pcmStream* stream, int16_t* out, size_t maxSamples);
+
 /**
  * @brief Kodiert die 32-Bit-Wörter in ein rohes PCM-Audiosignal (Signed 16-bit, Little Endian).
  */
@@ -32,15 +64,15 @@ void pcmEncodeTransmission(
         size_t transmissionLength,
         int16_t* out); // KORREKT: int16_t*
 
-// NEUE HILFSFUNKTION FÜR SINUSWELLEN-GENERIERUNG
 /**
- * @brief Generiert ein 16-bit PCM Sample bei einer bestimmten Frequenz und Zeit.
- * * @param frequency Die Frequenz des Tons (Hz).
- * @param time_index Das aktuelle Sample-Index (0, 1, 2, ...).
- * @param sample_rate Die Abtastrate.
- * @return int16_t Das generierte PCM-Sample.
+ * @brief Übernimmt die vorab gerenderte POCSAG-Präambel (PREAMBLE_LENGTH Bits 1010...).
+ * * Die Präambel-Samples hängen nur von der Baudrate ab und werden einmal je
+ * Prozess gerendert. Beginnt die Übertragung des (frisch initialisierten)
+ * Streams mit der Präambel, liefert die Funktion deren Samples und setzt den
+ * Stream direkt dahinter; pcmStreamRender() setzt dort bit-identisch fort.
+ * @param count Erhält die Anzahl der Präambel-Samples.
+ * @return Die Samples oder NULL (Stream unverändert), wenn nichts vorliegt.
  */
-int16_t rs_generate_tone_sample(double frequency, size_t time_index, uint32_t sample_rate);
-
+const int16_t* pcmStreamSkipPreamble(pcmStream* stream, uint32_t sampleRate, uint32_t baudRate, size_t* count);
 
 #endif // SIGNAL_GENERATOR_H
\ No newline at end of file
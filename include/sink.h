@@ -0,0 +1,162 @@
+#ifndef SINK_H
+#define SINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "resampler.h"
+
+// --- AUSGABE-SINK ---
+// Alle Encoder schreiben ihre Samples über einen rs_sink. Der Sink sammelt die
+// Daten in einem großen, ausgerichteten Blockpuffer und schreibt ihn erst bei
+// vollem Puffer oder an expliziten Flush-Punkten mit write(2) aus. Kurze Writes
+// und EINTR werden wiederholt, EPIPE und andere Fehler werden gemeldet.
+#define RS_SINK_BUFFER_BYTES (64 * 1024)
+#define RS_SINK_ALIGNMENT 64
+
+// Datei-Sinks: Speicher wird per fallocate in Blöcken vorab reserviert, lange
+// Null-Folgen werden als Löcher (lseek) übersprungen statt geschrieben.
+#define RS_SINK_PREALLOC_BYTES (1024 * 1024)
+#define RS_SINK_HOLE_MIN_SAMPLES 8192 // Ab dieser Länge wird Stille zum Loch
+#define RS_WAV_HEADER_BYTES 44
+
+typedef enum {
+    RS_BYTE_ORDER_LE = 0, // S16_LE (Standard)
+    RS_BYTE_ORDER_BE = 1  // S16_BE
+} rs_byte_order;
+
+// Byte-Reihenfolge der Maschine (Samples werden dann unverändert kopiert)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define RS_BYTE_ORDER_HOST RS_BYTE_ORDER_BE
+#else
+#define RS_BYTE_ORDER_HOST RS_BYTE_ORDER_LE
+#endif
+
+/**
+ * @brief Ziel eines Callback-Sinks: erhält jeden ausgeschriebenen Block.
+ * @return 0 bei Erfolg, sonst ein Fehlercode (wird zu sink->error).
+ */
+typedef int (*rs_sink_callback)(void* user, const uint8_t* data, size_t len);
+
+typedef struct {
+    int fd;                   // Ziel-Dateideskriptor
+    rs_byte_order order;      // Byte-Reihenfolge der Ausgabe
+    uint8_t* buffer;          // Blockpuffer (RS_SINK_ALIGNMENT-ausgerichtet)
+    size_t fill;              // Belegte Bytes im Puffer
+    int error;                // errno des ersten Fehlers (0 = ok)
+    rs_resampler* resampler;  // Optional: Umrechnung auf die Ausgaberate
+    int16_t* resampled;       // Zwischenpuffer für den Resampler
+    uint64_t samplesWritten;  // Ausgegebene Samples (nach dem Resampler)
+    uint32_t rate;            // Ausgabe-Abtastrate (für den WAV-Header)
+
+    // Nur für Datei-Sinks (rs_sink_open_file)
+    int isFile;               // 1 = Ziel, das der Sink selbst geöffnet hat (schließt es)
+    int regular;              // 1 = reguläre Datei (Löcher, fallocate, Länge beim Schließen)
+    int wav;                  // 1 = WAV-Container, Header wird beim Schließen gepatcht
+    int sparse;               // 1 = Stille als Löcher überspringen
+    int preallocate;          // 1 = fallocate verfügbar (0 nach erstem Fehlschlag)
+    size_t zeroRun;           // Noch nicht geschriebene Null-Samples am Pufferende
+    uint64_t offset;          // Aktuelle Schreibposition in der Datei
+    uint64_t reserved;        // Bis hierhin per fallocate reserviert
+
+    // Nur für Speicher-Sinks (rs_sink_init_memory)
+    uint8_t* memory;          // Gesammelte Ausgabe (wächst bei Bedarf)
+    size_t memoryFill;        // Belegte Bytes
+    size_t memoryCapacity;    // Reservierte Bytes
+
+    // Nur für Callback-Sinks (rs_sink_init_callback)
+    rs_sink_callback callback;
+    void* callbackUser;
+} rs_sink;
+
+/**
+ * @brief Initialisiert einen Sink auf einen offenen Dateideskriptor.
+ * @return 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_sink_init_fd(rs_sink* sink, int fd, rs_byte_order order);
+
+/**
+ * @brief Initialisiert einen Sink, der die Ausgabe im Speicher sammelt.
+ * * Das Ergebnis liegt nach rs_sink_flush() in sink->memory (memoryFill Bytes).
+ * Mit rs_sink_reset_memory() lässt sich der Sink für den nächsten Job leeren,
+ * ohne die Puffer freizugeben.
+ * @return 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_sink_init_memory(rs_sink* sink, rs_byte_order order);
+
+/**
+ * @brief Initialisiert einen Sink, der jeden vollen Block an callback übergibt.
+ * * Blöcke sind RS_SINK_ALIGNMENT-ausgerichtet und enthalten ganze Samples.
+ * @return 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_sink_init_callback(rs_sink* sink, rs_byte_order order, rs_sink_callback callback, void* user);
+
+/**
+ * @brief Leert einen Speicher-Sink (Puffer bleiben reserviert).
+ */
+void rs_sink_reset_memory(rs_sink* sink);
+
+/**
+ * @brief Öffnet eine Datei als Ziel (angelegt bzw. abgeschnitten).
+ * * Endet der Pfad auf ".wav", wird ein WAV-Header (PCM, mono, 16 Bit) geschrieben,
+ * dessen Längenfelder rs_sink_close() nachträgt. Stille wird als Loch
+ * übersprungen (sparse), Speicher vorab per fallocate reserviert.
+ * Geräte und FIFOs (/dev/null, /dev/stdout in eine Pipe) werden weder
+ * abgeschnitten noch gekürzt; Stille wird dort geschrieben, der WAV-Header trägt
+ * die größtmögliche Länge (wie bei Streams üblich).
+ * @param sampleRate Abtastrate für den WAV-Header (rs_sink_set_rate passt sie an).
+ * @return 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_sink_open_file(rs_sink* sink, const char* path, rs_byte_order order, uint32_t sampleRate);
+
+/**
+ * @brief Reserviert Platz für die nächsten count Samples (nur Datei-Sinks, Hinweis).
+ */
+void rs_sink_reserve(rs_sink* sink, size_t count);
+
+/**
+ * @brief Schaltet einen Resampler vor die Ausgabe (inRate -> outRate).
+ * @return 0 bei Erfolg, 1 bei Fehler.
+ */
+int rs_sink_set_rate(rs_sink* sink, uint32_t inRate, uint32_t outRate);
+
+/**
+ * @brief Übernimmt count Samples (Host-Byte-Reihenfolge) in den Puffer.
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_write(rs_sink* sink, const int16_t* samples, size_t count);
+
+/**
+ * @brief Übernimmt bereits fertig kodierte Bytes unverändert (z.B. aus einem Speicher-Sink).
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_write_bytes(rs_sink* sink, const uint8_t* data, size_t len);
+
+/**
+ * @brief Schreibt count Samples Stille.
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_write_silence(rs_sink* sink, size_t count);
+
+/**
+ * @brief Expliziter Flush-Punkt: schreibt den Puffer vollständig aus.
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_flush(rs_sink* sink);
+
+/**
+ * @brief Beendet einen Abschnitt: Resampler-Nachlauf ausschieben, Resampler
+ * zurücksetzen und flushen. Der Sink bleibt für weitere Abschnitte offen.
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_end_segment(rs_sink* sink);
+
+/**
+ * @brief Schiebt den Resampler-Nachlauf aus, flusht und gibt die Puffer frei.
+ * * Bei Datei-Sinks wird die Dateilänge gesetzt, der WAV-Header gepatcht und die
+ * Datei geschlossen; ein per rs_sink_init_fd übergebener Deskriptor bleibt offen.
+ * @return 0 bei Erfolg, 1 wenn die Ausgabe fehlgeschlagen ist.
+ */
+int rs_sink_close(rs_sink* sink);
+
+#endif // SINK_H
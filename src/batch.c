@@ -0,0 +1,322 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "../include/batch.h"
+#include "../include/kernels.h"
+
+static double elapsed_ms(const struct timespec* start) {
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return (end.tv_sec - start->tv_sec) * 1e3 + (end.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/**
+ * @brief Sequentieller Batch: alle Jobs im Hauptthread, direkt in out.
+ */
+static int run_sequential(FILE* input, const rs_job* defaults, rs_sink* out) {
+  rs_job_buffers buffers = { 0 };
+  char* line = NULL;
+  size_t lineCapacity = 0;
+  unsigned long lineNumber = 0;
+  unsigned long failed = 0;
+
+  while (getline(&line, &lineCapacity, input) >= 0) {
+    lineNumber++;
+
+    char* args[RS_JOB_MAX_ARGS];
+    rs_job job;
+    uint64_t samples;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int result = rs_job_run_line(line, lineNumber, defaults, &job, args, out, 1, &buffers, &samples);
+    if (result == RS_JOB_SKIPPED) {
+      continue;
+    }
+    if (result != RS_JOB_OK) {
+      failed++;
+    }
+    rs_job_report(lineNumber, &job, result, samples, elapsed_ms(&start));
+
+    // Ein kaputter gemeinsamer Sink (z.B. EPIPE) macht alle weiteren Jobs sinnlos
+    if (out->error != 0) {
+      break;
+    }
+  }
+
+  free(line);
+  rs_job_buffers_free(&buffers);
+  return (failed == 0 && out->error == 0) ? 0 : 1;
+}
+
+// --- WORKER-POOL ---
+// Die Jobs laufen durch einen Ring aus Slots (Index = Zeilenfolge % Anzahl).
+// Der Hauptthread liest Zeilen in freie Slots, die Worker arbeiten sie in
+// Reihenfolge ab und rendern gemeinsame Ausgabe in den Speicher-Sink des Slots.
+// Im geordneten Modus gibt der Hauptthread die fertigen Slots in Eingabe-
+// reihenfolge aus, sonst tut das der Worker sofort nach dem Rendern.
+
+typedef enum {
+  SLOT_FREE = 0,
+  SLOT_READY,    // Zeile gelesen, wartet auf einen Worker
+  SLOT_RUNNING,
+  SLOT_DONE      // Gerendert, wartet auf Ausgabe (nur geordneter Modus)
+} slot_state;
+
+typedef struct {
+  slot_state state;
+  unsigned long lineNumber;
+  char* line;
+  size_t lineCapacity;
+  char* args[RS_JOB_MAX_ARGS];
+  rs_job job;
+  int result;
+  uint64_t samples;
+  double ms;
+  rs_sink memory;     // Gemeinsame Ausgabe dieses Jobs
+} batch_slot;
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t workAvailable;  // Neuer Slot READY oder Eingabe beendet
+  pthread_cond_t slotChanged;    // Slot DONE oder FREE geworden
+  pthread_mutex_t outputLock;    // Ungeordneter Modus: ein Job am Stück
+
+  batch_slot* slots;
+  size_t slotCount;
+  unsigned long submitted;       // Gelesene Jobs
+  unsigned long started;         // Von Workern übernommene Jobs
+  unsigned long emitted;         // Ausgegebene (freigegebene) Jobs
+  int inputDone;
+  int ordered;
+
+  const rs_job* defaults;
+  rs_sink* out;
+  unsigned long failed;          // Nur unter outputLock bzw. im Hauptthread
+} batch_pool;
+
+typedef struct {
+  batch_pool* pool;
+  pthread_t thread;
+  rs_job_buffers buffers;
+} batch_worker;
+
+/**
+ * @brief Gibt einen gerenderten Slot aus (gemeinsame Ausgabe und Ergebniszeile).
+ */
+static void emit_slot(batch_pool* pool, batch_slot* slot) {
+  if (slot->result == RS_JOB_SKIPPED) {
+    return;
+  }
+
+  if (slot->result == RS_JOB_OK && slot->job.outputPath == NULL) {
+    rs_sink_write_bytes(pool->out, slot->memory.memory, slot->memory.memoryFill);
+    if (pool->out->error != 0) {
+      slot->result = RS_JOB_FAILED;
+    }
+  }
+  if (slot->result != RS_JOB_OK) {
+    pool->failed++;
+  }
+  rs_job_report(slot->lineNumber, &slot->job, slot->result, slot->samples, slot->ms);
+}
+
+static void* worker_main(void* arg) {
+  batch_worker* worker = (batch_worker*) arg;
+  batch_pool* pool = worker->pool;
+
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->started == pool->submitted && !pool->inputDone) {
+      pthread_cond_wait(&pool->workAvailable, &pool->lock);
+    }
+    if (pool->started == pool->submitted) {
+      pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+    batch_slot* slot = &pool->slots[pool->started % pool->slotCount];
+    pool->started++;
+    slot->state = SLOT_RUNNING;
+    pthread_mutex_unlock(&pool->lock);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    rs_sink_reset_memory(&slot->memory);
+    slot->result = rs_job_run_line(slot->line, slot->lineNumber, pool->defaults, &slot->job,
+                               slot->args, &slot->memory, 1, &worker->buffers, &slot->samples);
+    slot->ms = elapsed_ms(&start);
+
+    if (!pool->ordered) {
+      pthread_mutex_lock(&pool->outputLock);
+      if (pool->out->error == 0) {
+        emit_slot(pool, slot);
+      }
+      pthread_mutex_unlock(&pool->outputLock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    slot->state = pool->ordered ? SLOT_DONE : SLOT_FREE;
+    if (!pool->ordered) {
+      pool->emitted++;
+    }
+    pthread_cond_broadcast(&pool->slotChanged);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Prüft, ob die gemeinsame Ausgabe fehlgeschlagen ist (z.B. EPIPE).
+ */
+static int output_failed(batch_pool* pool) {
+  pthread_mutex_lock(&pool->outputLock);
+  int failed = pool->out->error != 0;
+  pthread_mutex_unlock(&pool->outputLock);
+  return failed;
+}
+
+/**
+ * @brief Geordneter Modus: gibt alle fertigen Slots in Eingabereihenfolge aus.
+ * * Wird mit gehaltenem pool->lock aufgerufen; das Schreiben selbst läuft ohne Lock.
+ */
+static void emit_ready(batch_pool* pool) {
+  while (pool->emitted < pool->submitted) {
+    batch_slot* slot = &pool->slots[pool->emitted % pool->slotCount];
+    if (slot->state != SLOT_DONE) {
+      break;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    if (pool->out->error == 0) {
+      emit_slot(pool, slot);
+    }
+    pthread_mutex_lock(&pool->lock);
+    slot->state = SLOT_FREE;
+    pool->emitted++;
+  }
+}
+
+/**
+ * @brief Paralleler Batch mit options->threads Workern.
+ */
+static int run_pool(FILE* input, const rs_job* defaults, rs_sink* out, const rs_batch_options* options) {
+  batch_pool pool;
+  memset(&pool, 0, sizeof(pool));
+  pool.slotCount = (size_t)options->threads * RS_BATCH_SLOTS_PER_THREAD;
+  pool.ordered = options->ordered;
+  pool.defaults = defaults;
+  pool.out = out;
+
+  pool.slots = (batch_slot*) calloc(pool.slotCount, sizeof(batch_slot));
+  batch_worker* workers = (batch_worker*) calloc(options->threads, sizeof(batch_worker));
+  if (pool.slots == NULL || workers == NULL) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für den Worker-Pool fehlgeschlagen.\n");
+    free(pool.slots);
+    free(workers);
+    return 1;
+  }
+
+  int result = 0;
+  size_t initialized = 0;
+  for (; initialized < pool.slotCount; initialized++) {
+    if (rs_sink_init_memory(&pool.slots[initialized].memory, defaults->order) != 0) {
+      result = 1;
+      break;
+    }
+  }
+
+  pthread_mutex_init(&pool.lock, NULL);
+  pthread_mutex_init(&pool.outputLock, NULL);
+  pthread_cond_init(&pool.workAvailable, NULL);
+  pthread_cond_init(&pool.slotChanged, NULL);
+
+  // Kernel-Auswahl vor dem Start der Worker, nicht erst im ersten Job
+  rs_kernels();
+
+  unsigned int running = 0;
+  for (; result == 0 && running < options->threads; running++) {
+    workers[running].pool = &pool;
+    if (pthread_create(&workers[running].thread, NULL, worker_main, &workers[running]) != 0) {
+      fprintf(stderr, "Fehler: Worker-Thread konnte nicht gestartet werden.\n");
+      result = 1;
+      break;
+    }
+  }
+
+  unsigned long lineNumber = 0;
+  while (result == 0) {
+    pthread_mutex_lock(&pool.lock);
+    batch_slot* slot = &pool.slots[pool.submitted % pool.slotCount];
+    for (;;) {
+      if (pool.ordered) {
+        emit_ready(&pool);
+      }
+      if (slot->state == SLOT_FREE) {
+        break;
+      }
+      pthread_cond_wait(&pool.slotChanged, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    // Der freie Slot gehört bis zur Übergabe allein dem Hauptthread
+    if (output_failed(&pool) || getline(&slot->line, &slot->lineCapacity, input) < 0) {
+      break;
+    }
+    slot->lineNumber = ++lineNumber;
+
+    pthread_mutex_lock(&pool.lock);
+    slot->state = SLOT_READY;
+    pool.submitted++;
+    pthread_cond_signal(&pool.workAvailable);
+    pthread_mutex_unlock(&pool.lock);
+  }
+
+  // Eingabe beendet: Worker auslaufen lassen, restliche Slots ausgeben
+  pthread_mutex_lock(&pool.lock);
+  pool.inputDone = 1;
+  pthread_cond_broadcast(&pool.workAvailable);
+  while (pool.emitted < pool.submitted) {
+    if (pool.ordered) {
+      emit_ready(&pool);
+      if (pool.emitted == pool.submitted) {
+        break;
+      }
+    }
+    pthread_cond_wait(&pool.slotChanged, &pool.lock);
+  }
+  pthread_mutex_unlock(&pool.lock);
+
+  for (unsigned int i = 0; i < running; i++) {
+    pthread_join(workers[i].thread, NULL);
+    rs_job_buffers_free(&workers[i].buffers);
+  }
+
+  for (size_t i = 0; i < initialized; i++) {
+    rs_sink_close(&pool.slots[i].memory);
+    free(pool.slots[i].line);
+  }
+  pthread_cond_destroy(&pool.slotChanged);
+  pthread_cond_destroy(&pool.workAvailable);
+  pthread_mutex_destroy(&pool.outputLock);
+  pthread_mutex_destroy(&pool.lock);
+  free(pool.slots);
+  free(workers);
+
+  return (result == 0 && pool.failed == 0 && out->error == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Liest Jobs aus input und rendert sie.
+ */
+int rs_batch_run(FILE* input, const rs_job* defaults, rs_sink* out, const rs_batch_options* options) {
+  if (options->threads <= 1) {
+    return run_sequential(input, defaults, out);
+  }
+  return run_pool(input, defaults, out, options);
+}
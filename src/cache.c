@@ -0,0 +1,174 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../include/cache.h"
+
+#define CACHE_HEADER_BYTES 24 // Magic + Schlüssellänge + Datenlänge
+#define CACHE_PATH_MAX 4096
+
+/**
+ * @brief FNV-1a (64 Bit) über len Bytes.
+ */
+uint64_t rs_cache_hash(const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*) data;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Position der PCM-Daten hinter Kopf und Schlüssel.
+ */
+static size_t data_offset(size_t keyLen) {
+    size_t offset = CACHE_HEADER_BYTES + keyLen;
+    return (offset + RS_CACHE_ALIGNMENT - 1) / RS_CACHE_ALIGNMENT * RS_CACHE_ALIGNMENT;
+}
+
+/**
+ * @brief Baut den Dateinamen eines Eintrags.
+ * @return 0 bei Erfolg, 1 wenn der Pfad zu lang ist.
+ */
+static int entry_path(char* path, const char* dir, const char* key, size_t keyLen) {
+    int n = snprintf(path, CACHE_PATH_MAX, "%s/%016llx.pcm", dir,
+                     (unsigned long long) rs_cache_hash(key, keyLen));
+    return (n < 0 || n >= CACHE_PATH_MAX) ? 1 : 0;
+}
+
+/**
+ * @brief Schreibt len Bytes vollständig (wiederholt bei kurzen Writes und EINTR).
+ * @return 0 bei Erfolg, sonst errno.
+ */
+static int write_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*) data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Sucht den Eintrag zum Schlüssel key.
+ */
+int rs_cache_lookup(const char* dir, const char* key, size_t keyLen, rs_cache_entry* entry) {
+    char path[CACHE_PATH_MAX];
+    memset(entry, 0, sizeof(*entry));
+    if (entry_path(path, dir, key, keyLen) != 0) {
+        return 0;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < data_offset(keyLen)) {
+        close(fd);
+        return 0;
+    }
+
+    // Die Abbildung bleibt auch nach close() gültig
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 0;
+    }
+
+    uint8_t* base = (uint8_t*) map;
+    uint64_t storedKey, storedData;
+    memcpy(&storedKey, base + 8, sizeof(storedKey));
+    memcpy(&storedData, base + 16, sizeof(storedData));
+    if (memcmp(base, RS_CACHE_MAGIC, 8) != 0 || storedKey != keyLen ||
+        memcmp(base + CACHE_HEADER_BYTES, key, keyLen) != 0 ||
+        storedData != size - data_offset(keyLen)) {
+        munmap(map, size);
+        return 0;
+    }
+
+    entry->map = base;
+    entry->mapBytes = size;
+    entry->data = base + data_offset(keyLen);
+    entry->dataBytes = (size_t)storedData;
+    return 1;
+}
+
+/**
+ * @brief Gibt einen Eintrag aus rs_cache_lookup() frei.
+ */
+void rs_cache_release(rs_cache_entry* entry) {
+    if (entry->map != NULL) {
+        munmap(entry->map, entry->mapBytes);
+    }
+    memset(entry, 0, sizeof(*entry));
+}
+
+/**
+ * @brief Legt len Bytes PCM unter dem Schlüssel key ab.
+ */
+int rs_cache_store(const char* dir, const char* key, size_t keyLen, const uint8_t* data, size_t len) {
+    char path[CACHE_PATH_MAX];
+    char tmp[CACHE_PATH_MAX];
+    if (entry_path(path, dir, key, keyLen) != 0 ||
+        snprintf(tmp, sizeof(tmp), "%s/.tmp-XXXXXX", dir) >= (int)sizeof(tmp)) {
+        return ENAMETOOLONG;
+    }
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+        return errno;
+    }
+
+    int fd = mkstemp(tmp);
+    if (fd < 0) {
+        return errno;
+    }
+    fchmod(fd, 0644); // mkstemp legt 0600 an; der Cache darf geteilt werden
+
+    uint8_t header[CACHE_HEADER_BYTES];
+    uint64_t keyBytes = keyLen;
+    uint64_t dataBytes = len;
+    memcpy(header, RS_CACHE_MAGIC, 8);
+    memcpy(header + 8, &keyBytes, sizeof(keyBytes));
+    memcpy(header + 16, &dataBytes, sizeof(dataBytes));
+
+    static const uint8_t padding[RS_CACHE_ALIGNMENT] = { 0 };
+    int error = write_all(fd, header, sizeof(header));
+    if (error == 0) {
+        error = write_all(fd, key, keyLen);
+    }
+    if (error == 0) {
+        error = write_all(fd, padding, data_offset(keyLen) - CACHE_HEADER_BYTES - keyLen);
+    }
+    if (error == 0) {
+        error = write_all(fd, data, len);
+    }
+    if (close(fd) != 0 && error == 0) {
+        error = errno;
+    }
+
+    // Erst der fertige Eintrag wird sichtbar; gleichzeitige Schreiber ersetzen sich gegenseitig
+    if (error == 0 && rename(tmp, path) != 0) {
+        error = errno;
+    }
+    if (error != 0) {
+        unlink(tmp);
+    }
+    return error;
+}
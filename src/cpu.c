@@ -0,0 +1,67 @@
+#include "../include/cpu.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+
+/**
+ * @brief Prüft per XGETBV, ob das Betriebssystem die YMM-Register sichert.
+ */
+static int os_supports_avx(void) {
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (eax & 0x6) == 0x6; // XMM- und YMM-Zustand aktiv
+}
+
+uint32_t rs_cpu_features(void) {
+    uint32_t features = 0;
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    if (edx & bit_SSE2) {
+        features |= RS_CPU_SSE2;
+    }
+    if ((ecx & bit_PCLMUL) && (ecx & bit_SSSE3)) {
+        features |= RS_CPU_PCLMUL;
+    }
+
+    int avx_usable = (ecx & bit_OSXSAVE) && (ecx & bit_AVX) && os_supports_avx();
+    if (avx_usable && __get_cpuid_max(0, 0) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if (ebx & bit_AVX2) {
+            features |= RS_CPU_AVX2;
+        }
+    }
+
+    return features;
+}
+
+#elif defined(__aarch64__) || defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+
+uint32_t rs_cpu_features(void) {
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    uint32_t features = 0;
+
+#if defined(__aarch64__)
+    if (hwcap & HWCAP_ASIMD) {
+        features |= RS_CPU_NEON;
+    }
+#else
+    if (hwcap & HWCAP_NEON) {
+        features |= RS_CPU_NEON;
+    }
+#endif
+
+    return features;
+}
+
+#else
+
+uint32_t rs_cpu_features(void) {
+    return 0;
+}
+
+#endif
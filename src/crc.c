@@ -1,9 +1,30 @@
+#include <string.h>
+#include <pthread.h>
+
 #include "../include/crc.h"
+#include "../include/cpu.h"
 
-// Implementierung der CRC-16-CCITT Berechnung für AX.25
-uint16_t crc16_ccitt(const uint8_t *data, size_t length) {
-    uint16_t crc = AX25_FCS_INIT;
+// Slice-by-8: table[k][b] = Beitrag des Bytes b, gefolgt von k Null-Bytes
+static uint16_t table[8][256];
+
+// PCLMULQDQ-Faltungskonstanten x^n mod P (siehe crc_clmul)
+static uint64_t fold16[2];  // 16 Bytes weiter: x^(128+64), x^128
+static uint64_t fold64[2];  // 64 Bytes weiter: x^(512+64), x^512
+
+// Dasselbe für CRC-16/X.25 (bitgespiegelt, siehe x25_clmul)
+static uint16_t tableX25[8][256];
+static uint64_t fold16X25[2];
+static uint64_t fold64X25[2];
+
+static crc16_update_fn active;
+static crc16_update_fn activeX25;
+static const char* activeName;
+static pthread_once_t tablesOnce = PTHREAD_ONCE_INIT;
 
+/**
+ * @brief Bitweise Referenz (8 Schritte je Byte).
+ */
+static uint16_t crc_bitwise(uint16_t crc, const uint8_t* data, size_t length) {
     for (size_t i = 0; i < length; i++) {
         crc ^= (uint16_t)data[i] << 8;
 
@@ -15,7 +36,308 @@ uint16_t crc16_ccitt(const uint8_t *data, size_t length) {
             }
         }
     }
+    return crc;
+}
+
+/**
+ * @brief Tabellenversion: 8 Bytes je Schritt über acht Tabellen, Rest byteweise.
+ */
+static uint16_t crc_slice8(uint16_t crc, const uint8_t* data, size_t length) {
+    while (length >= 8) {
+        crc = table[7][data[0] ^ (crc >> 8)] ^ table[6][data[1] ^ (crc & 0xFF)] ^
+              table[5][data[2]] ^ table[4][data[3]] ^ table[3][data[4]] ^
+              table[2][data[5]] ^ table[1][data[6]] ^ table[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = (uint16_t)(crc << 8) ^ table[0][(crc >> 8) ^ *data++];
+    }
+    return crc;
+}
+
+/**
+ * @brief x^n mod P (P = x^16 + CRC16_CCITT_POLY).
+ */
+static uint64_t xpow_mod(unsigned int n) {
+    uint32_t r = 1;
+    while (n-- > 0) {
+        r <<= 1;
+        if (r & 0x10000) {
+            r ^= 0x10000 | CRC16_CCITT_POLY;
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Bitweise Referenz für CRC-16/X.25 (LSB zuerst).
+ */
+static uint16_t x25_bitwise(uint16_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+
+        for (int j = 0; j < 8; j++) {
+            if (crc & 1) {
+                crc = (crc >> 1) ^ CRC16_X25_POLY;
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Tabellenversion für CRC-16/X.25: 8 Bytes je Schritt, Rest byteweise.
+ */
+static uint16_t x25_slice8(uint16_t crc, const uint8_t* data, size_t length) {
+    while (length >= 8) {
+        crc = tableX25[7][data[0] ^ (crc & 0xFF)] ^ tableX25[6][data[1] ^ (crc >> 8)] ^
+              tableX25[5][data[2]] ^ tableX25[4][data[3]] ^ tableX25[3][data[4]] ^
+              tableX25[2][data[5]] ^ tableX25[1][data[6]] ^ tableX25[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = (uint16_t)(crc >> 8) ^ tableX25[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+/**
+ * @brief x^n mod P bitgespiegelt in 64 Bit (Koeffizient von x^d in Bit 63 - d).
+ */
+static uint64_t xpow_mod_reflected(unsigned int n) {
+    uint64_t r = xpow_mod(n);
+    uint64_t out = 0;
+    for (int d = 0; d < 16; d++) {
+        out |= ((r >> d) & 1) << (63 - d);
+    }
+    return out;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+#define CLMUL __attribute__((target("pclmul,ssse3")))
+#define CLMUL_MIN_LENGTH 64
+
+/**
+ * @brief 16 Bytes als Polynom laden (erstes Byte = höchste Koeffizienten).
+ */
+CLMUL static inline __m128i load_block(const uint8_t* data, __m128i reverse) {
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), reverse);
+}
+
+/**
+ * @brief X * x^(8 * Abstand) mod P, ohne vollständige Reduktion (Grad < 128 bleibt).
+ */
+CLMUL static inline __m128i fold(__m128i x, __m128i constants) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, constants, 0x11),
+                         _mm_clmulepi64_si128(x, constants, 0x00));
+}
+
+/**
+ * @brief Carry-less-Multiply-Version: faltet je 64 Bytes in vier 128-Bit-Akkumulatoren.
+ * * Der Zwischenstand ist zu jedem Zeitpunkt ein Polynom vom Grad < 128, das zu
+ * den bisher gelesenen Daten (samt Startwert) modulo P kongruent ist. Erst am
+ * Ende wird es (als 16 Bytes) über die Tabellen auf 16 Bit reduziert.
+ */
+CLMUL static uint16_t crc_clmul(uint16_t crc, const uint8_t* data, size_t length) {
+    if (length < CLMUL_MIN_LENGTH) {
+        return crc_slice8(crc, data, length);
+    }
+
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i k16 = _mm_set_epi64x((long long) fold16[0], (long long) fold16[1]);
+    const __m128i k64 = _mm_set_epi64x((long long) fold64[0], (long long) fold64[1]);
+
+    // Der Startwert gehört zu den ersten 16 Bits der Daten
+    __m128i a0 = _mm_xor_si128(load_block(data, reverse), _mm_set_epi64x((long long)((uint64_t)crc << 48), 0));
+    __m128i a1 = load_block(data + 16, reverse);
+    __m128i a2 = load_block(data + 32, reverse);
+    __m128i a3 = load_block(data + 48, reverse);
+    data += 64;
+    length -= 64;
+
+    while (length >= 64) {
+        a0 = _mm_xor_si128(fold(a0, k64), load_block(data, reverse));
+        a1 = _mm_xor_si128(fold(a1, k64), load_block(data + 16, reverse));
+        a2 = _mm_xor_si128(fold(a2, k64), load_block(data + 32, reverse));
+        a3 = _mm_xor_si128(fold(a3, k64), load_block(data + 48, reverse));
+        data += 64;
+        length -= 64;
+    }
+
+    __m128i x = _mm_xor_si128(fold(a0, k16), a1);
+    x = _mm_xor_si128(fold(x, k16), a2);
+    x = _mm_xor_si128(fold(x, k16), a3);
+
+    while (length >= 16) {
+        x = _mm_xor_si128(fold(x, k16), load_block(data, reverse));
+        data += 16;
+        length -= 16;
+    }
 
-    // Die finale CRC wird invertiert (XOR mit 0xFFFF)
-    return ~crc;
-}
\ No newline at end of file
+    // Reduktion: CRC der 16 Bytes von x (Startwert 0), dann der Rest
+    uint8_t bytes[16];
+    _mm_storeu_si128((__m128i*)bytes, _mm_shuffle_epi8(x, reverse));
+    crc = crc_slice8(0, bytes, sizeof(bytes));
+    return crc_slice8(crc, data, length);
+}
+
+/**
+ * @brief Carry-less-Multiply-Version für CRC-16/X.25.
+ * * Wie crc_clmul, aber bitgespiegelt: Bit 0 des ersten Bytes ist der höchste
+ * Koeffizient, die Blöcke werden daher ohne Umsortieren geladen. Das Produkt
+ * zweier gespiegelter 64-Bit-Werte liegt um ein Bit versetzt, die Konstanten
+ * sind deshalb x^(n - 1) statt x^n.
+ */
+CLMUL static uint16_t x25_clmul(uint16_t crc, const uint8_t* data, size_t length) {
+    if (length < CLMUL_MIN_LENGTH) {
+        return x25_slice8(crc, data, length);
+    }
+
+    const __m128i k16 = _mm_set_epi64x((long long) fold16X25[1], (long long) fold16X25[0]);
+    const __m128i k64 = _mm_set_epi64x((long long) fold64X25[1], (long long) fold64X25[0]);
+
+    // Der Startwert gehört zu den ersten 16 Bits der Daten
+    __m128i a0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_cvtsi32_si128(crc));
+    __m128i a1 = _mm_loadu_si128((const __m128i*)(data + 16));
+    __m128i a2 = _mm_loadu_si128((const __m128i*)(data + 32));
+    __m128i a3 = _mm_loadu_si128((const __m128i*)(data + 48));
+    data += 64;
+    length -= 64;
+
+    while (length >= 64) {
+        a0 = _mm_xor_si128(fold(a0, k64), _mm_loadu_si128((const __m128i*)data));
+        a1 = _mm_xor_si128(fold(a1, k64), _mm_loadu_si128((const __m128i*)(data + 16)));
+        a2 = _mm_xor_si128(fold(a2, k64), _mm_loadu_si128((const __m128i*)(data + 32)));
+        a3 = _mm_xor_si128(fold(a3, k64), _mm_loadu_si128((const __m128i*)(data + 48)));
+        data += 64;
+        length -= 64;
+    }
+
+    __m128i x = _mm_xor_si128(fold(a0, k16), a1);
+    x = _mm_xor_si128(fold(x, k16), a2);
+    x = _mm_xor_si128(fold(x, k16), a3);
+
+    while (length >= 16) {
+        x = _mm_xor_si128(fold(x, k16), _mm_loadu_si128((const __m128i*)data));
+        data += 16;
+        length -= 16;
+    }
+
+    // Reduktion: CRC der 16 Bytes von x (Startwert 0), dann der Rest
+    uint8_t bytes[16];
+    _mm_storeu_si128((__m128i*)bytes, x);
+    crc = x25_slice8(0, bytes, sizeof(bytes));
+    return x25_slice8(crc, data, length);
+}
+#endif
+
+/**
+ * @brief Baut die Tabellen und Konstanten und wählt die schnellste Variante.
+ */
+static void init_tables(void) {
+    for (int b = 0; b < 256; b++) {
+        uint8_t byte = (uint8_t) b;
+        table[0][b] = crc_bitwise(0, &byte, 1);
+    }
+    for (int k = 1; k < 8; k++) {
+        for (int b = 0; b < 256; b++) {
+            uint16_t prev = table[k - 1][b];
+            table[k][b] = (uint16_t)(prev << 8) ^ table[0][prev >> 8];
+        }
+    }
+
+    fold16[0] = xpow_mod(128 + 64);
+    fold16[1] = xpow_mod(128);
+    fold64[0] = xpow_mod(512 + 64);
+    fold64[1] = xpow_mod(512);
+
+    for (int b = 0; b < 256; b++) {
+        uint8_t byte = (uint8_t) b;
+        tableX25[0][b] = x25_bitwise(0, &byte, 1);
+    }
+    for (int k = 1; k < 8; k++) {
+        for (int b = 0; b < 256; b++) {
+            uint16_t prev = tableX25[k - 1][b];
+            tableX25[k][b] = (uint16_t)(prev >> 8) ^ tableX25[0][prev & 0xFF];
+        }
+    }
+
+    // Niedriges Wort faltet die höheren Koeffizienten (Bits 0-63 eines Blocks)
+    fold16X25[0] = xpow_mod_reflected(128 + 64 - 1);
+    fold16X25[1] = xpow_mod_reflected(128 - 1);
+    fold64X25[0] = xpow_mod_reflected(512 + 64 - 1);
+    fold64X25[1] = xpow_mod_reflected(512 - 1);
+
+    active = crc_slice8;
+    activeX25 = x25_slice8;
+    activeName = "slice8";
+#if defined(__x86_64__) || defined(__i386__)
+    if (rs_cpu_features() & RS_CPU_PCLMUL) {
+        active = crc_clmul;
+        activeX25 = x25_clmul;
+        activeName = "clmul";
+    }
+#endif
+}
+
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t* data, size_t length) {
+    pthread_once(&tablesOnce, init_tables);
+    return active(crc, data, length);
+}
+
+uint16_t crc16_ccitt(const uint8_t *data, size_t length) {
+    return crc16_ccitt_final(crc16_ccitt_update(crc16_ccitt_init(), data, length));
+}
+
+crc16_update_fn crc16_ccitt_engine(const char* name) {
+    pthread_once(&tablesOnce, init_tables);
+    if (strcmp(name, "bitwise") == 0) {
+        return crc_bitwise;
+    }
+    if (strcmp(name, "slice8") == 0) {
+        return crc_slice8;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (strcmp(name, "clmul") == 0 && (rs_cpu_features() & RS_CPU_PCLMUL)) {
+        return crc_clmul;
+    }
+#endif
+    return NULL;
+}
+
+const char* crc16_ccitt_engine_name(void) {
+    pthread_once(&tablesOnce, init_tables);
+    return activeName;
+}
+
+uint16_t crc16_x25_update(uint16_t crc, const uint8_t* data, size_t length) {
+    pthread_once(&tablesOnce, init_tables);
+    return activeX25(crc, data, length);
+}
+
+// AX.25-FCS
+uint16_t crc16_x25(const uint8_t* data, size_t length) {
+    return crc16_x25_final(crc16_x25_update(crc16_x25_init(), data, length));
+}
+
+crc16_update_fn crc16_x25_engine(const char* name) {
+    pthread_once(&tablesOnce, init_tables);
+    if (strcmp(name, "bitwise") == 0) {
+        return x25_bitwise;
+    }
+    if (strcmp(name, "slice8") == 0) {
+        return x25_slice8;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (strcmp(name, "clmul") == 0 && (rs_cpu_features() & RS_CPU_PCLMUL)) {
+        return x25_clmul;
+    }
+#endif
+    return NULL;
+}
@@ -2,106 +2,162 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
-#include <ctype.h>
-#include <math.h>
+#include <pthread.h>
 
 #include "../../include/signal_generator.h"
-#include "../../include/crc.h"
+#include "../../include/fsk.h"
 #include "../../include/encoders/afsk1200.h"
 
-#define AX25_FLAG 0x7E
-#define AX25_ADDR_LEN 7
-#define AX25_CONTROL_UI 0x03
-#define AX25_PID_NO_PROTOCOL 0xF0
-#define SAMPLES_PER_BIT (SAMPLE_RATE / AFSK_BAUD_RATE)
-#define MAX_AMPLITUDE MAX_PCM_VALUE
+#define PREAMBLE_FLAGS (16 + 1)
 
-static double current_phase = 0.0;
-static int last_nrzi_state = 1;
+// Symboltabelle: einmal je Prozess gerendert, danach nur gelesen
+static int16_t symbol_blocks[RS_FSK_TABLE_SAMPLES(SAMPLE_RATE, AFSK_BAUD_RATE)];
+static rs_fsk_table symbol_table;
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
 
-static void emit_bit(int bit) {
-    if (bit == 0) {
-        last_nrzi_state = !last_nrzi_state;
-    }
-    
-    double freq = last_nrzi_state ? AFSK_MARK_FREQ : AFSK_SPACE_FREQ;
-    double phase_step = 2.0 * M_PI * freq / SAMPLE_RATE;
-    
-    for (int i = 0; i < SAMPLES_PER_BIT; i++) {
-        int16_t sample = (int16_t)(MAX_AMPLITUDE * sin(current_phase));
-        fwrite(&sample, sizeof(int16_t), 1, stdout);
-        current_phase += phase_step;
-        if (current_phase >= 2.0 * M_PI) current_phase -= 2.0 * M_PI;
+static void init_tables(void) {
+    // Feste Parameter (18.375 Samples je Bit), die Prüfung kann nicht fehlschlagen
+    (void)rs_fsk_table_init(&symbol_table, symbol_blocks, AFSK_MARK_FREQ, AFSK_SPACE_FREQ,
+                            AFSK_BAUD_RATE, SAMPLE_RATE);
+}
+
+static void init_state(hdlc_state* st, rs_sink* sink) {
+    pthread_once(&tables_once, init_tables);
+    rs_fsk_init(&st->mod, &symbol_table, sink);
+    st->tables = hdlc_get_tables();
+    st->pending = 0;
+    st->pendingCount = 0;
+    st->level = 1;
+    st->ones = 0;
+}
+
+/**
+ * @brief Hängt einen Tabelleneintrag an den Bitstrom an; volle 32 Bit gehen
+ * an den Modulator.
+ */
+static inline void push_entry(hdlc_state* st, uint32_t entry) {
+    uint32_t count = HDLC_COUNT(entry);
+    uint32_t tones = HDLC_LEVELS(entry) ^ ((0u - st->level) & ((1u << count) - 1));
+    st->level = (tones >> (count - 1)) & 1;
+
+    st->pending |= (uint64_t)tones << st->pendingCount;
+    st->pendingCount += (int)count;
+    if (st->pendingCount >= 32) {
+        rs_fsk_symbols(&st->mod, (uint32_t)st->pending, 32);
+        st->pending >>= 32;
+        st->pendingCount -= 32;
     }
 }
 
-static void emit_byte_with_stuffing(uint8_t byte) {
-    static int ones = 0;
-    for (int i = 0; i < 8; i++) {
-        int bit = (byte >> i) & 1;
-        emit_bit(bit);
-        ones = bit ? ones + 1 : 0;
-        if (ones == 5) {
-            emit_bit(0);
-            ones = 0;
-        }
+static void emit_bytes(hdlc_state* st, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uint32_t entry = st->tables->entry[st->ones][data[i]];
+        st->ones = HDLC_ONES(entry);
+        push_entry(st, entry);
     }
 }
 
-static void emit_flags(int count) {
+static void emit_flags(hdlc_state* st, int count) {
     for (int i = 0; i < count; i++) {
-        for (int j = 0; j < 8; j++) {
-            emit_bit((AX25_FLAG >> j) & 1);
-        }
+        push_entry(st, st->tables->flag);
     }
+    st->ones = 0;
+}
+
+/**
+ * @brief Schiebt die restlichen Töne in den Modulator und diesen in den Sink.
+ */
+static void finish(hdlc_state* st) {
+    if (st->pendingCount > 0) {
+        rs_fsk_symbols(&st->mod, (uint32_t)st->pending, st->pendingCount);
+        st->pending = 0;
+        st->pendingCount = 0;
+    }
+    rs_fsk_flush(&st->mod);
+}
+
+/**
+ * @brief Beginnt einen UI-Frame: Kopf und FCS in den Zustand, Kopf senden.
+ */
+static void begin_frame(rs_afsk1200_stream* stream, const ax25_frame* frame) {
+    ax25_build_frame(frame, stream->header, stream->fcs);
+    stream->info = (const uint8_t*) frame->message;
+    stream->infoLength = strlen(frame->message);
+    stream->infoPosition = 0;
+
+    emit_bytes(&stream->hdlc, stream->header, sizeof(stream->header));
+}
+
+/**
+ * @brief Bereitet eine Übertragung mit count Frames vor (noch keine Ausgabe).
+ */
+int rs_afsk1200_init(rs_afsk1200_stream* stream, rs_sink* sink, const ax25_frame* frames, size_t count) {
+    init_state(&stream->hdlc, sink);
+    stream->frames = frames;
+    stream->count = count;
+    stream->frame = 0;
+    stream->started = 0;
+    stream->infoPosition = 0;
+    stream->infoLength = 0;
+    return (count == 0) ? 1 : 0;
 }
 
-int rs_encode_afsk1200(const char* tx_call, const char* dest_call, const char* message) {
-    current_phase = 0.0;
-    last_nrzi_state = 1;
-    
-    size_t msg_len = strlen(message);
-    size_t frame_len = 14 + 2 + msg_len + 2;
-    uint8_t *frame = (uint8_t *)malloc(frame_len);
-    if (!frame) return 1;
-    
-    size_t offset = 0;
-    
-    // Destination: 6 chars + SSID
-    for (size_t i = 0; i < 6; i++) {
-        char c = (i < strlen(dest_call) ? toupper((unsigned char)dest_call[i]) : ' ');
-        frame[offset++] = (uint8_t)(c << 1);
+/**
+ * @brief Schreibt den nächsten Abschnitt in den Sink.
+ * * Ablauf: Präambel und erster Kopf, dann je Schritt bis zu AFSK1200_STEP_BYTES
+ * Bytes Info-Feld; nach dem Info-Feld folgen FCS, Trenn-Flags und der nächste
+ * Kopf bzw. das End-Flag.
+ */
+int rs_afsk1200_step(rs_afsk1200_stream* stream) {
+    hdlc_state* st = &stream->hdlc;
+
+    if (!stream->started) {
+        // Output: 16 Pre-Amble + 1 Start + Frame (+ Trenn-Flag + Frame ...) + 1 End (per AX.25)
+        emit_flags(st, PREAMBLE_FLAGS);
+        begin_frame(stream, &stream->frames[0]);
+        stream->started = 1;
+    } else {
+        size_t n = stream->infoLength - stream->infoPosition;
+        if (n > AFSK1200_STEP_BYTES) {
+            n = AFSK1200_STEP_BYTES;
+        }
+        emit_bytes(st, stream->info + stream->infoPosition, n);
+        stream->infoPosition += n;
     }
-    frame[offset++] = 0x60;
-    
-    // Source: 6 chars + SSID + End-of-Address
-    for (size_t i = 0; i < 6; i++) {
-        char c = (i < strlen(tx_call) ? toupper((unsigned char)tx_call[i]) : ' ');
-        frame[offset++] = (uint8_t)(c << 1);
+
+    if (stream->infoPosition == stream->infoLength) {
+        emit_bytes(st, stream->fcs, sizeof(stream->fcs));
+        if (++stream->frame < stream->count) {
+            emit_flags(st, AFSK_SEPARATOR_FLAGS);
+            begin_frame(stream, &stream->frames[stream->frame]);
+        } else {
+            emit_flags(st, 1);
+            finish(st);
+            return 0;
+        }
     }
-    frame[offset++] = 0x61;
-    
-    // Control + PID
-    frame[offset++] = 0x03;
-    frame[offset++] = 0xF0;
-    
-    // Message
-    memcpy(frame + offset, message, msg_len);
-    offset += msg_len;
-    
-    // FCS (already inverted by crc16_ccitt)
-    uint16_t fcs_value = crc16_ccitt(frame, frame_len - 2);
-    frame[offset++] = (uint8_t)(fcs_value & 0xFF);
-    frame[offset++] = (uint8_t)(fcs_value >> 8);
-    
-    // Output: 16 Pre-Amble + 1 Start + Data + 1 End (per AX.25)
-    emit_flags(16);
-    emit_flags(1);
-    for (size_t i = 0; i < frame_len; i++) {
-        emit_byte_with_stuffing(frame[i]);
+
+    rs_fsk_flush(&st->mod);
+    if (st->mod.sink->error != 0) {
+        return 0;
     }
-    emit_flags(1);
-    
-    free(frame);
-    return 0;
-}
\ No newline at end of file
+    return 1;
+}
+
+int rs_encode_afsk1200_frames(rs_sink* sink, const ax25_frame* frames, size_t count) {
+    rs_afsk1200_stream stream;
+    if (rs_afsk1200_init(&stream, sink, frames, count) != 0) {
+        return 1;
+    }
+
+    while (rs_afsk1200_step(&stream)) {
+    }
+
+    // Abbruch, falls die Ausgabe fehlgeschlagen ist (z.B. EPIPE)
+    return (sink->error == 0) ? 0 : 1;
+}
+
+int rs_encode_afsk1200(rs_sink* sink, const char* tx_call, const char* dest_call, const char* message) {
+    ax25_frame frame = { tx_call, dest_call, message };
+    return rs_encode_afsk1200_frames(sink, &frame, 1);
+}
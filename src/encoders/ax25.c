@@ -0,0 +1,75 @@
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <pthread.h>
+
+#include "../../include/crc.h"
+#include "../../include/encoders/ax25.h"
+
+#define AX25_CONTROL_UI 0x03
+#define AX25_PID_NO_PROTOCOL 0xF0
+
+// Tabellen: einmal je Prozess berechnet, danach nur gelesen
+static hdlc_tables tables;
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Kodiert ein Byte bitweise (Referenz für die Tabelle).
+ * @param stuffing 1 = nach fünf 1-Bits ein 0-Bit einfügen (nicht bei Flags).
+ */
+static uint32_t hdlc_entry(uint32_t ones, uint8_t byte, int stuffing) {
+    uint32_t level = 0;
+    uint32_t levels = 0;
+    uint32_t count = 0;
+
+    for (int i = 0; i < 8; i++) {
+        uint32_t bit = (byte >> i) & 1;
+        level ^= bit ^ 1;  // NRZI: 0-Bit = Pegelwechsel
+        levels |= level << count++;
+        ones = bit ? ones + 1 : 0;
+        if (stuffing && ones == 5) {
+            level ^= 1;
+            levels |= level << count++;
+            ones = 0;
+        }
+    }
+    return levels | (count << 16) | ((stuffing ? ones : 0) << 24);
+}
+
+static void init_tables(void) {
+    for (uint32_t ones = 0; ones < 5; ones++) {
+        for (uint32_t byte = 0; byte < 256; byte++) {
+            tables.entry[ones][byte] = hdlc_entry(ones, (uint8_t)byte, 1);
+        }
+    }
+    tables.flag = hdlc_entry(0, AX25_FLAG, 0);
+}
+
+const hdlc_tables* hdlc_get_tables(void) {
+    pthread_once(&tables_once, init_tables);
+    return &tables;
+}
+
+/**
+ * @brief Schreibt ein Rufzeichenfeld: 6 Zeichen (mit Leerzeichen aufgefüllt) + SSID-Byte.
+ */
+static void put_call(uint8_t* out, const char* call, uint8_t ssid) {
+    size_t len = strlen(call);
+    for (size_t i = 0; i < 6; i++) {
+        char c = (i < len ? toupper((unsigned char)call[i]) : ' ');
+        out[i] = (uint8_t)(c << 1);
+    }
+    out[6] = ssid;
+}
+
+void ax25_build_frame(const ax25_frame* frame, uint8_t header[AX25_HEADER_LEN], uint8_t fcs[2]) {
+    put_call(header, frame->destCall, 0x60);
+    put_call(header + AX25_ADDR_LEN, frame->txCall, 0x61);  // Ende des Adressfelds
+    header[2 * AX25_ADDR_LEN] = AX25_CONTROL_UI;
+    header[2 * AX25_ADDR_LEN + 1] = AX25_PID_NO_PROTOCOL;
+
+    uint16_t crc = crc16_x25_update(crc16_x25_init(), header, AX25_HEADER_LEN);
+    crc = crc16_x25_final(crc16_x25_update(crc, (const uint8_t*) frame->message, strlen(frame->message)));
+    fcs[0] = (uint8_t)(crc & 0xFF);
+    fcs[1] = (uint8_t)(crc >> 8);
+}
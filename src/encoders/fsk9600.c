@@ -3,49 +3,231 @@
 #include <string.h>
 #include <stdint.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "../../include/signal_generator.h"
+#include "../../include/kernels.h"
 #include "../../include/encoders/fsk9600.h"
 
-#define SAMPLES_PER_BIT (SAMPLE_RATE / FSK9600_BAUD_RATE)
-#define MAX_AMPLITUDE MAX_PCM_VALUE
+// Kompiliert nur, wenn das Raster zu SAMPLE_RATE passt
+typedef char shaper_grid_check[(SAMPLE_RATE * FSK9600_SHAPER_SYMBOLS == FSK9600_BAUD_RATE * FSK9600_SHAPER_PHASES) ? 1 : -1];
 
-static double current_phase = 0.0;
+// Tabellen: einmal je Prozess berechnet, danach nur gelesen
+static uint32_t shaper_start[FSK9600_SHAPER_PHASES];                // Erstes Symbol je Phase
+static int16_t shaper_coef[FSK9600_SHAPER_PHASES * FSK9600_SHAPER_TAPS];    // Q15, Σ|c| je Zeile <= 32768
+static int16_t symbol_table[256][8];                        // Byte -> 8 Symbole (±Amplitude)
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
 
 /**
- * @brief Sendet ein einzelnes Bit mit FSK-Modulation.
+ * @brief Raised-Cosine-Impuls h(t), t in Symboldauern.
  */
-static void emit_bit(int bit) {
-    double freq = bit ? FSK9600_MARK_FREQ : FSK9600_SPACE_FREQ;
-    double phase_step = 2.0 * M_PI * freq / SAMPLE_RATE;
-    
-    for (int i = 0; i < SAMPLES_PER_BIT; i++) {
-        int16_t sample = (int16_t)(MAX_AMPLITUDE * sin(current_phase));
-        fwrite(&sample, sizeof(int16_t), 1, stdout);
-        current_phase += phase_step;
-        if (current_phase >= 2.0 * M_PI) current_phase -= 2.0 * M_PI;
+static double raised_cosine(double t) {
+    double a = FSK9600_ROLLOFF;
+    double sinc = (fabs(t) < 1e-12) ? 1.0 : sin(M_PI * t) / (M_PI * t);
+    double d = 1.0 - 4.0 * a * a * t * t;
+    if (fabs(d) < 1e-9) {
+        // Grenzwert bei |t| = 1 / (2a)
+        return M_PI / 4.0 * sin(M_PI / (2.0 * a)) / (M_PI / (2.0 * a));
+    }
+    return sinc * cos(M_PI * a * t) / d;
+}
+
+static void init_tables(void) {
+    double rows[FSK9600_SHAPER_PHASES][FSK9600_SHAPER_TAPS];
+    double maxSum = 0.0;
+
+    // Ausgang r liegt bei t = r * 64 / 147 Symbolen; Tap j trifft Symbol start + j
+    // im Abstand frac + 3 - j (Tap 3 ist das Symbol direkt vor t)
+    for (uint32_t r = 0; r < FSK9600_SHAPER_PHASES; r++) {
+        shaper_start[r] = r * FSK9600_SHAPER_SYMBOLS / FSK9600_SHAPER_PHASES;
+        double frac = (double)(r * FSK9600_SHAPER_SYMBOLS % FSK9600_SHAPER_PHASES) / FSK9600_SHAPER_PHASES;
+        double sum = 0.0;
+        for (int j = 0; j < FSK9600_SHAPER_TAPS; j++) {
+            rows[r][j] = raised_cosine(frac + (FSK9600_SHAPER_TAPS / 2 - 1) - j);
+            sum += fabs(rows[r][j]);
+        }
+        if (sum > maxSum) {
+            maxSum = sum;
+        }
+    }
+
+    // Auf die ungünstigste Zeile skalieren: der Ausgang kann nicht übersteuern
+    double scale = 32760.0 / maxSum;
+    for (uint32_t r = 0; r < FSK9600_SHAPER_PHASES; r++) {
+        for (int j = 0; j < FSK9600_SHAPER_TAPS; j++) {
+            shaper_coef[r * FSK9600_SHAPER_TAPS + j] = (int16_t)floor(rows[r][j] * scale + 0.5);
+        }
+    }
+
+    for (int byte = 0; byte < 256; byte++) {
+        for (int i = 0; i < 8; i++) {
+            symbol_table[byte][i] = ((byte >> i) & 1) ? FSK9600_AMPLITUDE : -FSK9600_AMPLITUDE;
+        }
     }
 }
 
 /**
- * @brief Sendet ein Byte Bit für Bit (LSB zuerst).
+ * @brief Formt periods volle Perioden und schreibt höchstens limit Samples.
+ * * Die FSK9600_SYMBOL_HISTORY Symbole hinter der letzten Periode wandern an den Pufferanfang.
  */
-static void emit_byte(uint8_t byte) {
-    for (int i = 0; i < 8; i++) {
-        emit_bit((byte >> i) & 1);
+static void shape_periods(rs_fsk9600_stream* st, size_t periods, size_t limit) {
+    for (size_t p = 0; p < periods; p++) {
+        st->kernels->fir_q15(st->out + p * FSK9600_SHAPER_PHASES, st->symbol + p * FSK9600_SHAPER_SYMBOLS,
+                             shaper_start, shaper_coef, FSK9600_SHAPER_TAPS, 15, FSK9600_SHAPER_PHASES);
+    }
+
+    size_t n = periods * FSK9600_SHAPER_PHASES;
+    if (n > limit) {
+        n = limit;
     }
+    rs_sink_write(st->sink, st->out, n);
+    st->emitted += n;
+
+    st->fill -= periods * FSK9600_SHAPER_SYMBOLS;
+    memmove(st->symbol, st->symbol + periods * FSK9600_SHAPER_SYMBOLS, st->fill * sizeof(int16_t));
 }
 
-int rs_encode_fsk9600(const char* message) {
-    current_phase = 0.0;
-    
-    size_t msg_len = strlen(message);
-    if (msg_len == 0) return 1;
-    
-    // Nachricht direkt senden (ohne Sync-Pattern)
-    for (size_t i = 0; i < msg_len; i++) {
-        emit_byte((uint8_t)message[i]);
+/**
+ * @brief Scrambler und Symbolabbildung für einen HDLC-Tabelleneintrag (8-10
+ * NRZI-Pegel, LSB zuerst).
+ * * Der Scrambler y[n] = x[n] ^ y[n-12] ^ y[n-17] greift nur auf Bits zurück,
+ * die mindestens 12 Takte alt sind; alle Bits eines Eintrags entstehen daher in
+ * einem Schritt aus der Historie (Bit i + 5 für y[n-12], Bit i für y[n-17]).
+ */
+static void emit_entry(rs_fsk9600_stream* st, uint32_t entry) {
+    uint32_t count = HDLC_COUNT(entry);
+    uint32_t mask = (1u << count) - 1;
+    uint32_t levels = HDLC_LEVELS(entry) ^ ((0u - st->level) & mask);
+    st->level = (levels >> (count - 1)) & 1;
+
+    uint32_t h = st->history;
+    uint32_t out = (levels ^ h ^ (h >> 5)) & mask;
+    st->history = (h >> count) | (out << (17 - count));
+
+    int16_t* symbol = st->symbol + st->fill;
+    memcpy(symbol, symbol_table[out & 0xFF], sizeof(symbol_table[0]));
+    for (uint32_t i = 8; i < count; i++) {
+        symbol[i] = ((out >> i) & 1) ? FSK9600_AMPLITUDE : -FSK9600_AMPLITUDE;
+    }
+    st->fill += count;
+    st->symbols += count;
+    if (st->fill >= FSK9600_SYMBOL_CHUNK) {
+        shape_periods(st, FSK9600_SHAPER_CHUNK, SIZE_MAX);
     }
-    
-    return 0;
+}
+
+/**
+ * @brief Sendet ein Byte des Frames mit Bit-Stuffing.
+ */
+static void emit_byte(rs_fsk9600_stream* st, uint8_t byte) {
+    uint32_t entry = st->tables->entry[st->ones][byte];
+    st->ones = HDLC_ONES(entry);
+    emit_entry(st, entry);
+}
+
+/**
+ * @brief Sendet ein Flag (ohne Stuffing) und setzt den Einsen-Zähler zurück.
+ */
+static void emit_flag(rs_fsk9600_stream* st) {
+    emit_entry(st, st->tables->flag);
+    st->ones = 0;
+}
+
+/**
+ * @brief Lässt den letzten Impuls ausklingen: Symbole mit 0 auffüllen, bis alle
+ * Samples bis FSK9600_SHAPER_TAPS / 2 Symbole nach dem letzten Symbol geschrieben sind.
+ * * Geformt werden nur so viele Perioden wie dafür nötig.
+ */
+static void finish(rs_fsk9600_stream* st) {
+    // Sample r liegt bei Pufferposition r * 64 / 147 + 3; das letzte Symbol bei
+    // symbols + 6, sein Impuls reicht 4 Symbole weiter
+    size_t total = (st->symbols + FSK9600_SYMBOL_HISTORY) * FSK9600_SHAPER_PHASES / FSK9600_SHAPER_SYMBOLS + 1;
+    while (st->emitted < total && st->sink->error == 0) {
+        size_t periods = (total - st->emitted + FSK9600_SHAPER_PHASES - 1) / FSK9600_SHAPER_PHASES;
+        if (periods > FSK9600_SHAPER_CHUNK) {
+            periods = FSK9600_SHAPER_CHUNK;
+        }
+        size_t needed = periods * FSK9600_SHAPER_SYMBOLS + FSK9600_SYMBOL_HISTORY;
+        if (st->fill < needed) {
+            memset(st->symbol + st->fill, 0, (needed - st->fill) * sizeof(int16_t));
+            st->fill = needed;
+        }
+        shape_periods(st, periods, total - st->emitted);
+    }
+}
+
+/**
+ * @brief Sendet das Byte an position der Übertragung: Vorlauf-Flags, Kopf,
+ * Info-Feld, FCS, Abschluss-Flags.
+ */
+static void emit_position(rs_fsk9600_stream* st, size_t position) {
+    if (position < FSK9600_PREAMBLE_FLAGS) {
+        emit_flag(st);
+    } else if ((position -= FSK9600_PREAMBLE_FLAGS) < AX25_HEADER_LEN) {
+        emit_byte(st, st->header[position]);
+    } else if ((position -= AX25_HEADER_LEN) < st->infoLength) {
+        emit_byte(st, st->info[position]);
+    } else if ((position -= st->infoLength) < sizeof(st->fcs)) {
+        emit_byte(st, st->fcs[position]);
+    } else {
+        emit_flag(st);
+    }
+}
+
+/**
+ * @brief Bereitet eine Übertragung vor (noch keine Ausgabe).
+ */
+int rs_fsk9600_init(rs_fsk9600_stream* st, rs_sink* sink, const ax25_frame* frame) {
+    pthread_once(&tables_once, init_tables);
+
+    st->sink = sink;
+    st->kernels = rs_kernels();
+    st->tables = hdlc_get_tables();
+    ax25_build_frame(frame, st->header, st->fcs);
+    st->info = (const uint8_t*) frame->message;
+    st->infoLength = strlen(frame->message);
+    st->position = 0;
+    st->ones = 0;
+    st->level = 0;
+    st->history = 0;
+    st->symbols = 0;
+    st->emitted = 0;
+
+    // Vorlauf aus Nullsymbolen: der erste Impuls schwingt sauber ein
+    memset(st->symbol, 0, FSK9600_SYMBOL_HISTORY * sizeof(int16_t));
+    st->fill = FSK9600_SYMBOL_HISTORY;
+    return (st->infoLength == 0) ? 1 : 0;
+}
+
+/**
+ * @brief Schreibt die nächsten FSK9600_STEP_BYTES Bytes (am Ende samt Ausklang) in den Sink.
+ */
+int rs_fsk9600_step(rs_fsk9600_stream* st) {
+    size_t total = FSK9600_PREAMBLE_FLAGS + AX25_HEADER_LEN + st->infoLength + sizeof(st->fcs) +
+                   FSK9600_TAIL_FLAGS;
+    size_t end = st->position + FSK9600_STEP_BYTES;
+    if (end > total) {
+        end = total;
+    }
+    for (; st->position < end; st->position++) {
+        emit_position(st, st->position);
+    }
+
+    if (st->position == total || st->sink->error != 0) {
+        finish(st);
+        return 0;
+    }
+    return 1;
+}
+
+int rs_encode_fsk9600(rs_sink* sink, const char* tx_call, const char* dest_call, const char* message) {
+    ax25_frame frame = { tx_call, dest_call, message };
+    rs_fsk9600_stream st;
+    if (rs_fsk9600_init(&st, sink, &frame) != 0) return 1;
+
+    while (rs_fsk9600_step(&st)) {
+    }
+
+    // Abbruch, falls die Ausgabe fehlgeschlagen ist (z.B. EPIPE)
+    return (sink->error == 0) ? 0 : 1;
 }
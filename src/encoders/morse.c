@@ -4,105 +4,71 @@
 #include <math.h>
 
 #include "../../include/signal_generator.h"
+#include "../../include/oscillator.h"
 #include "../../include/encoders/morse.h"
 
 // Frequenz des Tones (Hz) für Morsecode (Standard: 700 Hz)
 #define MORSE_TONE_FREQ 700.0
-// Der Zähler (1.2) basiert auf dem standardisierten Wort "PARIS" (50 Dits)
-#define DOT_TIME_SECONDS_NUMERATOR 1.2
-
-// Struktur zur Darstellung des Morsecodes (DIT = false, DAH = true)
-// Max. 6 Elemente, da dies die längsten Codes abdeckt (z.B. '?')
-static const MorseCode morse_codes[] = {
-    // Alphabet A-Z (Groß-/Kleinschreibung wird ignoriert)
-    // A: .-
-    [0] = { .length = 2, .elements = { false, true } }, 
-    // B: -...
-    [1] = { .length = 4, .elements = { true, false, false, false } },
-    // C: -.-.
-    [2] = { .length = 4, .elements = { true, false, true, false } },
-    // D: -..
-    [3] = { .length = 3, .elements = { true, false, false } },
-    // E: .
-    [4] = { .length = 1, .elements = { false } },
-    // F: ..-.
-    [5] = { .length = 4, .elements = { false, false, true, false } },
-    // G: --.
-    [6] = { .length = 3, .elements = { true, true, false } },
-    // H: ....
-    [7] = { .length = 4, .elements = { false, false, false, false } },
-    // I: ..
-    [8] = { .length = 2, .elements = { false, false } },
-    // J: .---
-    [9] = { .length = 4, .elements = { false, true, true, true } },
-    // K: -.-
-    [10] = { .length = 3, .elements = { true, false, true } },
-    // L: .-..
-    [11] = { .length = 4, .elements = { false, true, false, false } },
-    // M: --
-    [12] = { .length = 2, .elements = { true, true } },
-    // N: -.
-    [13] = { .length = 2, .elements = { true, false } },
-    // O: ---
-    [14] = { .length = 3, .elements = { true, true, true } },
-    // P: .--.
-    [15] = { .length = 4, .elements = { false, true, true, false } },
-    // Q: --.-
-    [16] = { .length = 4, .elements = { true, true, false, true } },
-    // R: .-.
-    [17] = { .length = 3, .elements = { false, true, false } },
-    // S: ...
-    [18] = { .length = 3, .elements = { false, false, false } },
-    // T: -
-    [19] = { .length = 1, .elements = { true } },
-    // U: ..-
-    [20] = { .length = 3, .elements = { false, false, true } },
-    // V: ...-
-    [21] = { .length = 4, .elements = { false, false, false, true } },
-    // W: .--
-    [22] = { .length = 3, .elements = { false, true, true } },
-    // X: -..-
-    [23] = { .length = 4, .elements = { true, false, false, true } },
-    // Y: -.--
-    [24] = { .length = 4, .elements = { true, false, true, true } },
-    // Z: --..
-    [25] = { .length = 4, .elements = { true, true, false, false } },
-
-    // Ziffern 0-9 (ASCII-Code 48-57)
-    // 0: ----- (Index 26)
-    [26] = { .length = 5, .elements = { true, true, true, true, true } },
-    // 1: .----
-    [27] = { .length = 5, .elements = { false, true, true, true, true } },
-    // 2: ..---
-    [28] = { .length = 5, .elements = { false, false, true, true, true } },
-    // 3: ...--
-    [29] = { .length = 5, .elements = { false, false, false, true, true } },
-    // 4: ....-
-    [30] = { .length = 5, .elements = { false, false, false, false, true } },
-    // 5: .....
-    [31] = { .length = 5, .elements = { false, false, false, false, false } },
-    // 6: -....
-    [32] = { .length = 5, .elements = { true, false, false, false, false } },
-    // 7: --...
-    [33] = { .length = 5, .elements = { true, true, false, false, false } },
-    // 8: ---..
-    [34] = { .length = 5, .elements = { true, true, true, false, false } },
-    // 9: ----. (Index 35)
-    [35] = { .length = 5, .elements = { true, true, true, true, false } },
-
-    // Sonderzeichen (Index 36-39)
-    // Leerzeichen: wird durch die Wortpause (7 Dits) implementiert (kein Code nötig)
-    // Punkt (.): .-.-.- (Index 36)
-    [36] = { .length = 6, .elements = { false, true, false, true, false, true } },
-    // Komma (,): --..-- (Index 37)
-    [37] = { .length = 6, .elements = { true, true, false, false, true, true } },
-    // Fragezeichen (?): ..--.. (Index 38)
-    [38] = { .length = 6, .elements = { false, false, true, true, false, false } },
-    // Schrägstrich (/): -..-. (Index 39)
-    [39] = { .length = 5, .elements = { true, false, false, true, false } },
+// Anstiegs- und Abfallzeit der Tastflanken (ms)
+#define MORSE_RAMP_MS 5
+// Dit-Dauer 1.2 s / WPM (in Zehntelsekunden), basiert auf dem standardisierten Wort "PARIS" (50 Dits)
+#define DOT_TIME_TENTHS 12
+
+// Kompakte Codetabelle für ' ' bis 'Z' (Kleinbuchstaben werden vorher umgewandelt).
+// code: Elemente ab Bit 0 (1 = Dah, 0 = Dit), darüber ein Markierungsbit, dessen
+//       Position die Anzahl der Elemente angibt; 0 = unbekanntes Zeichen.
+// dots: Dauer des Zeichens in Dits (Elemente plus Element-Lücken, ohne Zeichen-Lücke).
+// Leerzeichen wird durch die Wortpause (7 Dits) implementiert (kein Code nötig).
+#define MORSE_TABLE_FIRST ' '
+#define MORSE_TABLE_LAST 'Z'
+
+typedef struct {
+    uint8_t code;
+    uint8_t dots;
+} morse_entry;
+
+static const morse_entry morse_table[MORSE_TABLE_LAST - MORSE_TABLE_FIRST + 1] = {
+    [',' - MORSE_TABLE_FIRST] = { 0x73, 19 }, // --..--
+    ['.' - MORSE_TABLE_FIRST] = { 0x6A, 17 }, // .-.-.-
+    ['/' - MORSE_TABLE_FIRST] = { 0x29, 13 }, // -..-.
+    ['0' - MORSE_TABLE_FIRST] = { 0x3F, 19 }, // -----
+    ['1' - MORSE_TABLE_FIRST] = { 0x3E, 17 }, // .----
+    ['2' - MORSE_TABLE_FIRST] = { 0x3C, 15 }, // ..---
+    ['3' - MORSE_TABLE_FIRST] = { 0x38, 13 }, // ...--
+    ['4' - MORSE_TABLE_FIRST] = { 0x30, 11 }, // ....-
+    ['5' - MORSE_TABLE_FIRST] = { 0x20,  9 }, // .....
+    ['6' - MORSE_TABLE_FIRST] = { 0x21, 11 }, // -....
+    ['7' - MORSE_TABLE_FIRST] = { 0x23, 13 }, // --...
+    ['8' - MORSE_TABLE_FIRST] = { 0x27, 15 }, // ---..
+    ['9' - MORSE_TABLE_FIRST] = { 0x2F, 17 }, // ----.
+    ['?' - MORSE_TABLE_FIRST] = { 0x4C, 15 }, // ..--..
+    ['A' - MORSE_TABLE_FIRST] = { 0x06,  5 }, // .-
+    ['B' - MORSE_TABLE_FIRST] = { 0x11,  9 }, // -...
+    ['C' - MORSE_TABLE_FIRST] = { 0x15, 11 }, // -.-.
+    ['D' - MORSE_TABLE_FIRST] = { 0x09,  7 }, // -..
+    ['E' - MORSE_TABLE_FIRST] = { 0x02,  1 }, // .
+    ['F' - MORSE_TABLE_FIRST] = { 0x14,  9 }, // ..-.
+    ['G' - MORSE_TABLE_FIRST] = { 0x0B,  9 }, // --.
+    ['H' - MORSE_TABLE_FIRST] = { 0x10,  7 }, // ....
+    ['I' - MORSE_TABLE_FIRST] = { 0x04,  3 }, // ..
+    ['J' - MORSE_TABLE_FIRST] = { 0x1E, 13 }, // .---
+    ['K' - MORSE_TABLE_FIRST] = { 0x0D,  9 }, // -.-
+    ['L' - MORSE_TABLE_FIRST] = { 0x12,  9 }, // .-..
+    ['M' - MORSE_TABLE_FIRST] = { 0x07,  7 }, // --
+    ['N' - MORSE_TABLE_FIRST] = { 0x05,  5 }, // -.
+    ['O' - MORSE_TABLE_FIRST] = { 0x0F, 11 }, // ---
+    ['P' - MORSE_TABLE_FIRST] = { 0x16, 11 }, // .--.
+    ['Q' - MORSE_TABLE_FIRST] = { 0x1B, 13 }, // --.-
+    ['R' - MORSE_TABLE_FIRST] = { 0x0A,  7 }, // .-.
+    ['S' - MORSE_TABLE_FIRST] = { 0x08,  5 }, // ...
+    ['T' - MORSE_TABLE_FIRST] = { 0x03,  3 }, // -
+    ['U' - MORSE_TABLE_FIRST] = { 0x0C,  7 }, // ..-
+    ['V' - MORSE_TABLE_FIRST] = { 0x18,  9 }, // ...-
+    ['W' - MORSE_TABLE_FIRST] = { 0x0E,  9 }, // .--
+    ['X' - MORSE_TABLE_FIRST] = { 0x19, 11 }, // -..-
+    ['Y' - MORSE_TABLE_FIRST] = { 0x1D, 13 }, // -.--
+    ['Z' - MORSE_TABLE_FIRST] = { 0x13, 11 }, // --..
 };
-// Größe des Lookup-Tabelle
-#define MORSE_CODES_SIZE (sizeof(morse_codes) / sizeof(morse_codes[0]))
 
 /**
  * @brief Berechnet die Dit-Dauer in Samples basierend auf Wörtern pro Minute (WPM).
@@ -111,203 +77,182 @@ static const MorseCode morse_codes[] = {
  */
 static size_t calculate_dot_samples(uint32_t wpm) {
     if (wpm == 0) return 0;
-    // Dot-Dauer (Sekunden) = 1.2 / WPM.
-    // Dot-Dauer (Samples) = SAMPLE_RATE * (1.2 / WPM)
-    double dot_duration_seconds = DOT_TIME_SECONDS_NUMERATOR / (double)wpm;
-    return (size_t)round((double)SAMPLE_RATE * dot_duration_seconds);
+    // Dot-Dauer (Samples) = SAMPLE_RATE * 1.2 / WPM, kaufmännisch gerundet
+    return ((size_t)SAMPLE_RATE * DOT_TIME_TENTHS + 5 * (size_t)wpm) / (10 * (size_t)wpm);
 }
 
 /**
- * @brief Ruft die MorseCode-Struktur für ein Zeichen ab.
- * @param c Das Zeichen.
- * @return const MorseCode* Zeiger auf die Struktur oder NULL bei unbekanntem Zeichen.
+ * @brief Rendert ein getastetes Element (Dit oder Dah) als Vorlage.
+ * * Der Ton beginnt mit Phase 0 und wird mit Raised-Cosine-Flanken von
+ * MORSE_RAMP_MS (höchstens einem Drittel der Elementdauer) ein- und ausgeblendet;
+ * das vermeidet die Tastklicks harter Tastung.
  */
-static const MorseCode* get_morse_code(char c) {
-    // Konvertiere zu Großbuchstaben für die Konsistenz
-    if (c >= 'a' && c <= 'z') {
-        c = c - 'a' + 'A';
-    }
-
-    if (c >= 'A' && c <= 'Z') {
-        return &morse_codes[c - 'A'];
+static void build_element(int16_t* out, size_t samples) {
+    rs_oscillator osc;
+    rs_osc_init(&osc, MORSE_TONE_FREQ, SAMPLE_RATE, 1);
+    rs_osc_render(&osc, out, samples);
+
+    size_t ramp = (size_t)(SAMPLE_RATE * MORSE_RAMP_MS / 1000);
+    if (ramp > samples / 3) {
+        ramp = samples / 3;
     }
-    if (c >= '0' && c <= '9') {
-        // '0' ist Index 26, '1' ist Index 27, etc.
-        return &morse_codes[c - '0' + 26];
-    }
-    
-    switch (c) {
-        case '.': return &morse_codes[36];
-        case ',': return &morse_codes[37];
-        case '?': return &morse_codes[38];
-        case '/': return &morse_codes[39];
-        // Leerzeichen wird durch die Pausenlogik außerhalb dieser Funktion behandelt
-        case ' ':
-            return NULL;
-        default:
-            return NULL; // Unbekanntes Zeichen
+    for (size_t i = 0; i < ramp; i++) {
+#ifdef RS_FIXED_POINT
+        // gain = sin²(PI/2 * (i + 0.5) / ramp) in Q15 aus der Sinustabelle
+        // (Amplitude 32767, daher / 32767); die Phase (2i + 1) / (8 * ramp)
+        // Perioden passt exakt in 32 Bit
+        uint32_t phase = (uint32_t)(((uint64_t)(2 * i + 1) << 29) / ramp);
+        int32_t s = rs_sine_lookup(phase, 1);
+        int32_t gain = (int32_t)(((int64_t)s * s * 32768 + 16383 * 32767) / (32767 * 32767));
+        out[i] = (int16_t)((out[i] * gain + (1 << 14)) >> 15);
+        out[samples - 1 - i] = (int16_t)((out[samples - 1 - i] * gain + (1 << 14)) >> 15);
+#else
+        double gain = 0.5 * (1.0 - cos(M_PI * ((double)i + 0.5) / (double)ramp));
+        out[i] = (int16_t)lrint(out[i] * gain);
+        out[samples - 1 - i] = (int16_t)lrint(out[samples - 1 - i] * gain);
+#endif
     }
 }
 
 /**
- * @brief Berechnet die erforderliche Puffergröße für die vollständige Nachricht.
+ * @brief Liefert den Tabelleneintrag für ein Zeichen oder NULL bei unbekanntem Zeichen.
  */
-size_t morse_messageLength(const char* message, uint32_t wpm) {
-    if (wpm == 0 || message == NULL || *message == '\0') {
-        return 0;
+static const morse_entry* lookup(char c) {
+    // Konvertiere zu Großbuchstaben für die Konsistenz
+    if (c >= 'a' && c <= 'z') {
+        c = c - 'a' + 'A';
     }
-
-    size_t dot_samples = calculate_dot_samples(wpm);
-    if (dot_samples == 0) return 0;
-
-    // Verwende lokale Makros, die auf der berechneten dot_samples basieren
-    const size_t DIT = dot_samples;
-    const size_t DAH = dot_samples * 3;
-    const size_t ELEMENT_GAP = dot_samples;
-    const size_t CHAR_GAP = dot_samples * 3; // Lücke zwischen Zeichen (Dauer = 3 Dits)
-    const size_t WORD_GAP = dot_samples * 7; // Lücke zwischen Wörtern (Dauer = 7 Dits)
-
-    size_t total_samples = 0;
-    bool previous_char_was_space = true; // Starte mit einer impliziten Wortlücke
-
-    for (const char *p = message; *p != '\0'; p++) {
-        char c = *p;
-
-        if (c == ' ') {
-            // Wenn das vorherige Zeichen kein Leerzeichen war, füge die Wortpause hinzu
-            if (!previous_char_was_space) {
-                total_samples += WORD_GAP;
-            }
-            previous_char_was_space = true;
-            continue;
-        }
-
-        const MorseCode* code = get_morse_code(c);
-        if (code == NULL) {
-            fprintf(stderr, "Warnung: Unbekanntes Morse-Zeichen '%c' übersprungen.\n", c);
-            previous_char_was_space = false;
-            continue;
-        }
-
-        // 1. Zähle die Elemente (Dits/Dahs) und die Lücken zwischen ihnen
-        for (uint8_t i = 0; i < code->length; i++) {
-            // Elementdauer (DIT oder DAH)
-            total_samples += code->elements[i] ? DAH : DIT;
-
-            // Lücke nach dem Element (außer nach dem letzten Element)
-            if (i < code->length - 1) {
-                total_samples += ELEMENT_GAP;
-            }
-        }
-
-        // 2. Lücke nach dem Zeichen (3 Dits, ABER: die letzte Element-Lücke ist 1 Dit, 
-        // also müssen wir nur 2 weitere Dits hinzufügen, um auf 3 zu kommen)
-        // Die Lücke zwischen Elementen ist 1 Dit, die Lücke zwischen Zeichen ist 3 Dits.
-        // Die Lücke nach dem letzten Element eines Zeichens muss 3 Dits sein.
-        // Da wir nach dem letzten Element KEINE ELEMENT_GAP hinzugefügt haben,
-        // müssen wir CHAR_GAP (3 Dits) hinzufügen.
-        total_samples += CHAR_GAP;
-
-        previous_char_was_space = false;
+    if (c < MORSE_TABLE_FIRST || c > MORSE_TABLE_LAST) {
+        return NULL;
     }
+    const morse_entry* entry = &morse_table[c - MORSE_TABLE_FIRST];
+    return entry->code != 0 ? entry : NULL;
+}
 
-    // Entferne die CHAR_GAP oder WORD_GAP nach dem letzten Zeichen
-    if (total_samples > CHAR_GAP) {
-        total_samples -= CHAR_GAP;
-    } else if (total_samples > WORD_GAP) {
-        // Dies sollte nicht passieren, aber eine Sicherheitsmaßnahme
-        total_samples -= WORD_GAP;
+/**
+ * @brief Gibt die aufgelaufene Pause aus und setzt sie zurück.
+ */
+static void flush_gap(morse_stream* stream, size_t dots) {
+    if (dots > 0) {
+        size_t samples = dots * stream->dotSamples;
+        rs_sink_write_silence(stream->sink, samples);
+        stream->samples += samples;
     }
+    stream->pendingDots = 0;
+}
 
-    return total_samples;
+/**
+ * @brief Anzahl Samples, die morse_streamInit() für die Dit-/Dah-Vorlagen benötigt.
+ */
+size_t morse_templateSamples(uint32_t wpm) {
+    return calculate_dot_samples(wpm) * 4;
 }
 
 /**
- * @brief Kodiert einen gegebenen ASCII-String in eine Sequenz von Morse-Elementen
- * und generiert das rohe Audiosignal (PCM).
+ * @brief Bereitet einen Morse-Strom vor und rendert die Dit-/Dah-Vorlagen.
  */
-size_t morse_encodeTransmission(const char* message, uint32_t wpm, int16_t* out, size_t buffer_size) {
-    if (wpm == 0 || message == NULL || out == NULL || buffer_size == 0) {
-        return 0;
+int morse_streamInit(morse_stream* stream, rs_sink* sink, uint32_t wpm, int16_t* templates) {
+    size_t dot_samples = calculate_dot_samples(wpm);
+    if (dot_samples == 0 || templates == NULL) {
+        return -1;
     }
 
-    // Berechne die genauen Timings
-    size_t dot_samples = calculate_dot_samples(wpm);
-    if (dot_samples == 0) return 0;
+    // Dit und Dah einmal als Vorlage rendern, danach nur noch kopieren
+    build_element(templates, dot_samples);
+    build_element(templates + dot_samples, dot_samples * 3);
+
+    stream->sink = sink;
+    stream->dit = templates;
+    stream->dah = templates + dot_samples;
+    stream->dotSamples = dot_samples;
+    stream->pendingDots = 0;
+    stream->previousWasSpace = true; // Behandelt den ersten Wortabstand
+    stream->samples = 0;
+    morse_streamSetText(stream, "", 0);
+    return 0;
+}
 
-    const size_t DIT = dot_samples;
-    const size_t DAH = dot_samples * 3;
-    const size_t ELEMENT_GAP = dot_samples;
-    const size_t CHAR_GAP = dot_samples * 3; // Lücke zwischen Zeichen (3 Dits)
-    const size_t WORD_GAP = dot_samples * 7; // Lücke zwischen Wörtern (7 Dits)
-    
-    size_t written_samples = 0;
-    size_t overall_time_index = 0; // Für die kontinuierliche Sinus-Berechnung
+/**
+ * @brief Übergibt die nächsten length Zeichen, die morse_streamStep() ausgibt.
+ */
+void morse_streamSetText(morse_stream* stream, const char* text, size_t length) {
+    stream->text = text;
+    stream->length = length;
+    stream->position = 0;
+    stream->code = 1;
+}
 
-    // Generiert eine Pause (0-Samples)
-    #define GENERATE_SILENCE(duration) \
-        for (size_t i = 0; i < duration; i++) { \
-            if (written_samples >= buffer_size) return written_samples; \
-            out[written_samples++] = 0; \
-            overall_time_index++; \
-        }
+/**
+ * @brief Gibt das nächste Element (samt Lücke davor) in den Sink aus.
+ * * Zwischen zwei Aufrufen steht der Strom zwischen zwei Elementen; code hält
+ * die noch offenen Elemente des aktuellen Zeichens.
+ */
+bool morse_streamStep(morse_stream* stream) {
+    const size_t DIT = stream->dotSamples;
+    const size_t DAH = stream->dotSamples * 3;
 
-    // Generiert einen Ton (Morsecode-Element)
-    #define GENERATE_TONE(duration) \
-        for (size_t i = 0; i < duration; i++) { \
-            if (written_samples >= buffer_size) return written_samples; \
-            out[written_samples++] = rs_generate_tone_sample(MORSE_TONE_FREQ, overall_time_index, SAMPLE_RATE); \
-            overall_time_index++; \
+    while (stream->code <= 1) {
+        if (stream->position == stream->length || stream->sink->error != 0) {
+            return false;
         }
-
-    bool previous_char_was_space = true; // Behandelt den ersten Wortabstand
-
-    for (const char *p = message; *p != '\0'; p++) {
-        char c = *p;
+        char c = stream->text[stream->position++];
 
         if (c == ' ') {
-            // Wortpause: 7 Dits
-            if (!previous_char_was_space) {
-                GENERATE_SILENCE(WORD_GAP);
+            // Wortpause: 7 Dits (zusätzlich zur Zeichen-Lücke davor)
+            if (!stream->previousWasSpace) {
+                stream->pendingDots += 7;
             }
-            previous_char_was_space = true;
+            stream->previousWasSpace = true;
             continue;
         }
 
-        const MorseCode* code = get_morse_code(c);
-        if (code == NULL) {
+        const morse_entry* entry = lookup(c);
+        if (entry == NULL) {
             fprintf(stderr, "Warnung: Unbekanntes Morse-Zeichen '%c' übersprungen.\n", c);
-            previous_char_was_space = false;
+            stream->previousWasSpace = false;
             continue;
         }
 
-        // Kodierung der Elemente
-        for (uint8_t i = 0; i < code->length; i++) {
-            size_t element_duration = code->elements[i] ? DAH : DIT;
-            
-            // 1. Ton (DIT oder DAH)
-            GENERATE_TONE(element_duration);
+        // Pausen werden erst vor dem nächsten Zeichen ausgegeben, die letzte entfällt
+        flush_gap(stream, stream->pendingDots);
+        stream->code = entry->code;
+        stream->samples += (uint64_t)entry->dots * DIT;
+    }
 
-            // 2. Element-Lücke (1 Dit) - Nur zwischen Elementen, NICHT nach dem letzten
-            if (i < code->length - 1) {
-                GENERATE_SILENCE(ELEMENT_GAP);
-            }
-        }
+    // Elemente ab Bit 0, bis nur noch das Markierungsbit übrig ist
+    if (stream->code & 1) {
+        rs_sink_write(stream->sink, stream->dah, DAH);
+    } else {
+        rs_sink_write(stream->sink, stream->dit, DIT);
+    }
+    // Element-Lücke (1 Dit) - Nur zwischen Elementen, NICHT nach dem letzten
+    if (stream->code > 3) {
+        rs_sink_write_silence(stream->sink, DIT);
+    }
+    stream->code >>= 1;
 
-        // 3. Zeichen-Lücke (3 Dits)
-        // Die Lücke nach dem letzten Element muss 3 Dits sein.
-        // Die 1-Dit-Lücke wird von ELEMENT_GAP nicht hinzugefügt, also fügen wir hier die vollen CHAR_GAP hinzu.
-        GENERATE_SILENCE(CHAR_GAP);
-        
-        previous_char_was_space = false;
+    if (stream->code <= 1) {
+        // Zeichen-Lücke (3 Dits)
+        stream->pendingDots = 3;
+        stream->previousWasSpace = false;
     }
+    return stream->sink->error == 0;
+}
 
-    // Entferne die am Ende hinzugefügte Zeichen- oder Wort-Lücke
-    if (written_samples >= CHAR_GAP) {
-        written_samples -= CHAR_GAP;
-    } else if (written_samples >= WORD_GAP) {
-         written_samples -= WORD_GAP;
+/**
+ * @brief Kodiert die nächsten length Zeichen und schreibt sie in den Sink.
+ */
+void morse_streamWrite(morse_stream* stream, const char* text, size_t length) {
+    morse_streamSetText(stream, text, length);
+    while (morse_streamStep(stream)) {
     }
+}
 
-    return written_samples;
-}
\ No newline at end of file
+/**
+ * @brief Schließt den Strom ab und liefert die Anzahl geschriebener Samples.
+ */
+uint64_t morse_streamFinish(morse_stream* stream) {
+    // Nach dem letzten Zeichen entfällt die Zeichen-Lücke, Wortpausen bleiben
+    flush_gap(stream, stream->pendingDots >= 3 ? stream->pendingDots - 3 : 0);
+    return stream->samples;
+}
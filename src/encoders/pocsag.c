@@ -24,33 +24,91 @@
 #define FRAME_SIZE 2
 #define PREAMBLE_LENGTH 576
 
+// BCH(31,21)-Prüfbits (Generator CRC_GENERATOR) je 7 Datenbits. Der Rest der
+// Polynomdivision ist linear, die Prüfbits eines 21-Bit-Worts sind daher das
+// XOR der drei Teiltabellen (Bits 0-6, 7-13, 14-20).
+static const uint16_t bchLow[128] = {
+    0x000, 0x369, 0x1BB, 0x2D2, 0x376, 0x01F, 0x2CD, 0x1A4,
+    0x185, 0x2EC, 0x03E, 0x357, 0x2F3, 0x19A, 0x348, 0x021,
+    0x30A, 0x063, 0x2B1, 0x1D8, 0x07C, 0x315, 0x1C7, 0x2AE,
+    0x28F, 0x1E6, 0x334, 0x05D, 0x1F9, 0x290, 0x042, 0x32B,
+    0x17D, 0x214, 0x0C6, 0x3AF, 0x20B, 0x162, 0x3B0, 0x0D9,
+    0x0F8, 0x391, 0x143, 0x22A, 0x38E, 0x0E7, 0x235, 0x15C,
+    0x277, 0x11E, 0x3CC, 0x0A5, 0x101, 0x268, 0x0BA, 0x3D3,
+    0x3F2, 0x09B, 0x249, 0x120, 0x084, 0x3ED, 0x13F, 0x256,
+    0x2FA, 0x193, 0x341, 0x028, 0x18C, 0x2E5, 0x037, 0x35E,
+    0x37F, 0x016, 0x2C4, 0x1AD, 0x009, 0x360, 0x1B2, 0x2DB,
+    0x1F0, 0x299, 0x04B, 0x322, 0x286, 0x1EF, 0x33D, 0x054,
+    0x075, 0x31C, 0x1CE, 0x2A7, 0x303, 0x06A, 0x2B8, 0x1D1,
+    0x387, 0x0EE, 0x23C, 0x155, 0x0F1, 0x398, 0x14A, 0x223,
+    0x202, 0x16B, 0x3B9, 0x0D0, 0x174, 0x21D, 0x0CF, 0x3A6,
+    0x08D, 0x3E4, 0x136, 0x25F, 0x3FB, 0x092, 0x240, 0x129,
+    0x108, 0x261, 0x0B3, 0x3DA, 0x27E, 0x117, 0x3C5, 0x0AC,
+};
+static const uint16_t bchMid[128] = {
+    0x000, 0x29D, 0x253, 0x0CE, 0x3CF, 0x152, 0x19C, 0x301,
+    0x0F7, 0x26A, 0x2A4, 0x039, 0x338, 0x1A5, 0x16B, 0x3F6,
+    0x1EE, 0x373, 0x3BD, 0x120, 0x221, 0x0BC, 0x072, 0x2EF,
+    0x119, 0x384, 0x34A, 0x1D7, 0x2D6, 0x04B, 0x085, 0x218,
+    0x3DC, 0x141, 0x18F, 0x312, 0x013, 0x28E, 0x240, 0x0DD,
+    0x32B, 0x1B6, 0x178, 0x3E5, 0x0E4, 0x279, 0x2B7, 0x02A,
+    0x232, 0x0AF, 0x061, 0x2FC, 0x1FD, 0x360, 0x3AE, 0x133,
+    0x2C5, 0x058, 0x096, 0x20B, 0x10A, 0x397, 0x359, 0x1C4,
+    0x0D1, 0x24C, 0x282, 0x01F, 0x31E, 0x183, 0x14D, 0x3D0,
+    0x026, 0x2BB, 0x275, 0x0E8, 0x3E9, 0x174, 0x1BA, 0x327,
+    0x13F, 0x3A2, 0x36C, 0x1F1, 0x2F0, 0x06D, 0x0A3, 0x23E,
+    0x1C8, 0x355, 0x39B, 0x106, 0x207, 0x09A, 0x054, 0x2C9,
+    0x30D, 0x190, 0x15E, 0x3C3, 0x0C2, 0x25F, 0x291, 0x00C,
+    0x3FA, 0x167, 0x1A9, 0x334, 0x035, 0x2A8, 0x266, 0x0FB,
+    0x2E3, 0x07E, 0x0B0, 0x22D, 0x12C, 0x3B1, 0x37F, 0x1E2,
+    0x214, 0x089, 0x047, 0x2DA, 0x1DB, 0x346, 0x388, 0x115,
+};
+static const uint16_t bchHigh[128] = {
+    0x000, 0x1A2, 0x344, 0x2E6, 0x1E1, 0x043, 0x2A5, 0x307,
+    0x3C2, 0x260, 0x086, 0x124, 0x223, 0x381, 0x167, 0x0C5,
+    0x0ED, 0x14F, 0x3A9, 0x20B, 0x10C, 0x0AE, 0x248, 0x3EA,
+    0x32F, 0x28D, 0x06B, 0x1C9, 0x2CE, 0x36C, 0x18A, 0x028,
+    0x1DA, 0x078, 0x29E, 0x33C, 0x03B, 0x199, 0x37F, 0x2DD,
+    0x218, 0x3BA, 0x15C, 0x0FE, 0x3F9, 0x25B, 0x0BD, 0x11F,
+    0x137, 0x095, 0x273, 0x3D1, 0x0D6, 0x174, 0x392, 0x230,
+    0x2F5, 0x357, 0x1B1, 0x013, 0x314, 0x2B6, 0x050, 0x1F2,
+    0x3B4, 0x216, 0x0F0, 0x152, 0x255, 0x3F7, 0x111, 0x0B3,
+    0x076, 0x1D4, 0x332, 0x290, 0x197, 0x035, 0x2D3, 0x371,
+    0x359, 0x2FB, 0x01D, 0x1BF, 0x2B8, 0x31A, 0x1FC, 0x05E,
+    0x09B, 0x139, 0x3DF, 0x27D, 0x17A, 0x0D8, 0x23E, 0x39C,
+    0x26E, 0x3CC, 0x12A, 0x088, 0x38F, 0x22D, 0x0CB, 0x169,
+    0x1AC, 0x00E, 0x2E8, 0x34A, 0x04D, 0x1EF, 0x309, 0x2AB,
+    0x283, 0x321, 0x1C7, 0x065, 0x362, 0x2C0, 0x026, 0x184,
+    0x141, 0x0E3, 0x205, 0x3A7, 0x0A0, 0x102, 0x3E4, 0x246,
+};
+
+// Bitumkehr für die LSB-zuerst-Übertragung der Zeichen (7 Bit ASCII, 4 Bit BCD)
+static const uint8_t reverse7[128] = {
+    0x00, 0x40, 0x20, 0x60, 0x10, 0x50, 0x30, 0x70, 0x08, 0x48, 0x28, 0x68, 0x18, 0x58, 0x38, 0x78,
+    0x04, 0x44, 0x24, 0x64, 0x14, 0x54, 0x34, 0x74, 0x0C, 0x4C, 0x2C, 0x6C, 0x1C, 0x5C, 0x3C, 0x7C,
+    0x02, 0x42, 0x22, 0x62, 0x12, 0x52, 0x32, 0x72, 0x0A, 0x4A, 0x2A, 0x6A, 0x1A, 0x5A, 0x3A, 0x7A,
+    0x06, 0x46, 0x26, 0x66, 0x16, 0x56, 0x36, 0x76, 0x0E, 0x4E, 0x2E, 0x6E, 0x1E, 0x5E, 0x3E, 0x7E,
+    0x01, 0x41, 0x21, 0x61, 0x11, 0x51, 0x31, 0x71, 0x09, 0x49, 0x29, 0x69, 0x19, 0x59, 0x39, 0x79,
+    0x05, 0x45, 0x25, 0x65, 0x15, 0x55, 0x35, 0x75, 0x0D, 0x4D, 0x2D, 0x6D, 0x1D, 0x5D, 0x3D, 0x7D,
+    0x03, 0x43, 0x23, 0x63, 0x13, 0x53, 0x33, 0x73, 0x0B, 0x4B, 0x2B, 0x6B, 0x1B, 0x5B, 0x3B, 0x7B,
+    0x07, 0x47, 0x27, 0x67, 0x17, 0x57, 0x37, 0x77, 0x0F, 0x4F, 0x2F, 0x6F, 0x1F, 0x5F, 0x3F, 0x7F,
+};
+static const uint8_t reverse4[16] = {
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF,
+};
+
 /**
  * Berechnet den CRC-Fehlerprüfcode für das gegebene Wort (21 Datenbits).
  */
 static uint32_t crc(uint32_t inputMsg) {
-    uint32_t denominator = CRC_GENERATOR << 20;
-    uint32_t msg = inputMsg << CRC_BITS;
-
-    for (int column = 0; column <= 20; column++) {
-        int msgBit = (msg >> (30 - column)) & 1;
-        if (msgBit != 0) {
-            msg ^= denominator;
-        }
-        denominator >>= 1;
-    }
-    return msg & 0x3FF;
+    return bchLow[inputMsg & 0x7F] ^ bchMid[(inputMsg >> 7) & 0x7F] ^ bchHigh[(inputMsg >> 14) & 0x7F];
 }
 
 /**
  * Berechnet das gerade Paritätsbit für eine Nachricht (31 Bits).
  */
 static uint32_t parity(uint32_t x) {
-    uint32_t p = 0;
-    for (int i = 0; i < 32; i++) {
-        p ^= (x & 1);
-        x >>= 1;
-    }
-    return p;
+    return (uint32_t) __builtin_parity(x);
 }
 
 /**
@@ -69,58 +127,91 @@ static uint32_t addressOffset(uint32_t address) {
     return (address & 0x7) * FRAME_SIZE;
 }
 
+/**
+ * Liefert den 4-Bit-Code eines Zeichens im numerischen Zeichensatz oder -1.
+ * 0-9 = Ziffern, 0xA = reserviert, 0xB = 'U' (dringend), 0xC = Leerzeichen,
+ * 0xD = '-', 0xE = ']' bzw. ')', 0xF = '[' bzw. '('.
+ */
+static int numericCode(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    switch (c) {
+        case 'U': case 'u': return 0xB;
+        case ' ': return 0xC;
+        case '-': return 0xD;
+        case ']': case ')': return 0xE;
+        case '[': case '(': return 0xF;
+        default: return -1;
+    }
+}
+
+/**
+ * Numerische Funktionscodes senden BCD (4 Bit je Zeichen), die übrigen 7-Bit-ASCII.
+ */
+static int isNumeric(FunctionCode functionCode) {
+    return functionCode == FUNC_NUMERIC_1 || functionCode == FUNC_NUMERIC_2;
+}
+
+static uint32_t bitsPerChar(FunctionCode functionCode) {
+    return isNumeric(functionCode) ? NUMERIC_BITS_PER_CHAR : TEXT_BITS_PER_CHAR;
+}
+
+/**
+ * Schreibt ein Nachrichtenwort (20 Datenbits) und nach einem vollen Batch das SYNC-Wort.
+ */
+static uint32_t* putMessageWord(uint32_t* out, uint32_t data, uint32_t* wordPosition) {
+    *out++ = encodeCodeword(data | FLAG_MESSAGE);
+    if (++*wordPosition == BATCH_SIZE) {
+        // Batch ist voll, füge SYNC-Wort ein
+        *out++ = SYNC;
+        *wordPosition = 0; // Beginne neuen Batch bei Position 0 (nach SYNC)
+    }
+    return out;
+}
+
 /**
  * Kodiert eine Zeichenkette (string) als eine Reihe von Codewörtern.
+ * ASCII: 7 Bit je Zeichen, das letzte Wort wird mit Nullen aufgefüllt.
+ * Numerisch: 4 Bit BCD je Zeichen, das letzte Wort wird mit Leerzeichen aufgefüllt.
+ * Die Zeichen (LSB zuerst, daher bitumgekehrt) laufen durch ein 64-Bit-
+ * Schieberegister, aus dem je 20 Bits ein Wort ergeben.
  * Gibt die Anzahl der geschriebenen Codewörter zurück.
  */
-static uint32_t encodeASCII(uint32_t initial_offset, const char* str, uint32_t* out) {
-    uint32_t numWordsWritten = 0;
-    uint32_t currentWord = 0;
-    uint32_t currentNumBits = 0;
+static uint32_t encodeText(uint32_t initial_offset, const char* str, uint32_t* out, int numeric) {
+    uint32_t* start = out;
     uint32_t wordPosition = initial_offset; // Position im aktuellen Batch (0-15)
+    uint64_t shiftRegister = 0;
+    uint32_t numBits = 0;                   // Noch nicht ausgegebene Bits im Register
+
+    for (; *str != 0; str++) {
+        if (numeric) {
+            shiftRegister = (shiftRegister << NUMERIC_BITS_PER_CHAR) | reverse4[numericCode(*str) & 0xF];
+            numBits += NUMERIC_BITS_PER_CHAR;
+        } else {
+            shiftRegister = (shiftRegister << TEXT_BITS_PER_CHAR) | reverse7[(unsigned char) *str & 0x7F];
+            numBits += TEXT_BITS_PER_CHAR;
+        }
 
-    while (*str != 0) {
-        unsigned char c = *str;
-        str++;
-
-        // Kodiert die 7 Zeichenbits LSB zuerst
-        for (int i = 0; i < TEXT_BITS_PER_CHAR; i++) {
-            currentWord <<= 1;
-            currentWord |= (c >> i) & 1;
-            currentNumBits++;
-
-            if (currentNumBits == TEXT_BITS_PER_WORD) {
-                // Word ist voll (20 Bits)
-                *out = encodeCodeword(currentWord | FLAG_MESSAGE);
-                out++;
-                numWordsWritten++;
-
-                currentWord = 0;
-                currentNumBits = 0;
-
-                wordPosition++;
-                if (wordPosition == BATCH_SIZE) {
-                    // Batch ist voll, füge SYNC-Wort ein
-                    *out = SYNC;
-                    out++;
-                    numWordsWritten++;
-                    wordPosition = 0; // Beginne neuen Batch bei Position 0 (nach SYNC)
-                }
-            }
+        if (numBits >= TEXT_BITS_PER_WORD) {
+            numBits -= TEXT_BITS_PER_WORD;
+            out = putMessageWord(out, (uint32_t)(shiftRegister >> numBits) & 0xFFFFF, &wordPosition);
         }
     }
 
     // Schreibe das letzte, unvollständige Wort (wenn vorhanden)
-    if (currentNumBits > 0) {
-        // Fülle das Wort mit Nullen auf 20 Bits auf
-        currentWord <<= 20 - currentNumBits;
-        *out = encodeCodeword(currentWord | FLAG_MESSAGE);
-        out++;
-        numWordsWritten++;
-        wordPosition++;
+    if (numBits > 0) {
+        uint32_t data = (uint32_t)(shiftRegister << (TEXT_BITS_PER_WORD - numBits)) & 0xFFFFF;
+        if (numeric) {
+            // Mit Leerzeichen (0xC, bitumgekehrt 0x3) auf 20 Bits auffüllen
+            for (uint32_t bits = numBits; bits < TEXT_BITS_PER_WORD; bits += NUMERIC_BITS_PER_CHAR) {
+                data |= (uint32_t) reverse4[0xC] << (TEXT_BITS_PER_WORD - NUMERIC_BITS_PER_CHAR - bits);
+            }
+        }
+        out = putMessageWord(out, data, &wordPosition);
     }
 
-    return numWordsWritten;
+    return (uint32_t)(out - start);
 }
 
 
@@ -128,11 +219,24 @@ static uint32_t encodeASCII(uint32_t initial_offset, const char* str, uint32_t*
 // ÖFFENTLICHE FUNKTIONEN
 // =========================================================
 
+/**
+ * @brief Kodiert 21 Datenbits zu einem Codewort (BCH-Prüfbits und Parität).
+ */
+uint32_t pocsag_encodeCodeword(uint32_t data) {
+    return encodeCodeword(data);
+}
+
+/**
+ * @brief Prüft, ob ein Zeichen im numerischen Zeichensatz liegt.
+ */
+int pocsag_isNumericChar(char c) {
+    return numericCode(c) >= 0;
+}
+
 /**
  * @brief Berechnet die Gesamtlänge der POCSAG-Übertragung in 32-Bit-Wörtern.
  */
 size_t pocsag_messageLength(uint32_t address, size_t numChars, FunctionCode functionCode) {
-    (void)functionCode;
     size_t numWords = 0;
 
     // 1. Präambel
@@ -148,27 +252,22 @@ size_t pocsag_messageLength(uint32_t address, size_t numChars, FunctionCode func
     numWords++;
 
     // 5. Nachrichtenwörter
-    size_t numMessageWords = (numChars * TEXT_BITS_PER_CHAR + (TEXT_BITS_PER_WORD - 1))
+    size_t numMessageWords = (numChars * bitsPerChar(functionCode) + (TEXT_BITS_PER_WORD - 1))
                                  / TEXT_BITS_PER_WORD;
     numWords += numMessageWords;
 
     // 6. Leerlaufwort, das das Ende der Nachricht darstellt
     numWords++;
     
-    // 7. SYNC-Wörter und Padding zur Auffüllung des letzten Batches
-    size_t contentWords = numWords - (PREAMBLE_LENGTH / 32); 
+    // 7. SYNC-Wörter und Padding: jeder Batch besteht aus SYNC + 16 Wörtern.
+    // Ohne das erste SYNC-Wort zählen alle übrigen Inhaltswörter, auch die
+    // SYNC-Wörter innerhalb langer Nachrichten müssen berücksichtigt werden.
+    size_t contentWords = numWords - (PREAMBLE_LENGTH / 32) - 1;
+    size_t numBatches = (contentWords + BATCH_SIZE - 1) / BATCH_SIZE;
 
     size_t wordsPerBatch = BATCH_SIZE + 1; // 17
     
-    size_t contentWordsWritten = contentWords;
-    
-    size_t remainder = contentWordsWritten % wordsPerBatch;
-
-    if (remainder != 0) {
-        numWords += wordsPerBatch - remainder;
-    }
-    
-    return numWords;
+    return (PREAMBLE_LENGTH / 32) + numBatches * wordsPerBatch;
 }
 
 /**
@@ -180,6 +279,89 @@ void pocsag_encodeTransmission(
     uint32_t* out,
     FunctionCode functionCode
 ) {
+    // Eine Übertragung mit einer einzigen Seite: identisch zu pocsag_encodePages()
+    pocsag_page page = { address, functionCode, message };
+    size_t order = 0;
+    pocsag_encodePages(&page, &order, 1, out);
+}
+
+// =========================================================
+// MEHRERE SEITEN JE ÜBERTRAGUNG
+// =========================================================
+
+/**
+ * Anzahl der Nachrichtenwörter einer Seite (ohne SYNC-Wörter).
+ */
+static size_t pageMessageWords(const pocsag_page* page) {
+    return (strlen(page->message) * bitsPerChar(page->functionCode) + (TEXT_BITS_PER_WORD - 1))
+               / TEXT_BITS_PER_WORD;
+}
+
+/**
+ * Anzahl der IDLE-Wörter, bis an Position position (0-15 im Batch) ein Wort
+ * des Frames (address & 7) beginnt. Beide Wörter des Frames sind erlaubt.
+ */
+static uint32_t slotWait(uint32_t position, uint32_t address) {
+    uint32_t frameStart = addressOffset(address);
+    if (position == frameStart || position == frameStart + 1) {
+        return 0;
+    }
+    return (frameStart + BATCH_SIZE - position) % BATCH_SIZE;
+}
+
+/**
+ * @brief Legt die Sendereihenfolge fest und berechnet die Länge der Übertragung.
+ */
+size_t pocsag_planPages(const pocsag_page* pages, size_t count, size_t* order) {
+    // Je Frame die nächste noch nicht eingeplante Seite (Warteschlange je Frame,
+    // innerhalb eines Frames bleibt die Eingabereihenfolge erhalten)
+    size_t next[8];
+    for (uint32_t frame = 0; frame < 8; frame++) {
+        next[frame] = 0;
+        while (next[frame] < count && (pages[next[frame]].address & 0x7) != frame) {
+            next[frame]++;
+        }
+    }
+
+    uint32_t position = 0;    // Position des nächsten Inhaltsworts im Batch
+    size_t contentWords = 0;  // Inhaltswörter ohne SYNC
+
+    for (size_t n = 0; n < count; n++) {
+        // Gierig: die Seite, deren Frame als nächstes erreicht wird (geringste Füllung)
+        uint32_t best = 8;
+        uint32_t bestWait = BATCH_SIZE;
+        for (uint32_t frame = 0; frame < 8; frame++) {
+            if (next[frame] < count) {
+                uint32_t wait = slotWait(position, (uint32_t) frame);
+                if (wait < bestWait) {
+                    best = frame;
+                    bestWait = wait;
+                }
+            }
+        }
+
+        size_t index = next[best];
+        order[n] = index;
+        do {
+            next[best]++;
+        } while (next[best] < count && (pages[next[best]].address & 0x7) != best);
+
+        size_t words = bestWait + 1 + pageMessageWords(&pages[index]);
+        contentWords += words;
+        position = (uint32_t)((position + words) % BATCH_SIZE);
+    }
+
+    // Abschließendes IDLE-Wort (Ende der letzten Nachricht)
+    contentWords++;
+
+    size_t numBatches = (contentWords + BATCH_SIZE - 1) / BATCH_SIZE;
+    return (PREAMBLE_LENGTH / 32) + numBatches * (BATCH_SIZE + 1);
+}
+
+/**
+ * @brief Kodiert mehrere Seiten in einer Übertragung mit einer Präambel.
+ */
+void pocsag_encodePages(const pocsag_page* pages, const size_t* order, size_t count, uint32_t* out) {
     // Kodiert die Präambel (alternierende 1, 0, 1, 0...)
     for (int i = 0; i < PREAMBLE_LENGTH / 32; i++) {
         *out = 0xAAAAAAAA;
@@ -189,31 +371,48 @@ void pocsag_encodeTransmission(
     // Startzeiger (nach der Präambel)
     uint32_t* batchStart = out;
 
-    // 1. Sync-Wort (Beginn des ersten Batches)
+    // Sync-Wort (Beginn des ersten Batches)
     *out = SYNC;
     out++;
+    uint32_t position = 0;
 
-    // 2. Füllung (Padding) vor dem Adresswort
-    int prefixLength = addressOffset(address);
-    for (int i = 0; i < prefixLength; i++) {
-        *out = IDLE;
-        out++;
-    }
+    for (size_t n = 0; n < count; n++) {
+        const pocsag_page* page = &pages[order[n]];
 
-    // 3. Adresswort
-    uint32_t addressData = ((address >> 3) << 2) | functionCode;
-    *out = encodeCodeword(addressData);
-    out++;
+        // 1. Füllung bis zum Frame der Adresse
+        for (uint32_t i = slotWait(position, page->address); i > 0; i--) {
+            *out = IDLE;
+            out++;
+            position++;
+            if (position == BATCH_SIZE) {
+                *out = SYNC;
+                out++;
+                position = 0;
+            }
+        }
 
-    // 4. Nachrichtenwörter
-    out += encodeASCII( (addressOffset(address) + 1) % BATCH_SIZE, message, out);
+        // 2. Adresswort
+        uint32_t addressData = ((page->address >> 3) << 2) | page->functionCode;
+        *out = encodeCodeword(addressData);
+        out++;
+        position++;
+        if (position == BATCH_SIZE) {
+            *out = SYNC;
+            out++;
+            position = 0;
+        }
 
+        // 3. Nachrichtenwörter (direkt anschließend; die nächste Adresse beendet die Nachricht)
+        size_t written = encodeText(position, page->message, out, isNumeric(page->functionCode));
+        out += written;
+        position = (uint32_t)((position + pageMessageWords(page)) % BATCH_SIZE);
+    }
 
-    // 5. Abschließendes IDLE-Wort (Ende der Nachricht)
+    // 4. Abschließendes IDLE-Wort (Ende der Nachricht)
     *out = IDLE;
     out++;
-    
-    // 6. Padding, um den letzten Batch abzuschließen
+
+    // 5. Padding, um den letzten Batch abzuschließen
     size_t contentWordsWritten = out - batchStart;
     size_t wordsPerBatch = BATCH_SIZE + 1; // 17
 
@@ -226,4 +425,4 @@ void pocsag_encodeTransmission(
             out++;
         }
     }
-}
\ No newline at end of file
+}
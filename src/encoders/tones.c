@@ -1,10 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 #include <unistd.h>
 
 #include "../../include/signal_generator.h"
+#include "../../include/oscillator.h"
+#include "../../include/kernels.h"
 #include "../../include/encoders/tones.h"
 
 // DTMF-Frequenzen (Hz) nach ITU-T Q.23
@@ -20,96 +21,191 @@
 #define F_HIGH_3 1477.0
 #define F_HIGH_4 1633.0
 
+static const double dtmf_low[4] = { F_LOW_1, F_LOW_2, F_LOW_3, F_LOW_4 };
+static const double dtmf_high[4] = { F_HIGH_1, F_HIGH_2, F_HIGH_3, F_HIGH_4 };
+
 /**
- * @brief Holt die DTMF-Frequenzen für eine gegebene Ziffer/Zeichen.
+ * @brief Liefert den Index (Reihe * 4 + Spalte) für eine gegebene Ziffer/Zeichen.
  * @param digit Die DTMF-Ziffer (0-9, *, #, A-D).
- * @param f_low Zeiger auf die niedrige Frequenz.
- * @param f_high Zeiger auf die hohe Frequenz.
- * @return 0 bei Erfolg, 1 bei ungültigem Zeichen.
+ * @return 0-15 bei Erfolg, -1 bei ungültigem Zeichen.
  */
-static int get_dtmf_frequencies(char digit, double *f_low, double *f_high) {
+static int get_dtmf_index(char digit) {
     switch (digit) {
-        case '1': *f_low = F_LOW_1; *f_high = F_HIGH_1; break;
-        case '2': *f_low = F_LOW_1; *f_high = F_HIGH_2; break;
-        case '3': *f_low = F_LOW_1; *f_high = F_HIGH_3; break;
-        case 'A': case 'a': *f_low = F_LOW_1; *f_high = F_HIGH_4; break;
-
-        case '4': *f_low = F_LOW_2; *f_high = F_HIGH_1; break;
-        case '5': *f_low = F_LOW_2; *f_high = F_HIGH_2; break;
-        case '6': *f_low = F_LOW_2; *f_high = F_HIGH_3; break;
-        case 'B': case 'b': *f_low = F_LOW_2; *f_high = F_HIGH_4; break;
-
-        case '7': *f_low = F_LOW_3; *f_high = F_HIGH_1; break;
-        case '8': *f_low = F_LOW_3; *f_high = F_HIGH_2; break;
-        case '9': *f_low = F_LOW_3; *f_high = F_HIGH_3; break;
-        case 'C': case 'c': *f_low = F_LOW_3; *f_high = F_HIGH_4; break;
-
-        case '*': *f_low = F_LOW_4; *f_high = F_HIGH_1; break;
-        case '0': *f_low = F_LOW_4; *f_high = F_HIGH_2; break;
-        case '#': *f_low = F_LOW_4; *f_high = F_HIGH_3; break;
-        case 'D': case 'd': *f_low = F_LOW_4; *f_high = F_HIGH_4; break;
-        
+        case '1': return 0;
+        case '2': return 1;
+        case '3': return 2;
+        case 'A': case 'a': return 3;
+
+        case '4': return 4;
+        case '5': return 5;
+        case '6': return 6;
+        case 'B': case 'b': return 7;
+
+        case '7': return 8;
+        case '8': return 9;
+        case '9': return 10;
+        case 'C': case 'c': return 11;
+
+        case '*': return 12;
+        case '0': return 13;
+        case '#': return 14;
+        case 'D': case 'd': return 15;
+
         default:
-            return 1; // Unbekanntes Zeichen
+            return -1; // Unbekanntes Zeichen
     }
-    return 0;
 }
 
 /**
- * @brief Schreibt ein 16-bit Sample im Little-Endian-Format an stdout.
+ * @brief Rendert count Samples eines Zweitons in out (scratch: Hilfspuffer gleicher Größe).
+ * * DTMF: Die Samples werden addiert und auf die Hälfte skaliert, um Clipping zu vermeiden.
  */
-static void write_sample(int16_t sample) {
-    uint8_t output[2];
-    // Little-Endian-Format: Low Byte zuerst
-    output[0] = (uint8_t)(sample & 0xFF);       
-    output[1] = (uint8_t)((sample >> 8) & 0xFF); 
-    fwrite(output, 1, 2, stdout);
+static void render_dual_tone(const rs_kernel_table* kernels, rs_oscillator* osc_low, rs_oscillator* osc_high,
+                             int16_t* out, int16_t* scratch, size_t count) {
+    rs_osc_render(osc_low, out, count);
+    rs_osc_render(osc_high, scratch, count);
+    kernels->mix_avg(out, out, scratch, count);
 }
 
 /**
- * @brief Codiert und sendet eine Sequenz von DTMF-Tönen (Dual-Tone Multi-Frequency).
- * * Die Funktion generiert die Audiosignale für DTMF-Ziffern und gibt sie als
- * Raw-Audio-Daten an stdout aus.
+ * @brief Liefert die zwischengespeicherte Wellenform einer Ziffer (rendert sie beim ersten Mal).
+ * @return Zeiger auf tone_samples Samples oder NULL, wenn nicht zwischengespeichert werden kann.
  */
-int rs_encode_dtmf(const char *digits, int tone_duration_ms, int pause_duration_ms) {
+static const int16_t* cached_digit(rs_dtmf_cache* cache, const rs_kernel_table* kernels,
+                                   int index, size_t tone_samples) {
+    if (cache == NULL || tone_samples == 0 || tone_samples > RS_DTMF_CACHE_MAX_SAMPLES) {
+        return NULL;
+    }
+
+    // Andere Tondauer: alle Wellenformen verwerfen, Speicher nur vergrößern
+    if (cache->toneSamples != tone_samples) {
+        size_t required = tone_samples * RS_DTMF_DIGITS;
+        if (required > cache->capacity) {
+            int16_t* grown = (int16_t*) realloc(cache->pcm, required * sizeof(int16_t));
+            if (grown == NULL) {
+                return NULL;
+            }
+            cache->pcm = grown;
+            cache->capacity = required;
+        }
+        cache->toneSamples = tone_samples;
+        cache->ready = 0;
+    }
+
+    int16_t* waveform = cache->pcm + (size_t)index * tone_samples;
+    if (!(cache->ready & (1u << index))) {
+        rs_oscillator osc_low;
+        rs_oscillator osc_high;
+        rs_osc_init(&osc_low, dtmf_low[index / 4], SAMPLE_RATE, 1);
+        rs_osc_init(&osc_high, dtmf_high[index % 4], SAMPLE_RATE, 1);
+
+        int16_t scratch[PCM_BLOCK_SAMPLES];
+        for (size_t done = 0; done < tone_samples; ) {
+            size_t n = tone_samples - done;
+            if (n > PCM_BLOCK_SAMPLES) n = PCM_BLOCK_SAMPLES;
+            render_dual_tone(kernels, &osc_low, &osc_high, waveform + done, scratch, n);
+            done += n;
+        }
+        cache->ready |= 1u << index;
+    }
+    return waveform;
+}
+
+/**
+ * @brief Bereitet eine DTMF-Sequenz vor (noch keine Ausgabe).
+ */
+void rs_dtmf_init(rs_dtmf_stream* stream, rs_sink* sink, const char* digits,
+                  int tone_duration_ms, int pause_duration_ms, rs_dtmf_cache* cache) {
     uint32_t sample_rate = SAMPLE_RATE;
-    
+
     // Berechne die Anzahl der Samples für Ton und Pause
-    size_t tone_samples = (size_t)((double)tone_duration_ms * sample_rate / 1000.0);
-    size_t pause_samples = (size_t)((double)pause_duration_ms * sample_rate / 1000.0);
-    
-    // Verfolgt den globalen Zeitindex für die Sinusberechnung
-    size_t overall_time_index = 0; 
+    stream->toneSamples = (size_t)((uint64_t)tone_duration_ms * sample_rate / 1000);
+    stream->pauseSamples = (size_t)((uint64_t)pause_duration_ms * sample_rate / 1000);
 
-    for (const char *p = digits; *p != '\0'; p++) {
-        char digit = *p;
-        double f_low, f_high;
+    stream->sink = sink;
+    stream->kernels = rs_kernels();
+    stream->cache = cache;
+    stream->next = digits;
+    stream->part = RS_DTMF_NEXT_DIGIT;
+    stream->offset = 0;
+    stream->waveform = NULL;
+}
 
-        if (get_dtmf_frequencies(digit, &f_low, &f_high) != 0) {
+/**
+ * @brief Schreibt den nächsten Abschnitt (höchstens PCM_BLOCK_SAMPLES Samples) in den Sink.
+ */
+int rs_dtmf_step(rs_dtmf_stream* stream) {
+    rs_sink* sink = stream->sink;
+
+    while (stream->part == RS_DTMF_NEXT_DIGIT) {
+        if (*stream->next == '\0' || sink->error != 0) {
+            return 0;
+        }
+        char digit = *stream->next++;
+
+        int index = get_dtmf_index(digit);
+        if (index < 0) {
             fprintf(stderr, "Fehler: Unbekannte DTMF-Ziffer '%c' übersprungen.\n", digit);
-            continue; 
+            continue;
         }
 
         // --- 1. TONGENERIERUNG ---
-        for (size_t i = 0; i < tone_samples; i++) {
-            
-            // Generiere Samples für beide Frequenzen
-            int16_t sample_low = rs_generate_tone_sample(f_low, overall_time_index, sample_rate);
-            int16_t sample_high = rs_generate_tone_sample(f_high, overall_time_index, sample_rate);
-            
-            // DTMF: Die Samples werden addiert und auf die Hälfte skaliert, um Clipping zu vermeiden.
-            int16_t combined_sample = (int16_t)((sample_low + sample_high) / 2);
-            
-            write_sample(combined_sample);
-            overall_time_index++;
+        // Jeder Ton beginnt mit Phase 0, daher ist die Wellenform je Ziffer immer gleich;
+        // ohne Cache (oder bei sehr langen Tönen) wird blockweise gerendert
+        stream->waveform = cached_digit(stream->cache, stream->kernels, index, stream->toneSamples);
+        if (stream->waveform == NULL) {
+            rs_osc_init(&stream->oscLow, dtmf_low[index / 4], SAMPLE_RATE, 1);
+            rs_osc_init(&stream->oscHigh, dtmf_high[index % 4], SAMPLE_RATE, 1);
         }
+        stream->part = RS_DTMF_TONE;
+        stream->offset = 0;
+    }
+
+    size_t length = (stream->part == RS_DTMF_TONE) ? stream->toneSamples : stream->pauseSamples;
+    size_t n = length - stream->offset;
+    if (n > PCM_BLOCK_SAMPLES) n = PCM_BLOCK_SAMPLES;
 
+    if (stream->part == RS_DTMF_PAUSE) {
         // --- 2. PAUSENGENERIERUNG ---
-        for (size_t i = 0; i < pause_samples; i++) {
-            write_sample(0);
-            overall_time_index++;
-        }
+        rs_sink_write_silence(sink, n);
+    } else if (stream->waveform != NULL) {
+        rs_sink_write(sink, stream->waveform + stream->offset, n);
+    } else {
+        int16_t block[PCM_BLOCK_SAMPLES];
+        int16_t scratch[PCM_BLOCK_SAMPLES];
+        render_dual_tone(stream->kernels, &stream->oscLow, &stream->oscHigh, block, scratch, n);
+        rs_sink_write(sink, block, n);
+    }
+
+    stream->offset += n;
+    if (stream->offset == length) {
+        stream->part = (stream->part == RS_DTMF_TONE) ? RS_DTMF_PAUSE : RS_DTMF_NEXT_DIGIT;
+        stream->offset = 0;
+    }
+    return sink->error == 0;
+}
+
+/**
+ * @brief Codiert und sendet eine Sequenz von DTMF-Tönen (Dual-Tone Multi-Frequency).
+ * * Die Funktion generiert die Audiosignale für DTMF-Ziffern und gibt sie als
+ * Raw-Audio-Daten über den Sink aus.
+ */
+int rs_encode_dtmf(rs_sink* sink, const char *digits, int tone_duration_ms, int pause_duration_ms,
+                   rs_dtmf_cache* cache) {
+    rs_dtmf_stream stream;
+    rs_dtmf_init(&stream, sink, digits, tone_duration_ms, pause_duration_ms, cache);
+
+    while (rs_dtmf_step(&stream)) {
     }
-    
-    return 0;
-}
\ No newline at end of file
+
+    // Abbruch, falls die Ausgabe fehlgeschlagen ist (z.B. EPIPE)
+    return (sink->error == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Gibt den Speicher des Wellenform-Caches frei.
+ */
+void rs_dtmf_cache_free(rs_dtmf_cache* cache) {
+    free(cache->pcm);
+    memset(cache, 0, sizeof(*cache));
+}
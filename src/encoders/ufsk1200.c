@@ -2,55 +2,74 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
-#include <math.h>
+#include <pthread.h>
 
 #include "../../include/signal_generator.h"
+#include "../../include/fsk.h"
 #include "../../include/encoders/ufsk1200.h"
 
-#define SAMPLES_PER_BIT (SAMPLE_RATE / UFSK1200_BAUD_RATE)
-#define MAX_AMPLITUDE MAX_PCM_VALUE
 
-static double current_phase = 0.0;
+// Symboltabelle: einmal je Prozess gerendert, danach nur gelesen
+static int16_t symbol_blocks[RS_FSK_TABLE_SAMPLES(SAMPLE_RATE, UFSK1200_BAUD_RATE)];
+static rs_fsk_table symbol_table;
+static pthread_once_t symbol_once = PTHREAD_ONCE_INIT;
+
+static void init_symbol_table(void) {
+    // Feste Parameter (18.375 Samples je Bit), die Prüfung kann nicht fehlschlagen
+    (void)rs_fsk_table_init(&symbol_table, symbol_blocks, UFSK1200_MARK_FREQ, UFSK1200_SPACE_FREQ,
+                            UFSK1200_BAUD_RATE, SAMPLE_RATE);
+}
 
 /**
- * @brief Sendet ein einzelnes Bit mit FSK-Modulation.
+ * @brief Sendet ein Byte Bit für Bit (LSB zuerst).
  */
-static void emit_bit(int bit) {
-    double freq = bit ? UFSK1200_MARK_FREQ : UFSK1200_SPACE_FREQ;
-    double phase_step = 2.0 * M_PI * freq / SAMPLE_RATE;
-    
-    for (int i = 0; i < SAMPLES_PER_BIT; i++) {
-        int16_t sample = (int16_t)(MAX_AMPLITUDE * sin(current_phase));
-        fwrite(&sample, sizeof(int16_t), 1, stdout);
-        current_phase += phase_step;
-        if (current_phase >= 2.0 * M_PI) current_phase -= 2.0 * M_PI;
-    }
+static void emit_byte(rs_fsk_modulator* mod, uint8_t byte) {
+    rs_fsk_symbols(mod, byte, 8);
 }
 
 /**
- * @brief Sendet ein Byte Bit für Bit (LSB zuerst).
+ * @brief Bereitet eine Übertragung vor (noch keine Ausgabe).
  */
-static void emit_byte(uint8_t byte) {
-    for (int i = 0; i < 8; i++) {
-        emit_bit((byte >> i) & 1);
-    }
+int rs_ufsk1200_init(rs_ufsk1200_stream* stream, rs_sink* sink, const char* message) {
+    pthread_once(&symbol_once, init_symbol_table);
+    rs_fsk_init(&stream->mod, &symbol_table, sink);
+    stream->message = message;
+    stream->length = strlen(message);
+    stream->position = 0;
+    stream->preambleSent = 0;
+    return (stream->length == 0) ? 1 : 0;
 }
 
-int rs_encode_ufsk1200(const char* message) {
-    current_phase = 0.0;
-    
-    size_t msg_len = strlen(message);
-    if (msg_len == 0) return 1;
-    
-    // Preamble: alternating 0/1 for synchronization (20 bits)
-    for (int i = 0; i < 20; i++) {
-        emit_bit(i % 2);
+/**
+ * @brief Schreibt den nächsten Abschnitt in den Sink.
+ */
+int rs_ufsk1200_step(rs_ufsk1200_stream* stream) {
+    if (!stream->preambleSent) {
+        // Preamble: alternating 0/1 for synchronization (20 bits)
+        rs_fsk_symbols(&stream->mod, 0xAAAAA, 20);
+        stream->preambleSent = 1;
+    } else {
+        // Message bytes
+        size_t end = stream->position + UFSK1200_STEP_BYTES;
+        if (end > stream->length) {
+            end = stream->length;
+        }
+        for (; stream->position < end; stream->position++) {
+            emit_byte(&stream->mod, (uint8_t)stream->message[stream->position]);
+        }
     }
-    
-    // Message bytes
-    for (size_t i = 0; i < msg_len; i++) {
-        emit_byte((uint8_t)message[i]);
+
+    rs_fsk_flush(&stream->mod);
+    return stream->position < stream->length && stream->mod.sink->error == 0;
+}
+
+int rs_encode_ufsk1200(rs_sink* sink, const char* message) {
+    rs_ufsk1200_stream stream;
+    if (rs_ufsk1200_init(&stream, sink, message) != 0) return 1;
+
+    while (rs_ufsk1200_step(&stream)) {
     }
-    
-    return 0;
+
+    // Abbruch, falls die Ausgabe fehlgeschlagen ist (z.B. EPIPE)
+    return (sink->error == 0) ? 0 : 1;
 }
@@ -0,0 +1,63 @@
+#include <string.h>
+
+#include "../include/fsk.h"
+#include "../include/oscillator.h"
+
+/**
+ * @brief Rendert die Symbolblöcke für zwei Töne in storage.
+ * * Jeder Block beginnt exakt auf seiner Phasenstufe und läuft mit dem
+ * interpolierenden NCO, wie es die Encoder vorher Sample für Sample taten.
+ * Blöcke enthalten das längste Symbol; kürzere nutzen nur den Anfang.
+ */
+int rs_fsk_table_init(rs_fsk_table* table, int16_t* storage, double mark, double space,
+                      uint32_t baud, uint32_t sampleRate) {
+    if (baud == 0 || baud > sampleRate || RS_FSK_SYMBOL_MAX(sampleRate, baud) > RS_FSK_BUFFER_SAMPLES) {
+        return 1;
+    }
+
+    size_t maxSamples = RS_FSK_SYMBOL_MAX(sampleRate, baud);
+    table->samplesPerSymbol = sampleRate / baud;
+    table->remainder = sampleRate % baud;
+    table->baud = baud;
+    table->stride = RS_FSK_STRIDE(maxSamples);
+    table->blocks = storage;
+
+    table->increment[0] = rs_osc_increment(space, sampleRate);
+    table->increment[1] = rs_osc_increment(mark, sampleRate);
+
+    for (int tone = 0; tone < 2; tone++) {
+        uint32_t inc = table->increment[tone];
+        table->advance[tone] = (uint32_t)(inc * (uint64_t)table->samplesPerSymbol);
+
+        for (uint32_t bucket = 0; bucket < RS_FSK_PHASE_BUCKETS; bucket++) {
+            int16_t* block = storage + ((size_t)tone * RS_FSK_PHASE_BUCKETS + bucket) * table->stride;
+            rs_oscillator osc = { bucket << RS_FSK_BUCKET_SHIFT, inc, 1 };
+            rs_osc_render(&osc, block, maxSamples);
+            memset(block + maxSamples, 0, (table->stride - maxSamples) * sizeof(int16_t));
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Startet einen Modulator mit Phase 0, der in sink schreibt.
+ */
+void rs_fsk_init(rs_fsk_modulator* mod, const rs_fsk_table* table, rs_sink* sink) {
+    mod->table = table;
+    mod->sink = sink;
+    mod->phase = 0;
+    mod->clock = 0;
+    mod->fill = 0;
+}
+
+/**
+ * @brief Gibt die gepufferten Samples an den Sink weiter.
+ */
+int rs_fsk_flush(rs_fsk_modulator* mod) {
+    int result = 0;
+    if (mod->fill > 0) {
+        result = rs_sink_write(mod->sink, mod->buffer, mod->fill);
+        mod->fill = 0;
+    }
+    return result;
+}
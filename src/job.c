@@ -0,0 +1,822 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <strings.h>
+
+#include "../include/job.h"
+#include "../include/cache.h"
+#include "../include/signal_generator.h"
+#include "../include/encoders/pocsag.h"
+#include "../include/encoders/tones.h"
+#include "../include/encoders/morse.h"
+#include "../include/encoders/afsk1200.h"
+#include "../include/encoders/fsk9600.h"
+#include "../include/encoders/ufsk1200.h"
+
+// Standardwerte
+#define MAX_DELAY 10 // Sekunden
+#define MIN_DELAY 1 // Sekunden
+#define DTMF_TONE_MS 50
+#define DTMF_PAUSE_MS 50
+#define MORSE_WPM_DEFAULT 20
+#define MAX_REPEAT 10000
+#define MAX_INTERVAL_S 86400 // Sekunden
+
+#define INFO(job, ...) do { if (!(job)->quiet) fprintf(stderr, __VA_ARGS__); } while (0)
+
+/**
+ * @brief Wertet nur die Optionen am Anfang von argv aus.
+ */
+int rs_job_parse_options(rs_job* job, int argc, char** argv) {
+  int consumed = 0;
+
+  while (argc > 0 && argv[0][0] == '-' && argv[0][1] != '\0') {
+    if (strcmp(argv[0], "-r") == 0 && argc > 1) {
+      job->outputRate = (uint32_t) strtol(argv[1], NULL, 10);
+      if (job->outputRate < 1000 || job->outputRate > 384000) {
+        fprintf(stderr, "Fehler: Ungültige Ausgabe-Abtastrate. Erlaubt: 1000-384000 Hz.\n");
+        return -1;
+      }
+      argv += 2;
+      argc -= 2;
+      consumed += 2;
+    } else if (strcmp(argv[0], "-L") == 0 || strcmp(argv[0], "-B") == 0) {
+      job->order = (argv[0][1] == 'B') ? RS_BYTE_ORDER_BE : RS_BYTE_ORDER_LE;
+      argv++;
+      argc--;
+      consumed++;
+    } else if (strcmp(argv[0], "-o") == 0 && argc > 1) {
+      job->outputPath = argv[1];
+      argv += 2;
+      argc -= 2;
+      consumed += 2;
+    } else if (strcmp(argv[0], "--repeat") == 0 && argc > 1) {
+      long repeat = strtol(argv[1], NULL, 10);
+      if (repeat < 1 || repeat > MAX_REPEAT) {
+        fprintf(stderr, "Fehler: Ungültige Wiederholungsanzahl. Erlaubt: 1-%d.\n", MAX_REPEAT);
+        return -1;
+      }
+      job->repeat = (unsigned int) repeat;
+      argv += 2;
+      argc -= 2;
+      consumed += 2;
+    } else if (strcmp(argv[0], "--interval") == 0 && argc > 1) {
+      double seconds = strtod(argv[1], NULL);
+      if (!(seconds >= 0.0 && seconds <= MAX_INTERVAL_S)) {
+        fprintf(stderr, "Fehler: Ungültiges Intervall. Erlaubt: 0-%d s.\n", MAX_INTERVAL_S);
+        return -1;
+      }
+      job->intervalMs = (uint32_t) (seconds * 1000.0 + 0.5);
+      argv += 2;
+      argc -= 2;
+      consumed += 2;
+    } else if (strcmp(argv[0], "--cache") == 0 && argc > 1) {
+      job->cacheDir = argv[1];
+      argv += 2;
+      argc -= 2;
+      consumed += 2;
+    } else {
+      fprintf(stderr, "Fehler: Unbekannte Option '%s'.\n", argv[0]);
+      return -1;
+    }
+  }
+  return consumed;
+}
+
+/**
+ * @brief Wertet Optionen und Modulator aus argv aus (ohne Programmnamen).
+ */
+int rs_job_parse(rs_job* job, int argc, char** argv) {
+  int consumed = rs_job_parse_options(job, argc, argv);
+  if (consumed < 0) {
+    return RS_JOB_INVALID;
+  }
+  argc -= consumed;
+  argv += consumed;
+
+  if (argc < 2) {
+    fprintf(stderr, "Fehler: Modulator und Parameter fehlen.\n");
+    return RS_JOB_INVALID;
+  }
+
+  job->argc = argc;
+  job->argv = argv;
+  return RS_JOB_OK;
+}
+
+/**
+ * @brief Zerlegt eine Jobzeile in Argumente (in-place).
+ */
+int rs_job_split_line(char* line, char** argv, int maxArgs) {
+  char* src = line;
+  int argc = 0;
+
+  for (;;) {
+    while (*src == ' ' || *src == '\t' || *src == '\r' || *src == '\n') {
+      src++;
+    }
+    if (*src == '\0' || (argc == 0 && *src == '#')) {
+      return argc;
+    }
+    if (argc == maxArgs) {
+      fprintf(stderr, "Fehler: Zu viele Argumente (max. %d).\n", maxArgs);
+      return -1;
+    }
+
+    // Argument in-place zusammensetzen: dst läuft nie vor src
+    char* dst = src;
+    argv[argc++] = dst;
+    char quote = '\0';
+
+    while (*src != '\0') {
+      char c = *src;
+      if (quote == '\0' && (c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+        break;
+      }
+      src++;
+      if (c == '\\' && *src != '\0' && quote != '\'') {
+        *dst++ = *src++;
+      } else if (quote == '\0' && (c == '\'' || c == '"')) {
+        quote = c;
+      } else if (c == quote) {
+        quote = '\0';
+      } else {
+        *dst++ = c;
+      }
+    }
+
+    if (quote != '\0') {
+      fprintf(stderr, "Fehler: Anführungszeichen nicht geschlossen.\n");
+      return -1;
+    }
+    if (*src != '\0') {
+      src++;
+    }
+    *dst = '\0';
+  }
+}
+
+/**
+ * @brief Vergrößert einen wiederverwendeten Puffer bei Bedarf.
+ * @return 0 bei Erfolg, 1 bei Speichermangel.
+ */
+static int reserve_buffer(void** buffer, size_t* capacity, size_t count, size_t size) {
+  if (count <= *capacity) {
+    return 0;
+  }
+  void* grown = realloc(*buffer, count * size);
+  if (grown == NULL) {
+    return 1;
+  }
+  *buffer = grown;
+  *capacity = count;
+  return 0;
+}
+
+/**
+ * @brief Prüft mehrere POCSAG-Seiten und kodiert sie in buffers->words.
+ */
+int rs_job_encode_pocsag_pages(rs_job_buffers* buffers, uint32_t baudRate,
+                               const pocsag_page* pages, size_t count, size_t* words) {
+  if (baudRate != 512 && baudRate != 1200 && baudRate != 2400) {
+    fprintf(stderr, "Fehler: Ungültige POCSAG-Baudrate. Erlaubt: 512, 1200, 2400.\n");
+    return RS_JOB_INVALID;
+  }
+  if (count == 0) {
+    fprintf(stderr, "Fehler: Keine POCSAG-Seite angegeben.\n");
+    return RS_JOB_INVALID;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (pages[i].address > 2097151) {
+      fprintf(stderr, "Fehler: Adresse überschreitet 21 Bits: %u\n", pages[i].address);
+      return RS_JOB_INVALID;
+    }
+    if ((uint32_t) pages[i].functionCode > 3) {
+      fprintf(stderr, "Fehler: Ungültiger Funktionscode: %u. Erlaubt: 0-3.\n", (uint32_t) pages[i].functionCode);
+      return RS_JOB_INVALID;
+    }
+    if (pages[i].functionCode == FUNC_NUMERIC_1 || pages[i].functionCode == FUNC_NUMERIC_2) {
+      for (const char* c = pages[i].message; *c != '\0'; c++) {
+        if (!pocsag_isNumericChar(*c)) {
+          fprintf(stderr, "Fehler: Ungültiges Zeichen '%c' in numerischer Nachricht. Erlaubt: 0-9, U, Leerzeichen, -, [ ] ( ).\n", *c);
+          return RS_JOB_INVALID;
+        }
+      }
+    }
+  }
+
+  // Sendereihenfolge und Kodierung (Puffer werden zwischen Jobs wiederverwendet)
+  if (reserve_buffer((void**) &buffers->order, &buffers->orderCapacity, count, sizeof(size_t)) != 0) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für POCSAG-Seiten fehlgeschlagen.\n");
+    return RS_JOB_FAILED;
+  }
+  size_t requiredMessageLength = pocsag_planPages(pages, count, buffers->order);
+  if (reserve_buffer((void**) &buffers->words, &buffers->wordsCapacity,
+                     requiredMessageLength, sizeof(uint32_t)) != 0) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für POCSAG-Wörter fehlgeschlagen.\n");
+    return RS_JOB_FAILED;
+  }
+
+  pocsag_encodePages(pages, buffers->order, count, buffers->words);
+  *words = requiredMessageLength;
+  return RS_JOB_OK;
+}
+
+/**
+ * @brief Prüft und rendert mehrere POCSAG-Seiten in einer Übertragung (blockweise, ohne End-Stille).
+ */
+int rs_job_render_pocsag_pages(rs_sink* sink, rs_job_buffers* buffers, uint32_t baudRate,
+                               const pocsag_page* pages, size_t count) {
+  size_t requiredMessageLength;
+  int result = rs_job_encode_pocsag_pages(buffers, baudRate, pages, count, &requiredMessageLength);
+  if (result != RS_JOB_OK) {
+    return result;
+  }
+
+  // Signalerzeugung und Ausgabe: blockweise, der Speicherbedarf bleibt konstant
+  pcmStream stream;
+  int16_t pcm[PCM_BLOCK_SAMPLES];
+  size_t n;
+
+  pcmStreamInit(&stream, SAMPLE_RATE, baudRate, buffers->words, requiredMessageLength);
+  rs_sink_reserve(sink, stream.totalSamples);
+
+  // Die Präambel ist für jede Nachricht gleich: vorab gerendert, nur kopieren
+  const int16_t* preamble = pcmStreamSkipPreamble(&stream, SAMPLE_RATE, baudRate, &n);
+  if (preamble != NULL) {
+    rs_sink_write(sink, preamble, n);
+  }
+  while ((n = pcmStreamRender(&stream, pcm, PCM_BLOCK_SAMPLES)) > 0) {
+    rs_sink_write(sink, pcm, n);
+  }
+
+  return (sink->error == 0) ? RS_JOB_OK : RS_JOB_FAILED;
+}
+
+/**
+ * @brief Prüft und rendert eine POCSAG-Nachricht (blockweise, ohne End-Stille).
+ */
+int rs_job_render_pocsag(rs_sink* sink, rs_job_buffers* buffers, uint32_t baudRate,
+                         uint32_t address, uint32_t functionCode, const char* message) {
+  if (functionCode > 3) {
+    fprintf(stderr, "Fehler: Ungültiger Funktionscode: %u. Erlaubt: 0-3.\n", functionCode);
+    return RS_JOB_INVALID;
+  }
+
+  pocsag_page page = { address, (FunctionCode) functionCode, message };
+  return rs_job_render_pocsag_pages(sink, buffers, baudRate, &page, 1);
+}
+
+/**
+ * @brief Prüft Ton- und Pausendauer einer DTMF-Sequenz.
+ */
+int rs_job_check_dtmf(int toneMs, int pauseMs) {
+  if (toneMs <= 0 || pauseMs <= 0) {
+    fprintf(stderr, "Fehler: Ton- und Pausendauer müssen positiv sein.\n");
+    return RS_JOB_INVALID;
+  }
+  return RS_JOB_OK;
+}
+
+/**
+ * @brief Prüft und rendert eine DTMF-Sequenz.
+ */
+int rs_job_render_dtmf(rs_sink* sink, rs_job_buffers* buffers, const char* digits, int toneMs, int pauseMs) {
+  if (rs_job_check_dtmf(toneMs, pauseMs) != RS_JOB_OK) {
+    return RS_JOB_INVALID;
+  }
+
+  // Der DTMF-Encoder schreibt die Samples direkt in den Sink; die Ziffern-
+  // Wellenformen bleiben für folgende Jobs mit gleicher Tondauer erhalten
+  return rs_encode_dtmf(sink, digits, toneMs, pauseMs, &buffers->dtmf);
+}
+
+/**
+ * @brief Prüft die Geschwindigkeit und startet einen Morse-Strom auf sink.
+ */
+int rs_job_open_morse(morse_stream* stream, rs_sink* sink, rs_job_buffers* buffers, uint32_t wpm) {
+  if (wpm == 0 || wpm > 60) {
+    fprintf(stderr, "Fehler: Ungültige WPM. Erlaubt: 1-60.\n");
+    return RS_JOB_INVALID;
+  }
+
+  // Speicher für die Dit-/Dah-Vorlagen (wird zwischen Jobs wiederverwendet)
+  if (reserve_buffer((void**) &buffers->pcm, &buffers->pcmCapacity, morse_templateSamples(wpm), sizeof(int16_t)) != 0) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für die Morse-Vorlagen fehlgeschlagen.\n");
+    return RS_JOB_FAILED;
+  }
+  return (morse_streamInit(stream, sink, wpm, buffers->pcm) == 0) ? RS_JOB_OK : RS_JOB_FAILED;
+}
+
+/**
+ * @brief Prüft und rendert eine Morse-Nachricht.
+ */
+int rs_job_render_morse(rs_sink* sink, rs_job_buffers* buffers, const char* message, uint32_t wpm) {
+  // 1. Prüfung und Dit-/Dah-Vorlagen; die Nachricht selbst wird ohne
+  // Zwischenpuffer in den Sink gestreamt
+  morse_stream stream;
+  int result = rs_job_open_morse(&stream, sink, buffers, wpm);
+  if (result != RS_JOB_OK) {
+    return result;
+  }
+
+  // 2. Kodierung und Ausgabe
+  morse_streamWrite(&stream, message, strlen(message));
+  uint64_t actualSamples = morse_streamFinish(&stream);
+
+  if (actualSamples == 0) {
+    fprintf(stderr, "Fehler: Morse-Kodierung erzeugte kein Signal.\n");
+  }
+
+  return (actualSamples > 0 && sink->error == 0) ? RS_JOB_OK : RS_JOB_FAILED;
+}
+
+/**
+ * @brief Prüft Anzahl und Rufzeichen von AX.25-Frames (AFSK1200, FSK9600).
+ */
+int rs_job_check_ax25_frames(const ax25_frame* frames, size_t count) {
+  if (count == 0) {
+    fprintf(stderr, "Fehler: Mindestens ein AX.25-Frame erforderlich.\n");
+    return RS_JOB_INVALID;
+  }
+
+  // Rudimentäre Validierung
+  for (size_t i = 0; i < count; i++) {
+    if (strlen(frames[i].txCall) > 10 || strlen(frames[i].destCall) > 10) {
+      fprintf(stderr, "Fehler: Callsigns dürfen 10 Zeichen nicht überschreiten (AX.25-Limit).\n");
+      return RS_JOB_INVALID;
+    }
+  }
+  return RS_JOB_OK;
+}
+
+/**
+ * @brief Prüft die Rufzeichen und rendert mehrere AFSK1200-Frames in einer Übertragung.
+ */
+int rs_job_render_afsk1200_frames(rs_sink* sink, const ax25_frame* frames, size_t count) {
+  if (rs_job_check_ax25_frames(frames, count) != RS_JOB_OK) {
+    return RS_JOB_INVALID;
+  }
+  return rs_encode_afsk1200_frames(sink, frames, count);
+}
+
+/**
+ * @brief Prüft die Rufzeichen und rendert einen AFSK1200-Frame.
+ */
+int rs_job_render_afsk1200(rs_sink* sink, const char* txCall, const char* destCall, const char* message) {
+  ax25_frame frame = { txCall, destCall, message };
+  return rs_job_render_afsk1200_frames(sink, &frame, 1);
+}
+
+/**
+ * @brief Prüft Rufzeichen und Nachricht und rendert einen FSK9600-Frame.
+ */
+int rs_job_render_fsk9600(rs_sink* sink, const char* txCall, const char* destCall, const char* message) {
+  ax25_frame frame = { txCall, destCall, message };
+  if (rs_job_check_ax25_frames(&frame, 1) != RS_JOB_OK) {
+    return RS_JOB_INVALID;
+  }
+  if (message[0] == '\0') {
+    fprintf(stderr, "Fehler: FSK9600 benötigt eine Nachricht.\n");
+    return RS_JOB_INVALID;
+  }
+  return rs_encode_fsk9600(sink, txCall, destCall, message);
+}
+
+/**
+ * @brief Zerlegt die POCSAG-Parameter (BAUD SEITE [SEITE...]) und rendert.
+ * * SEITE = ADRESSE[,ADRESSE...][:FUNKTION]:NACHRICHT; alle Adressen einer Seite
+ * erhalten denselben Nachrichtentext. Alle Seiten gehen in eine Übertragung.
+ */
+static int handle_pocsag_encoding(const rs_job* job, rs_sink* sink, rs_job_buffers* buffers) {
+  int argc = job->argc;
+  char** argv = job->argv;
+
+  if (argc < 3) {
+    fprintf(stderr, "Fehler: POCSAG benötigt BAUD und ADRESSE:NACHRICHT.\n");
+    return RS_JOB_INVALID;
+  }
+
+  uint32_t baudRate = (uint32_t) strtol(argv[1], NULL, 10);
+
+  // Kopie für strtok und Obergrenze der Seitenzahl (eine je Adresse)
+  size_t textLength = 0;
+  size_t maxPages = 0;
+  for (int i = 2; i < argc; i++) {
+    textLength += strlen(argv[i]) + 1;
+    maxPages++;
+    for (const char* c = argv[i]; *c != '\0' && *c != ':'; c++) {
+      if (*c == ',') {
+        maxPages++;
+      }
+    }
+  }
+  if (reserve_buffer((void**) &buffers->text, &buffers->textCapacity, textLength, sizeof(char)) != 0 ||
+      reserve_buffer((void**) &buffers->pages, &buffers->pagesCapacity, maxPages, sizeof(pocsag_page)) != 0) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für POCSAG-Seiten fehlgeschlagen.\n");
+    return RS_JOB_FAILED;
+  }
+
+  char* inputCopy = buffers->text;
+  size_t count = 0;
+
+  for (int i = 2; i < argc; i++) {
+    uint32_t functionCode = FUNC_ALPHA_TEXT;
+    char* message = NULL;
+
+    strcpy(inputCopy, argv[i]);
+
+    char* savePtr = NULL;
+    char* token = strtok_r(inputCopy, ":", &savePtr);
+    inputCopy += strlen(argv[i]) + 1;
+    if (token == NULL) {
+      fprintf(stderr, "Fehler: Ungültiges POCSAG-Nachrichtenformat. Erwarte ADDR:MSG.\n");
+      return RS_JOB_INVALID;
+    }
+    char* addressToken = token;
+
+    char* funcOrMsgToken = strtok_r(NULL, ":", &savePtr);
+    if (funcOrMsgToken == NULL) {
+      fprintf(stderr, "Fehler: Nachrichtenteil fehlt.\n");
+      return RS_JOB_INVALID;
+    }
+
+    char* messageToken = strtok_r(NULL, ":", &savePtr);
+
+    if (messageToken != NULL) {
+      // Format: ADDR:FUNC:MSG
+      functionCode = (uint32_t) strtol(funcOrMsgToken, NULL, 10);
+      message = messageToken;
+    } else {
+      // Format: ADDR:MSG
+      message = funcOrMsgToken;
+      functionCode = FUNC_ALPHA_TEXT;
+    }
+    if (functionCode > 3) {
+      fprintf(stderr, "Fehler: Ungültiger Funktionscode: %u. Erlaubt: 0-3.\n", functionCode);
+      return RS_JOB_INVALID;
+    }
+
+    // Adressliste (Gruppenruf): jede Adresse wird eine Seite mit demselben Text
+    char* cursor = addressToken;
+    do {
+      char* end;
+      pocsag_page* page = &buffers->pages[count++];
+      page->address = (uint32_t) strtol(cursor, &end, 10);
+      page->functionCode = (FunctionCode) functionCode;
+      page->message = message;
+      cursor = end;
+    } while (*cursor++ == ',' && count < maxPages);
+  }
+
+  if (count == 1) {
+    INFO(job, "Info: POCSAG-Kodierung: Adresse %u, Baud %u, Code %u.\n",
+         buffers->pages[0].address, baudRate, (uint32_t) buffers->pages[0].functionCode);
+  } else {
+    INFO(job, "Info: POCSAG-Kodierung: %zu Seiten, Baud %u.\n", count, baudRate);
+  }
+
+  return rs_job_render_pocsag_pages(sink, buffers, baudRate, buffers->pages, count);
+}
+
+/**
+ * @brief Wählt den Modulator und rendert die Übertragung (ohne End-Stille).
+ */
+static int render_signal(const rs_job* job, rs_sink* sink, rs_job_buffers* buffers) {
+  int argc = job->argc;
+  char** argv = job->argv;
+  const char* modulator = argv[0];
+  int result = RS_JOB_OK; // Ergebnis der Kodierung
+
+  // --- 1. POCSAG-Logik ---
+  if (strcasecmp(modulator, "POCSAG") == 0) {
+    result = handle_pocsag_encoding(job, sink, buffers);
+
+  // --- 2. DTMF-Logik ---
+  } else if (strcasecmp(modulator, "DTMF") == 0) {
+    const char* digits = argv[1];
+    int tone_duration = DTMF_TONE_MS;
+    int pause_duration = DTMF_PAUSE_MS;
+
+    if (argc >= 3) {
+      tone_duration = (int) strtol(argv[2], NULL, 10);
+    }
+    if (argc >= 4) {
+      pause_duration = (int) strtol(argv[3], NULL, 10);
+    }
+
+    INFO(job, "Info: DTMF-Kodierung: '%s' (Ton: %dms, Pause: %dms)\n",
+         digits, tone_duration, pause_duration);
+
+    result = rs_job_render_dtmf(sink, buffers, digits, tone_duration, pause_duration);
+
+  // --- 3. MORSE_CW-Logik ---
+  } else if (strcasecmp(modulator, "MORSE_CW") == 0) {
+    const char* message = argv[1];
+    uint32_t wpm = MORSE_WPM_DEFAULT;
+
+    if (argc >= 3) {
+      wpm = (uint32_t) strtol(argv[2], NULL, 10);
+    }
+
+    INFO(job, "Info: MORSE_CW-Kodierung: '%s' bei %u WPM.\n", message, wpm);
+
+    result = rs_job_render_morse(sink, buffers, message, wpm);
+
+  // --- 4. AFSK1200-Logik ---
+  } else if (strcasecmp(modulator, "AFSK1200") == 0) {
+    if (argc < 3) {
+      fprintf(stderr, "Fehler: AFSK1200 benötigt mindestens Sender-Call und Nachricht.\n");
+      return RS_JOB_INVALID;
+    }
+
+    // Argumente: [0]AFSK1200 | [1]TX_CALL | [2]DEST_CALL | [3]MESSAGE [4...] weitere Frames
+    const char* tx_call = argv[1];
+    const char* dest_call = argv[2];
+    size_t count = (argc >= 4) ? (size_t)(argc - 3) : 1;
+
+    if (reserve_buffer((void**) &buffers->frames, &buffers->framesCapacity, count, sizeof(ax25_frame)) != 0) {
+      fprintf(stderr, "Fehler: Speicherzuweisung für AX.25-Frames fehlgeschlagen.\n");
+      return RS_JOB_FAILED;
+    }
+    for (size_t i = 0; i < count; i++) {
+      ax25_frame* frame = &buffers->frames[i];
+      frame->txCall = tx_call;
+      frame->destCall = dest_call;
+      frame->message = (argc >= 4) ? argv[3 + i] : "";
+    }
+
+    if (count == 1) {
+      INFO(job, "Info: AFSK1200: %s an %s, Nachricht: '%.20s...'\n",
+           tx_call, dest_call, buffers->frames[0].message);
+    } else {
+      INFO(job, "Info: AFSK1200: %s an %s, %zu Frames\n", tx_call, dest_call, count);
+    }
+
+    result = rs_job_render_afsk1200_frames(sink, buffers->frames, count);
+
+  } else if (strcasecmp(modulator, "FSK9600") == 0) {
+    if (argc < 4) {
+      fprintf(stderr, "Fehler: FSK9600 benötigt Sender-Call, Empfänger-Call und Nachricht.\n");
+      return RS_JOB_INVALID;
+    }
+
+    // Argumente: [0]FSK9600 | [1]TX_CALL | [2]DEST_CALL | [3]MESSAGE
+    INFO(job, "Info: FSK9600: %s an %s, Nachricht: '%.20s...'\n", argv[1], argv[2], argv[3]);
+
+    result = rs_job_render_fsk9600(sink, argv[1], argv[2], argv[3]);
+
+  } else if (strcasecmp(modulator, "UFSK1200") == 0) {
+    result = rs_encode_ufsk1200(sink, argv[1]);
+
+  } else {
+    fprintf(stderr, "Fehler: Unbekannter Modulator '%s'.\n", modulator);
+    return RS_JOB_INVALID;
+  }
+
+  return result;
+}
+
+/**
+ * @brief Baut den Cache-Schlüssel: Version (inkl. Festkomma-Build), Rate, Byte-Reihenfolge, Modulator
+ * und Parameter, jeweils mit '\0' abgeschlossen.
+ * @return Länge des Schlüssels oder 0 bei Speichermangel.
+ */
+static size_t build_cache_key(const rs_job* job, rs_job_buffers* buffers) {
+  char head[64];
+#ifdef RS_FIXED_POINT
+  const char* version = "v2q";  // Festkomma-Build: andere Samples, eigener Schlüssel
+#else
+  const char* version = "v2";
+#endif
+  int headLen = snprintf(head, sizeof(head), "%s%c%u%c%d%c", version, '\0', job->outputRate, '\0', (int) job->order, '\0');
+  size_t len = (size_t) headLen;
+  for (int i = 0; i < job->argc; i++) {
+    len += strlen(job->argv[i]) + 1;
+  }
+  if (reserve_buffer((void**) &buffers->key, &buffers->keyCapacity, len, 1) != 0) {
+    return 0;
+  }
+
+  char* p = buffers->key;
+  memcpy(p, head, (size_t) headLen);
+  p += headLen;
+  for (int i = 0; i < job->argc; i++) {
+    size_t n = strlen(job->argv[i]) + 1;
+    memcpy(p, job->argv[i], n);
+    p += n;
+  }
+  return len;
+}
+
+/**
+ * @brief Rendert die Übertragung einmal (oder liest sie aus dem Cache) und gibt
+ * sie job->repeat-mal aus.
+ */
+static int render_replayed(const rs_job* job, rs_sink* sink, rs_job_buffers* buffers) {
+  rs_cache_entry entry = { 0 };
+  size_t keyLen = 0;
+  const uint8_t* data;
+  size_t len;
+
+  if (job->cacheDir != NULL) {
+    keyLen = build_cache_key(job, buffers);
+    if (keyLen > 0 && rs_cache_lookup(job->cacheDir, buffers->key, keyLen, &entry)) {
+      INFO(job, "Info: %s aus dem Cache (%zu Bytes).\n", job->argv[0], entry.dataBytes);
+    }
+  }
+
+  if (entry.map != NULL) {
+    data = entry.data;
+    len = entry.dataBytes;
+  } else {
+    // Einmal in den Speicher rendern, in Ausgaberate und Byte-Reihenfolge des Jobs
+    rs_sink* signal = &buffers->signal;
+    if (!buffers->signalReady) {
+      if (rs_sink_init_memory(signal, job->order) != 0) {
+        return RS_JOB_FAILED;
+      }
+      buffers->signalReady = 1;
+    }
+    rs_sink_reset_memory(signal);
+    signal->order = job->order;
+    if (rs_sink_set_rate(signal, SAMPLE_RATE, job->outputRate) != 0) {
+      return RS_JOB_FAILED;
+    }
+
+    int result = render_signal(job, signal, buffers);
+    if (rs_sink_end_segment(signal) != 0 && result == RS_JOB_OK) {
+      result = RS_JOB_FAILED;
+    }
+    if (result != RS_JOB_OK) {
+      return result;
+    }
+    data = signal->memory;
+    len = signal->memoryFill;
+
+    if (keyLen > 0) {
+      int error = rs_cache_store(job->cacheDir, buffers->key, keyLen, data, len);
+      if (error != 0) {
+        fprintf(stderr, "Warnung: Cache-Eintrag in '%s' nicht geschrieben: %s\n", job->cacheDir, strerror(error));
+      }
+    }
+  }
+
+  size_t intervalSamples = (size_t) ((uint64_t) job->intervalMs * SAMPLE_RATE / 1000);
+  for (unsigned int i = 0; i < job->repeat && sink->error == 0; i++) {
+    if (i > 0 && intervalSamples > 0) {
+      rs_sink_write_silence(sink, intervalSamples);
+      rs_sink_end_segment(sink);
+    }
+    rs_sink_write_bytes(sink, data, len);
+  }
+
+  rs_cache_release(&entry);
+  return (sink->error == 0) ? RS_JOB_OK : RS_JOB_FAILED;
+}
+
+/**
+ * @brief Rendert einen Job samt zufälliger End-Stille in den Sink.
+ */
+int rs_job_render(const rs_job* job, rs_sink* sink, rs_job_buffers* buffers) {
+  if (rs_sink_set_rate(sink, SAMPLE_RATE, job->outputRate) != 0) {
+    return RS_JOB_FAILED;
+  }
+
+  int result = (job->repeat > 1 || job->cacheDir != NULL)
+      ? render_replayed(job, sink, buffers)
+      : render_signal(job, sink, buffers);
+  if (result == RS_JOB_INVALID) {
+    return result;
+  }
+
+  // Die Übertragung endet als eigener Abschnitt, damit die Ausgabe mit und
+  // ohne Cache bytegleich ist
+  if (rs_sink_end_segment(sink) != 0) {
+    result = RS_JOB_FAILED;
+  }
+
+  // --- ZUFÄLLIGE END-STILLE (Wird nur bei Erfolg hinzugefügt) ---
+  if (result == RS_JOB_OK) {
+    // Füge zufällige Stille am Ende hinzu (für SDR-Tools oft nützlich)
+    // Die Berechnung ergibt die Anzahl der Samples (int16_t)
+    // Eigener Zufallszustand je Job: reproduzierbar und ohne geteilten rand()-Zustand
+    unsigned int seed = job->seed;
+    size_t silenceSamples = rand_r(&seed) % (SAMPLE_RATE * (MAX_DELAY - MIN_DELAY)) + (SAMPLE_RATE * MIN_DELAY);
+
+    rs_sink_write_silence(sink, silenceSamples);
+  }
+
+  // Flush-Punkt am Jobende: Resampler-Nachlauf und Restpuffer ausgeben
+  if (rs_sink_end_segment(sink) != 0) {
+    result = RS_JOB_FAILED;
+  }
+
+  return (result == RS_JOB_OK) ? RS_JOB_OK : RS_JOB_FAILED;
+}
+
+/**
+ * @brief Zerlegt, prüft und rendert eine Jobzeile.
+ */
+int rs_job_run_line(char* line, unsigned long number, const rs_job* defaults,
+                    rs_job* job, char** args, rs_sink* shared, int stream,
+                    rs_job_buffers* buffers, uint64_t* samples) {
+  *samples = 0;
+
+  // Zeilenweise Jobs laufen immer ohne "Info:"-Zeilen
+  int argc = rs_job_split_line(line, args, RS_JOB_MAX_ARGS);
+  if (argc == 0) {
+    return RS_JOB_SKIPPED;
+  }
+
+  *job = *defaults;
+  job->quiet = 1;
+  job->outputPath = NULL;
+  job->argv = NULL;
+  job->seed = rs_job_seed(defaults->seed, number);
+
+  int result = (argc < 0) ? RS_JOB_INVALID : rs_job_parse(job, argc, args);
+  if (result != RS_JOB_OK) {
+    return result;
+  }
+
+  if (job->outputPath != NULL) {
+    rs_sink file;
+    if (rs_sink_open_file(&file, job->outputPath, job->order, job->outputRate) != 0) {
+      return RS_JOB_FAILED;
+    }
+    result = rs_job_render(job, &file, buffers);
+    *samples = file.samplesWritten;
+    if (rs_sink_close(&file) != 0) {
+      fprintf(stderr, "Fehler: Ausgabe nach '%s' fehlgeschlagen: %s\n", job->outputPath, strerror(file.error));
+      result = RS_JOB_FAILED;
+    }
+    return result;
+  }
+
+  // Ein gemeinsamer Strom hat genau ein Format (sonst mischt z.B. eine WAV-Datei
+  // Abtastraten unter einem Header)
+  if (stream && (job->outputRate != defaults->outputRate || job->order != defaults->order)) {
+    fprintf(stderr, "Fehler: -r/-L/-B abweichend von der gemeinsamen Ausgabe nur mit eigenem -o.\n");
+    return RS_JOB_INVALID;
+  }
+
+  // Eigener Sink (Dienst): Byte-Reihenfolge je Job
+  shared->order = job->order;
+  uint64_t before = shared->samplesWritten;
+  result = rs_job_render(job, shared, buffers);
+  *samples = shared->samplesWritten - before;
+  return result;
+}
+
+/**
+ * @brief Leitet den Startwert für Job Nummer number aus einem Basis-Startwert ab.
+ */
+unsigned int rs_job_seed(unsigned int base, unsigned long number) {
+  return base ^ (unsigned int)(number * 2654435761u);
+}
+
+/**
+ * @brief Gibt die Ergebniszeile eines Jobs auf stderr aus.
+ */
+void rs_job_report(unsigned long number, const rs_job* job, int result, uint64_t samples, double ms) {
+  if (result == RS_JOB_OK) {
+    fprintf(stderr, "JOB %lu OK %s %llu Samples %.3f ms%s%s\n", number, job->argv[0],
+            (unsigned long long) samples, ms, job->outputPath ? " -> " : "",
+            job->outputPath ? job->outputPath : "");
+  } else {
+    fprintf(stderr, "JOB %lu FEHLER %s\n", number, rs_job_result_text(result));
+  }
+}
+
+/**
+ * @brief Kurzbeschreibung eines Fehlerergebnisses (für Ergebniszeilen und Antworten).
+ */
+const char* rs_job_result_text(int result) {
+  switch (result) {
+    case RS_JOB_OK: return "ok";
+    case RS_JOB_INVALID: return "ungültig";
+    default: return "fehlgeschlagen";
+  }
+}
+
+/**
+ * @brief Gibt die wiederverwendeten Puffer frei.
+ */
+void rs_job_buffers_free(rs_job_buffers* buffers) {
+  free(buffers->words);
+  free(buffers->pages);
+  free(buffers->order);
+  free(buffers->text);
+  free(buffers->frames);
+  free(buffers->pcm);
+  rs_dtmf_cache_free(&buffers->dtmf);
+  free(buffers->key);
+  if (buffers->signalReady) {
+    rs_sink_close(&buffers->signal);
+  }
+  memset(buffers, 0, sizeof(*buffers));
+}
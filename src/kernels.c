@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/cpu.h"
+#include "../include/kernels.h"
+#include "../include/oscillator.h"
+
+const rs_kernel_table* rs_active_kernels = NULL;
+
+// =========================================================
+// SKALARE REFERENZ
+// =========================================================
+
+static void sine_scalar(uint32_t* phase, uint32_t inc, int interpolate, int16_t* out, size_t count) {
+    uint32_t p = *phase;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = rs_sine_lookup(p, interpolate);
+        p += inc;
+    }
+    *phase = p;
+}
+
+static void mix_avg_scalar(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (int16_t)((a[i] + b[i]) / 2);
+    }
+}
+
+static void add_sat_scalar(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int32_t sum = (int32_t)a[i] + b[i];
+        if (sum > 32767) sum = 32767;
+        if (sum < -32768) sum = -32768;
+        out[i] = (int16_t)sum;
+    }
+}
+
+static void fill_scalar(int16_t* out, int16_t value, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = value;
+    }
+}
+
+static void float_to_s16_scalar(int16_t* out, const float* in, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        // Erst begrenzen, dann abrunden: identisch zu floor() mit anschließender Sättigung
+        float v = in[i] + 0.5f;
+        if (v > 32767.0f) v = 32767.0f;
+        if (v < -32768.0f) v = -32768.0f;
+        out[i] = (int16_t)floorf(v);
+    }
+}
+
+static void fir_q15_scalar(int16_t* out, const int16_t* in, const uint32_t* start,
+                           const int16_t* coef, size_t taps, int shift, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const int16_t* x = in + start[i];
+        const int16_t* c = coef + i * taps;
+        int32_t acc = 0;
+        for (size_t j = 0; j < taps; j++) {
+            acc += (int32_t)x[j] * c[j];
+        }
+        acc = (acc + (1 << (shift - 1))) >> shift;
+        if (acc > 32767) acc = 32767;
+        if (acc < -32768) acc = -32768;
+        out[i] = (int16_t)acc;
+    }
+}
+
+const rs_kernel_table rs_kernels_scalar = {
+    .name = "scalar",
+    .sine = sine_scalar,
+    .mix_avg = mix_avg_scalar,
+    .add_sat = add_sat_scalar,
+    .fill = fill_scalar,
+    .float_to_s16 = float_to_s16_scalar,
+    .fir_q15 = fir_q15_scalar,
+};
+
+// =========================================================
+// AUSWAHL DER VARIANTE
+// =========================================================
+
+/**
+ * @brief Liefert die Variante mit dem angegebenen Namen, falls die CPU sie unterstützt.
+ */
+const rs_kernel_table* rs_kernels_find(const char* name) {
+    uint32_t features = rs_cpu_features();
+
+    if (strcmp(name, rs_kernels_scalar.name) == 0) {
+        return &rs_kernels_scalar;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (strcmp(name, rs_kernels_avx2.name) == 0 && (features & RS_CPU_AVX2)) {
+        return &rs_kernels_avx2;
+    }
+    if (strcmp(name, rs_kernels_sse2.name) == 0 && (features & RS_CPU_SSE2)) {
+        return &rs_kernels_sse2;
+    }
+#endif
+#if defined(__ARM_NEON)
+    if (strcmp(name, rs_kernels_neon.name) == 0 && (features & RS_CPU_NEON)) {
+        return &rs_kernels_neon;
+    }
+#endif
+    (void)features;
+    return NULL;
+}
+
+/**
+ * @brief Wählt die beste unterstützte Variante (oder RS_KERNELS) und merkt sie sich.
+ */
+void rs_kernels_init(void) {
+    static const char* const preference[] = { "avx2", "sse2", "neon", "scalar" };
+    const rs_kernel_table* selected = NULL;
+
+    const char* forced = getenv("RS_KERNELS");
+    if (forced != NULL && *forced != '\0') {
+        selected = rs_kernels_find(forced);
+    }
+
+    for (size_t i = 0; selected == NULL && i < sizeof(preference) / sizeof(preference[0]); i++) {
+        selected = rs_kernels_find(preference[i]);
+    }
+
+    __atomic_store_n(&rs_active_kernels, selected, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,153 @@
+// NEON-Varianten der Sample-Kernels (ARMv7 mit NEON, AArch64).
+
+#include "../include/kernels.h"
+
+#if defined(__ARM_NEON)
+
+#include <string.h>
+#include <arm_neon.h>
+
+#include "../include/oscillator.h"
+
+static void sine_neon(uint32_t* phase, uint32_t inc, int interpolate, int16_t* out, size_t count) {
+    uint32_t p = *phase;
+    size_t i = 0;
+
+    if (interpolate) {
+        for (; i + 8 <= count; i += 8) {
+            int16_t a[8];
+            int16_t b[8];
+            uint16_t frac[8];
+            for (int k = 0; k < 8; k++) {
+                uint32_t pk = p + (uint32_t)k * inc;
+                uint32_t index = pk >> RS_PHASE_FRAC_BITS;
+                a[k] = rs_sine_table[index];
+                b[k] = rs_sine_table[index + 1];
+                frac[k] = (uint16_t)((pk >> (RS_PHASE_FRAC_BITS - 15)) & 0x7FFF);
+            }
+
+            int16x8_t va = vld1q_s16(a);
+            int16x8_t d = vsubq_s16(vld1q_s16(b), va);
+            int16x8_t f = vreinterpretq_s16_u16(vld1q_u16(frac));
+
+            // ((b - a) * frac) >> 15 in 32 Bit, danach wieder auf 16 Bit
+            int16x4_t rLo = vshrn_n_s32(vmull_s16(vget_low_s16(d), vget_low_s16(f)), 15);
+            int16x4_t rHi = vshrn_n_s32(vmull_s16(vget_high_s16(d), vget_high_s16(f)), 15);
+
+            vst1q_s16(out + i, vaddq_s16(va, vcombine_s16(rLo, rHi)));
+            p += 8 * inc;
+        }
+    } else {
+        for (; i + 8 <= count; i += 8) {
+            for (int k = 0; k < 8; k++) {
+                out[i + k] = rs_sine_table[(p + (uint32_t)k * inc) >> RS_PHASE_FRAC_BITS];
+            }
+            p += 8 * inc;
+        }
+    }
+
+    *phase = p;
+    rs_kernels_scalar.sine(phase, inc, interpolate, out + i, count - i);
+}
+
+/**
+ * @brief (a + b) / 2 mit Rundung gegen 0 für 4 Werte in 32 Bit.
+ */
+static inline int16x4_t half_toward_zero(int32x4_t s) {
+    int32x4_t sign = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(s), 31));
+    return vshrn_n_s32(vaddq_s32(s, sign), 1);
+}
+
+static void mix_avg_neon(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        int16x4_t lo = half_toward_zero(vaddl_s16(vget_low_s16(va), vget_low_s16(vb)));
+        int16x4_t hi = half_toward_zero(vaddl_s16(vget_high_s16(va), vget_high_s16(vb)));
+        vst1q_s16(out + i, vcombine_s16(lo, hi));
+    }
+    rs_kernels_scalar.mix_avg(out + i, a + i, b + i, count - i);
+}
+
+static void add_sat_neon(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(a + i), vld1q_s16(b + i)));
+    }
+    rs_kernels_scalar.add_sat(out + i, a + i, b + i, count - i);
+}
+
+static void fill_neon(int16_t* out, int16_t value, size_t count) {
+    const int16x8_t v = vdupq_n_s16(value);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(out + i, v);
+    }
+    rs_kernels_scalar.fill(out + i, value, count - i);
+}
+
+/**
+ * @brief floor(x + 0.5) mit Sättigung: vcvtq rundet gegen 0, negative Nicht-Ganzzahlen
+ * werden daher um 1 korrigiert.
+ */
+static inline int32x4_t round_floor_neon(float32x4_t x) {
+    float32x4_t v = vaddq_f32(x, vdupq_n_f32(0.5f));
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(-32768.0f)), vdupq_n_f32(32767.0f));
+    int32x4_t t = vcvtq_s32_f32(v);
+    uint32x4_t tooBig = vcgtq_f32(vcvtq_f32_s32(t), v);
+    return vaddq_s32(t, vreinterpretq_s32_u32(tooBig));
+}
+
+static void float_to_s16_neon(int16_t* out, const float* in, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x4_t lo = vmovn_s32(round_floor_neon(vld1q_f32(in + i)));
+        int16x4_t hi = vmovn_s32(round_floor_neon(vld1q_f32(in + i + 4)));
+        vst1q_s16(out + i, vcombine_s16(lo, hi));
+    }
+    rs_kernels_scalar.float_to_s16(out + i, in + i, count - i);
+}
+
+/**
+ * @brief Skalarprodukt einer Koeffizientenzeile, auf zwei 32-Bit-Teilsummen verdichtet.
+ */
+static inline int32x2_t dot_neon(const int16_t* x, const int16_t* c, size_t taps) {
+    int32x4_t acc = vdupq_n_s32(0);
+    for (size_t j = 0; j < taps; j += 8) {
+        int16x8_t vx = vld1q_s16(x + j);
+        int16x8_t vc = vld1q_s16(c + j);
+        acc = vmlal_s16(acc, vget_low_s16(vx), vget_low_s16(vc));
+        acc = vmlal_s16(acc, vget_high_s16(vx), vget_high_s16(vc));
+    }
+    return vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+}
+
+static void fir_q15_neon(int16_t* out, const int16_t* in, const uint32_t* start,
+                         const int16_t* coef, size_t taps, int shift, size_t count) {
+    const int32x4_t round = vdupq_n_s32(1 << (shift - 1));
+    const int32x4_t bits = vdupq_n_s32(-shift); // vshl mit negativer Weite = arithmetisch rechts
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int16_t* c = coef + i * taps;
+        int32x2_t ab = vpadd_s32(dot_neon(in + start[i], c, taps),
+                                 dot_neon(in + start[i + 1], c + taps, taps));
+        int32x2_t cd = vpadd_s32(dot_neon(in + start[i + 2], c + 2 * taps, taps),
+                                 dot_neon(in + start[i + 3], c + 3 * taps, taps));
+        int32x4_t sum = vshlq_s32(vaddq_s32(vcombine_s32(ab, cd), round), bits);
+        vst1_s16(out + i, vqmovn_s32(sum));
+    }
+    rs_kernels_scalar.fir_q15(out + i, in, start + i, coef + i * taps, taps, shift, count - i);
+}
+
+const rs_kernel_table rs_kernels_neon = {
+    .name = "neon",
+    .sine = sine_neon,
+    .mix_avg = mix_avg_neon,
+    .add_sat = add_sat_neon,
+    .fill = fill_neon,
+    .float_to_s16 = float_to_s16_neon,
+    .fir_q15 = fir_q15_neon,
+};
+
+#endif
@@ -0,0 +1,358 @@
+// SSE2- und AVX2-Varianten der Sample-Kernels (x86/x86-64).
+// Die Funktionen werden per target-Attribut übersetzt und nur aufgerufen,
+// wenn rs_cpu_features() die jeweilige Erweiterung meldet.
+
+#include "../include/kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <string.h>
+#include <immintrin.h>
+
+#include "../include/oscillator.h"
+
+#define SSE2 __attribute__((target("sse2")))
+#define AVX2 __attribute__((target("avx2")))
+
+/**
+ * @brief Liest Tabellenwert und Nachfolger als ein 32-Bit-Wort (a | b << 16).
+ */
+static inline uint32_t load_pair(uint32_t phase) {
+    uint32_t pair;
+    memcpy(&pair, &rs_sine_table[phase >> RS_PHASE_FRAC_BITS], sizeof(pair));
+    return pair;
+}
+
+// =========================================================
+// SSE2
+// =========================================================
+
+SSE2 static void sine_sse2(uint32_t* phase, uint32_t inc, int interpolate, int16_t* out, size_t count) {
+    uint32_t p = *phase;
+    size_t i = 0;
+
+    if (interpolate) {
+        const __m128i fracMask = _mm_set1_epi32(0x7FFF);
+        const __m128i step = _mm_setr_epi32(0, (int)inc, (int)(2 * inc), (int)(3 * inc));
+
+        for (; i + 8 <= count; i += 8) {
+            uint32_t pairs[8];
+            for (int k = 0; k < 8; k++) {
+                pairs[k] = load_pair(p + (uint32_t)k * inc);
+            }
+
+            __m128i p0 = _mm_add_epi32(_mm_set1_epi32((int)p), step);
+            __m128i p1 = _mm_add_epi32(p0, _mm_set1_epi32((int)(4 * inc)));
+            __m128i f0 = _mm_and_si128(_mm_srli_epi32(p0, RS_PHASE_FRAC_BITS - 15), fracMask);
+            __m128i f1 = _mm_and_si128(_mm_srli_epi32(p1, RS_PHASE_FRAC_BITS - 15), fracMask);
+            __m128i frac = _mm_packs_epi32(f0, f1);
+
+            __m128i v0 = _mm_loadu_si128((const __m128i*)&pairs[0]);
+            __m128i v1 = _mm_loadu_si128((const __m128i*)&pairs[4]);
+            __m128i a = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(v0, 16), 16),
+                                        _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16));
+            __m128i b = _mm_packs_epi32(_mm_srai_epi32(v0, 16), _mm_srai_epi32(v1, 16));
+
+            // ((b - a) * frac) >> 15 aus oberer und unterer Produkthälfte
+            __m128i d = _mm_sub_epi16(b, a);
+            __m128i hi = _mm_mulhi_epi16(d, frac);
+            __m128i lo = _mm_mullo_epi16(d, frac);
+            __m128i r = _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15));
+
+            _mm_storeu_si128((__m128i*)(out + i), _mm_add_epi16(a, r));
+            p += 8 * inc;
+        }
+    } else {
+        for (; i + 8 <= count; i += 8) {
+            for (int k = 0; k < 8; k++) {
+                out[i + k] = rs_sine_table[(p + (uint32_t)k * inc) >> RS_PHASE_FRAC_BITS];
+            }
+            p += 8 * inc;
+        }
+    }
+
+    *phase = p;
+    rs_kernels_scalar.sine(phase, inc, interpolate, out + i, count - i);
+}
+
+SSE2 static void mix_avg_sse2(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+
+        // Vorzeichenrichtig auf 32 Bit erweitern
+        __m128i sLo = _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(va, va), 16),
+                                    _mm_srai_epi32(_mm_unpacklo_epi16(vb, vb), 16));
+        __m128i sHi = _mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(va, va), 16),
+                                    _mm_srai_epi32(_mm_unpackhi_epi16(vb, vb), 16));
+
+        // Division durch 2 mit Rundung gegen 0 (wie in C)
+        sLo = _mm_srai_epi32(_mm_add_epi32(sLo, _mm_srli_epi32(sLo, 31)), 1);
+        sHi = _mm_srai_epi32(_mm_add_epi32(sHi, _mm_srli_epi32(sHi, 31)), 1);
+
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(sLo, sHi));
+    }
+    rs_kernels_scalar.mix_avg(out + i, a + i, b + i, count - i);
+}
+
+SSE2 static void add_sat_sse2(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_adds_epi16(va, vb));
+    }
+    rs_kernels_scalar.add_sat(out + i, a + i, b + i, count - i);
+}
+
+SSE2 static void fill_sse2(int16_t* out, int16_t value, size_t count) {
+    const __m128i v = _mm_set1_epi16(value);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        _mm_storeu_si128((__m128i*)(out + i), v);
+        _mm_storeu_si128((__m128i*)(out + i + 8), v);
+        _mm_storeu_si128((__m128i*)(out + i + 16), v);
+        _mm_storeu_si128((__m128i*)(out + i + 24), v);
+    }
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128((__m128i*)(out + i), v);
+    }
+    rs_kernels_scalar.fill(out + i, value, count - i);
+}
+
+/**
+ * @brief floor(x + 0.5) mit Sättigung für 4 Werte; SSE2 kennt kein floor,
+ * daher Abschneiden und Korrektur um -1, wo das Ergebnis zu groß ist.
+ */
+SSE2 static inline __m128i round_floor_sse2(__m128 x) {
+    __m128 v = _mm_add_ps(x, _mm_set1_ps(0.5f));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+    __m128i t = _mm_cvttps_epi32(v);
+    __m128i tooBig = _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(t), v));
+    return _mm_add_epi32(t, tooBig);
+}
+
+SSE2 static void float_to_s16_sse2(int16_t* out, const float* in, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = round_floor_sse2(_mm_loadu_ps(in + i));
+        __m128i hi = round_floor_sse2(_mm_loadu_ps(in + i + 4));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(lo, hi));
+    }
+    rs_kernels_scalar.float_to_s16(out + i, in + i, count - i);
+}
+
+/**
+ * @brief Summiert je Register die vier 32-Bit-Teilsummen: [Summe(a), Summe(b), Summe(c), Summe(d)].
+ */
+SSE2 static inline __m128i hsum4_sse2(__m128i a, __m128i b, __m128i c, __m128i d) {
+    __m128i ab = _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+    __m128i cd = _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+    return _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+}
+
+/**
+ * @brief Skalarprodukt einer Koeffizientenzeile (pmaddwd, 8 Taps je Schritt).
+ */
+SSE2 static inline __m128i dot_sse2(const int16_t* x, const int16_t* c, size_t taps) {
+    __m128i acc = _mm_setzero_si128();
+    for (size_t j = 0; j < taps; j += 8) {
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(x + j)),
+                                                _mm_loadu_si128((const __m128i*)(c + j))));
+    }
+    return acc;
+}
+
+SSE2 static void fir_q15_sse2(int16_t* out, const int16_t* in, const uint32_t* start,
+                              const int16_t* coef, size_t taps, int shift, size_t count) {
+    const __m128i round = _mm_set1_epi32(1 << (shift - 1));
+    const __m128i bits = _mm_cvtsi32_si128(shift);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int16_t* c = coef + i * taps;
+        __m128i sum = hsum4_sse2(dot_sse2(in + start[i], c, taps),
+                                 dot_sse2(in + start[i + 1], c + taps, taps),
+                                 dot_sse2(in + start[i + 2], c + 2 * taps, taps),
+                                 dot_sse2(in + start[i + 3], c + 3 * taps, taps));
+        sum = _mm_sra_epi32(_mm_add_epi32(sum, round), bits);
+        _mm_storel_epi64((__m128i*)(out + i), _mm_packs_epi32(sum, sum));
+    }
+    rs_kernels_scalar.fir_q15(out + i, in, start + i, coef + i * taps, taps, shift, count - i);
+}
+
+const rs_kernel_table rs_kernels_sse2 = {
+    .name = "sse2",
+    .sine = sine_sse2,
+    .mix_avg = mix_avg_sse2,
+    .add_sat = add_sat_sse2,
+    .fill = fill_sse2,
+    .float_to_s16 = float_to_s16_sse2,
+    .fir_q15 = fir_q15_sse2,
+};
+
+// =========================================================
+// AVX2
+// =========================================================
+
+/**
+ * @brief 2 x 8 int32 -> 16 int16 in richtiger Reihenfolge (packs arbeitet je 128-Bit-Hälfte).
+ */
+AVX2 static inline __m256i pack_s32_avx2(__m256i lo, __m256i hi) {
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+}
+
+/**
+ * @brief 8 interpolierte Sinus-Samples als int32; die Gather-Instruktion liest
+ * Tabellenwert und Nachfolger mit einem 32-Bit-Zugriff.
+ */
+AVX2 static inline __m256i sine8_avx2(__m256i phases, int interpolate) {
+    __m256i index = _mm256_srli_epi32(phases, RS_PHASE_FRAC_BITS);
+    __m256i pairs = _mm256_i32gather_epi32((const int*)rs_sine_table, index, 2);
+    __m256i a = _mm256_srai_epi32(_mm256_slli_epi32(pairs, 16), 16);
+
+    if (!interpolate) {
+        return a;
+    }
+
+    __m256i b = _mm256_srai_epi32(pairs, 16);
+    __m256i frac = _mm256_and_si256(_mm256_srli_epi32(phases, RS_PHASE_FRAC_BITS - 15),
+                                    _mm256_set1_epi32(0x7FFF));
+    __m256i r = _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(b, a), frac), 15);
+    return _mm256_add_epi32(a, r);
+}
+
+AVX2 static void sine_avx2(uint32_t* phase, uint32_t inc, int interpolate, int16_t* out, size_t count) {
+    uint32_t p = *phase;
+    size_t i = 0;
+
+    const __m256i step = _mm256_setr_epi32(0, (int)inc, (int)(2 * inc), (int)(3 * inc),
+                                           (int)(4 * inc), (int)(5 * inc), (int)(6 * inc), (int)(7 * inc));
+    const __m256i step8 = _mm256_set1_epi32((int)(8 * inc));
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i p0 = _mm256_add_epi32(_mm256_set1_epi32((int)p), step);
+        __m256i p1 = _mm256_add_epi32(p0, step8);
+        __m256i s = pack_s32_avx2(sine8_avx2(p0, interpolate), sine8_avx2(p1, interpolate));
+        _mm256_storeu_si256((__m256i*)(out + i), s);
+        p += 16 * inc;
+    }
+
+    *phase = p;
+    rs_kernels_scalar.sine(phase, inc, interpolate, out + i, count - i);
+}
+
+AVX2 static void mix_avg_avx2(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+
+        __m256i sLo = _mm256_add_epi32(_mm256_srai_epi32(_mm256_unpacklo_epi16(va, va), 16),
+                                       _mm256_srai_epi32(_mm256_unpacklo_epi16(vb, vb), 16));
+        __m256i sHi = _mm256_add_epi32(_mm256_srai_epi32(_mm256_unpackhi_epi16(va, va), 16),
+                                       _mm256_srai_epi32(_mm256_unpackhi_epi16(vb, vb), 16));
+
+        sLo = _mm256_srai_epi32(_mm256_add_epi32(sLo, _mm256_srli_epi32(sLo, 31)), 1);
+        sHi = _mm256_srai_epi32(_mm256_add_epi32(sHi, _mm256_srli_epi32(sHi, 31)), 1);
+
+        // unpack und packs arbeiten beide je 128-Bit-Hälfte: Reihenfolge bleibt erhalten
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_packs_epi32(sLo, sHi));
+    }
+    rs_kernels_sse2.mix_avg(out + i, a + i, b + i, count - i);
+}
+
+AVX2 static void add_sat_avx2(int16_t* out, const int16_t* a, const int16_t* b, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_adds_epi16(va, vb));
+    }
+    rs_kernels_sse2.add_sat(out + i, a + i, b + i, count - i);
+}
+
+AVX2 static void fill_avx2(int16_t* out, int16_t value, size_t count) {
+    const __m256i v = _mm256_set1_epi16(value);
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        _mm256_storeu_si256((__m256i*)(out + i), v);
+        _mm256_storeu_si256((__m256i*)(out + i + 16), v);
+        _mm256_storeu_si256((__m256i*)(out + i + 32), v);
+        _mm256_storeu_si256((__m256i*)(out + i + 48), v);
+    }
+    for (; i + 16 <= count; i += 16) {
+        _mm256_storeu_si256((__m256i*)(out + i), v);
+    }
+    rs_kernels_sse2.fill(out + i, value, count - i);
+}
+
+AVX2 static inline __m256i round_floor_avx2(__m256 x) {
+    __m256 v = _mm256_add_ps(x, _mm256_set1_ps(0.5f));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-32768.0f)), _mm256_set1_ps(32767.0f));
+    return _mm256_cvtps_epi32(_mm256_floor_ps(v));
+}
+
+AVX2 static void float_to_s16_avx2(int16_t* out, const float* in, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i lo = round_floor_avx2(_mm256_loadu_ps(in + i));
+        __m256i hi = round_floor_avx2(_mm256_loadu_ps(in + i + 8));
+        _mm256_storeu_si256((__m256i*)(out + i), pack_s32_avx2(lo, hi));
+    }
+    rs_kernels_sse2.float_to_s16(out + i, in + i, count - i);
+}
+
+/**
+ * @brief Zwei Skalarprodukte nebeneinander: Ausgang i in der unteren, i + 4 in
+ * der oberen 128-Bit-Hälfte.
+ */
+AVX2 static inline __m256i dot2_avx2(const int16_t* x0, const int16_t* x1, const int16_t* c0,
+                                     const int16_t* c1, size_t taps) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t j = 0; j < taps; j += 8) {
+        __m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(x0 + j))),
+                                            _mm_loadu_si128((const __m128i*)(x1 + j)), 1);
+        __m256i c = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(c0 + j))),
+                                            _mm_loadu_si128((const __m128i*)(c1 + j)), 1);
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x, c));
+    }
+    return acc;
+}
+
+AVX2 static void fir_q15_avx2(int16_t* out, const int16_t* in, const uint32_t* start,
+                              const int16_t* coef, size_t taps, int shift, size_t count) {
+    const __m256i round = _mm256_set1_epi32(1 << (shift - 1));
+    const __m128i bits = _mm_cvtsi32_si128(shift);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int16_t* c = coef + i * taps;
+        __m256i d[4];
+        for (int k = 0; k < 4; k++) {
+            d[k] = dot2_avx2(in + start[i + k], in + start[i + k + 4], c + k * taps, c + (k + 4) * taps, taps);
+        }
+
+        // Wie hsum4_sse2, je 128-Bit-Hälfte
+        __m256i ab = _mm256_add_epi32(_mm256_unpacklo_epi32(d[0], d[1]), _mm256_unpackhi_epi32(d[0], d[1]));
+        __m256i cd = _mm256_add_epi32(_mm256_unpacklo_epi32(d[2], d[3]), _mm256_unpackhi_epi32(d[2], d[3]));
+        __m256i sum = _mm256_add_epi32(_mm256_unpacklo_epi64(ab, cd), _mm256_unpackhi_epi64(ab, cd));
+        sum = _mm256_sra_epi32(_mm256_add_epi32(sum, round), bits);
+
+        // packs je Hälfte, danach die beiden unteren 64-Bit-Blöcke zusammenziehen
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_castsi256_si128(packed));
+    }
+    rs_kernels_sse2.fir_q15(out + i, in, start + i, coef + i * taps, taps, shift, count - i);
+}
+
+const rs_kernel_table rs_kernels_avx2 = {
+    .name = "avx2",
+    .sine = sine_avx2,
+    .mix_avg = mix_avg_avx2,
+    .add_sat = add_sat_avx2,
+    .fill = fill_avx2,
+    .float_to_s16 = float_to_s16_avx2,
+    .fir_q15 = fir_q15_avx2,
+};
+
+#endif
@@ -0,0 +1,452 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "../include/rawsignal.h"
+#include "../include/job.h"
+#include "../include/signal_generator.h"
+#include "../include/encoders/tones.h"
+#include "../include/encoders/morse.h"
+#include "../include/encoders/fsk9600.h"
+#include "../include/encoders/ufsk1200.h"
+
+#if RS_OK != RS_JOB_OK || RS_FAILED != RS_JOB_FAILED || RS_INVALID != RS_JOB_INVALID
+#error "Rückgabewerte von rawsignal.h und job.h müssen übereinstimmen"
+#endif
+#if RS_NATIVE_RATE != SAMPLE_RATE
+#error "RS_NATIVE_RATE muss SAMPLE_RATE entsprechen"
+#endif
+
+struct rs_context {
+  rs_sink sink;            // Speicher-Sink, bei gesetztem Callback Callback-Sink
+  rs_job_buffers buffers;  // Zwischen Übertragungen wiederverwendet
+  uint32_t sampleRate;
+  rs_output_fn output;
+  void* user;
+};
+
+/**
+ * @brief Reicht einen Block des Sinks als Samples an den Callback des Aufrufers weiter.
+ */
+static int forward_output(void* user, const uint8_t* data, size_t len) {
+  rs_context* ctx = (rs_context*) user;
+  return (ctx->output(ctx->user, (const int16_t*) data, len / sizeof(int16_t)) == 0) ? 0 : ECANCELED;
+}
+
+/**
+ * @brief Legt einen Kontext an.
+ */
+rs_context* rs_context_create(uint32_t sampleRate) {
+  if (sampleRate == 0) {
+    sampleRate = RS_NATIVE_RATE;
+  }
+  if (sampleRate < 1000 || sampleRate > 384000) {
+    return NULL;
+  }
+
+  rs_context* ctx = (rs_context*) calloc(1, sizeof(rs_context));
+  if (ctx == NULL) {
+    return NULL;
+  }
+  if (rs_sink_init_memory(&ctx->sink, RS_BYTE_ORDER_HOST) != 0) {
+    free(ctx);
+    return NULL;
+  }
+  ctx->sampleRate = sampleRate;
+  return ctx;
+}
+
+/**
+ * @brief Gibt einen Kontext samt aller Puffer frei.
+ */
+void rs_context_destroy(rs_context* ctx) {
+  if (ctx == NULL) {
+    return;
+  }
+  rs_sink_close(&ctx->sink);
+  rs_job_buffers_free(&ctx->buffers);
+  free(ctx);
+}
+
+/**
+ * @brief Leitet die Ausgabe an output um (NULL = Speicher).
+ */
+void rs_context_set_output(rs_context* ctx, rs_output_fn output, void* user) {
+  ctx->output = output;
+  ctx->user = user;
+  ctx->sink.callback = (output != NULL) ? forward_output : NULL;
+  ctx->sink.callbackUser = ctx;
+}
+
+/**
+ * @brief Ergebnis der letzten Übertragung im Speichermodus.
+ */
+const int16_t* rs_context_samples(const rs_context* ctx, size_t* count) {
+  *count = ctx->sink.memoryFill / sizeof(int16_t);
+  return (const int16_t*) ctx->sink.memory;
+}
+
+/**
+ * @brief Bereitet den Sink auf eine neue Übertragung vor.
+ */
+static int begin(rs_context* ctx) {
+  rs_sink_reset_memory(&ctx->sink);
+  return (rs_sink_set_rate(&ctx->sink, RS_NATIVE_RATE, ctx->sampleRate) == 0) ? RS_OK : RS_FAILED;
+}
+
+/**
+ * @brief Schließt eine Übertragung ab (Resampler-Nachlauf, letzter Block).
+ */
+static int finish(rs_context* ctx, int result) {
+  if (rs_sink_end_segment(&ctx->sink) != 0 && result == RS_OK) {
+    result = RS_FAILED;
+  }
+  return result;
+}
+
+int rs_render_pocsag(rs_context* ctx, uint32_t baudRate, uint32_t address,
+                     uint32_t functionCode, const char* message) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_job_render_pocsag(&ctx->sink, &ctx->buffers, baudRate, address, functionCode, message);
+  }
+  return finish(ctx, result);
+}
+
+int rs_render_dtmf(rs_context* ctx, const char* digits, int toneMs, int pauseMs) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_job_render_dtmf(&ctx->sink, &ctx->buffers, digits, toneMs, pauseMs);
+  }
+  return finish(ctx, result);
+}
+
+int rs_render_morse(rs_context* ctx, const char* message, uint32_t wpm) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_job_render_morse(&ctx->sink, &ctx->buffers, message, wpm);
+  }
+  return finish(ctx, result);
+}
+
+int rs_render_afsk1200(rs_context* ctx, const char* txCall, const char* destCall, const char* message) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_job_render_afsk1200(&ctx->sink, txCall, destCall, message);
+  }
+  return finish(ctx, result);
+}
+
+int rs_render_fsk9600(rs_context* ctx, const char* txCall, const char* destCall, const char* message) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_job_render_fsk9600(&ctx->sink, txCall, destCall, message);
+  }
+  return finish(ctx, result);
+}
+
+int rs_render_ufsk1200(rs_context* ctx, const char* message) {
+  int result = begin(ctx);
+  if (result == RS_OK) {
+    result = rs_encode_ufsk1200(&ctx->sink, message);
+  }
+  return finish(ctx, result);
+}
+
+// --- GENERATOREN ---
+// Jeder Encoder ist ein fortsetzbarer Strom (*_init/*_step), der je Schritt
+// einen begrenzten Abschnitt in einen Sink schreibt. Der Generator lässt einen
+// Schritt in seinen Speicher-Sink laufen (samt Resampler) und reicht dessen
+// Inhalt an rs_generator_render() weiter; erst wenn er aufgebraucht ist, folgt
+// der nächste Schritt.
+
+typedef enum {
+  GENERATOR_POCSAG,
+  GENERATOR_DTMF,
+  GENERATOR_MORSE,
+  GENERATOR_AFSK1200,
+  GENERATOR_FSK9600,
+  GENERATOR_UFSK1200
+} generator_kind;
+
+struct rs_generator {
+  rs_sink sink;            // Speicher-Sink: Ausgabe des letzten Schritts
+  size_t position;         // Davon bereits übergebene Bytes
+  rs_job_buffers buffers;  // POCSAG-Wörter, DTMF-Wellenformen, Morse-Vorlagen
+  generator_kind kind;
+  int running;             // 1 = weitere Schritte folgen
+  int result;              // RS_OK oder RS_FAILED
+  char* text;              // Kopien der Zeichenketten-Parameter
+  ax25_frame frame;
+  union {
+    struct {
+      pcmStream stream;
+      uint32_t baudRate;
+      int started;         // 1 = Präambel ausgegeben
+    } pocsag;
+    rs_dtmf_stream dtmf;
+    morse_stream morse;
+    rs_afsk1200_stream afsk1200;
+    rs_fsk9600_stream fsk9600;
+    rs_ufsk1200_stream ufsk1200;
+  } u;
+};
+
+/**
+ * @brief Legt einen Generator an und kopiert count Zeichenketten nach copies.
+ * @return Der Generator oder NULL bei ungültiger Rate bzw. Speichermangel.
+ */
+static rs_generator* create_generator(uint32_t sampleRate, generator_kind kind,
+                                      const char* const* strings, const char** copies, int count) {
+  if (sampleRate == 0) {
+    sampleRate = RS_NATIVE_RATE;
+  }
+  if (sampleRate < 1000 || sampleRate > 384000) {
+    fprintf(stderr, "Fehler: Ungültige Ausgabe-Abtastrate. Erlaubt: 1000-384000 Hz.\n");
+    return NULL;
+  }
+
+  size_t length = 0;
+  for (int i = 0; i < count; i++) {
+    length += strlen(strings[i]) + 1;
+  }
+
+  rs_generator* gen = (rs_generator*) calloc(1, sizeof(rs_generator));
+  char* text = (char*) malloc(length);
+  if (gen == NULL || text == NULL || rs_sink_init_memory(&gen->sink, RS_BYTE_ORDER_HOST) != 0) {
+    free(gen);
+    free(text);
+    return NULL;
+  }
+  gen->text = text;
+  gen->kind = kind;
+  gen->running = 1;
+  gen->result = RS_OK;
+
+  for (int i = 0; i < count; i++) {
+    size_t n = strlen(strings[i]) + 1;
+    memcpy(text, strings[i], n);
+    copies[i] = text;
+    text += n;
+  }
+
+  if (rs_sink_set_rate(&gen->sink, RS_NATIVE_RATE, sampleRate) != 0) {
+    rs_generator_destroy(gen);
+    return NULL;
+  }
+  return gen;
+}
+
+/**
+ * @brief Gibt einen Generator frei (auch vor dem Ende der Übertragung).
+ */
+void rs_generator_destroy(rs_generator* gen) {
+  if (gen == NULL) {
+    return;
+  }
+  rs_sink_close(&gen->sink);
+  rs_job_buffers_free(&gen->buffers);
+  free(gen->text);
+  free(gen);
+}
+
+/**
+ * @brief Verwirft einen Generator, dessen Vorbereitung fehlgeschlagen ist.
+ */
+static rs_generator* discard(rs_generator* gen) {
+  rs_generator_destroy(gen);
+  return NULL;
+}
+
+rs_generator* rs_generator_create_pocsag(uint32_t sampleRate, uint32_t baudRate, uint32_t address,
+                                         uint32_t functionCode, const char* message) {
+  if (functionCode > 3) {
+    fprintf(stderr, "Fehler: Ungültiger Funktionscode: %u. Erlaubt: 0-3.\n", functionCode);
+    return NULL;
+  }
+
+  const char* copy;
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_POCSAG, &message, &copy, 1);
+  if (gen == NULL) {
+    return NULL;
+  }
+
+  pocsag_page page = { address, (FunctionCode) functionCode, copy };
+  size_t words;
+  if (rs_job_encode_pocsag_pages(&gen->buffers, baudRate, &page, 1, &words) != RS_JOB_OK) {
+    return discard(gen);
+  }
+  pcmStreamInit(&gen->u.pocsag.stream, SAMPLE_RATE, baudRate, gen->buffers.words, words);
+  gen->u.pocsag.baudRate = baudRate;
+  gen->u.pocsag.started = 0;
+  return gen;
+}
+
+rs_generator* rs_generator_create_dtmf(uint32_t sampleRate, const char* digits, int toneMs, int pauseMs) {
+  if (rs_job_check_dtmf(toneMs, pauseMs) != RS_JOB_OK) {
+    return NULL;
+  }
+
+  const char* copy;
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_DTMF, &digits, &copy, 1);
+  if (gen == NULL) {
+    return NULL;
+  }
+  rs_dtmf_init(&gen->u.dtmf, &gen->sink, copy, toneMs, pauseMs, &gen->buffers.dtmf);
+  return gen;
+}
+
+rs_generator* rs_generator_create_morse(uint32_t sampleRate, const char* message, uint32_t wpm) {
+  const char* copy;
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_MORSE, &message, &copy, 1);
+  if (gen == NULL) {
+    return NULL;
+  }
+  if (rs_job_open_morse(&gen->u.morse, &gen->sink, &gen->buffers, wpm) != RS_JOB_OK) {
+    return discard(gen);
+  }
+  morse_streamSetText(&gen->u.morse, copy, strlen(copy));
+  return gen;
+}
+
+rs_generator* rs_generator_create_afsk1200(uint32_t sampleRate, const char* txCall,
+                                           const char* destCall, const char* message) {
+  const char* strings[3] = { txCall, destCall, message };
+  const char* copies[3];
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_AFSK1200, strings, copies, 3);
+  if (gen == NULL) {
+    return NULL;
+  }
+
+  gen->frame.txCall = copies[0];
+  gen->frame.destCall = copies[1];
+  gen->frame.message = copies[2];
+  if (rs_job_check_ax25_frames(&gen->frame, 1) != RS_JOB_OK) {
+    return discard(gen);
+  }
+  rs_afsk1200_init(&gen->u.afsk1200, &gen->sink, &gen->frame, 1);
+  return gen;
+}
+
+rs_generator* rs_generator_create_fsk9600(uint32_t sampleRate, const char* txCall,
+                                          const char* destCall, const char* message) {
+  const char* strings[3] = { txCall, destCall, message };
+  const char* copies[3];
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_FSK9600, strings, copies, 3);
+  if (gen == NULL) {
+    return NULL;
+  }
+
+  gen->frame.txCall = copies[0];
+  gen->frame.destCall = copies[1];
+  gen->frame.message = copies[2];
+  if (rs_job_check_ax25_frames(&gen->frame, 1) != RS_JOB_OK) {
+    return discard(gen);
+  }
+  if (rs_fsk9600_init(&gen->u.fsk9600, &gen->sink, &gen->frame) != 0) {
+    fprintf(stderr, "Fehler: FSK9600 benötigt eine Nachricht.\n");
+    return discard(gen);
+  }
+  return gen;
+}
+
+rs_generator* rs_generator_create_ufsk1200(uint32_t sampleRate, const char* message) {
+  const char* copy;
+  rs_generator* gen = create_generator(sampleRate, GENERATOR_UFSK1200, &message, &copy, 1);
+  if (gen == NULL) {
+    return NULL;
+  }
+  if (rs_ufsk1200_init(&gen->u.ufsk1200, &gen->sink, copy) != 0) {
+    fprintf(stderr, "Fehler: UFSK1200 benötigt eine Nachricht.\n");
+    return discard(gen);
+  }
+  return gen;
+}
+
+/**
+ * @brief Ein POCSAG-Schritt: zuerst die vorab gerenderte Präambel, danach je
+ * ein Block von PCM_BLOCK_SAMPLES Samples.
+ */
+static int step_pocsag(rs_generator* gen) {
+  pcmStream* stream = &gen->u.pocsag.stream;
+  if (!gen->u.pocsag.started) {
+    gen->u.pocsag.started = 1;
+    size_t n;
+    const int16_t* preamble = pcmStreamSkipPreamble(stream, SAMPLE_RATE, gen->u.pocsag.baudRate, &n);
+    if (preamble != NULL) {
+      rs_sink_write(&gen->sink, preamble, n);
+      return 1;
+    }
+  }
+
+  int16_t pcm[PCM_BLOCK_SAMPLES];
+  size_t n = pcmStreamRender(stream, pcm, PCM_BLOCK_SAMPLES);
+  rs_sink_write(&gen->sink, pcm, n);
+  return n > 0;
+}
+
+/**
+ * @brief Lässt den Encoder einen Schritt weiterlaufen und sammelt die Ausgabe im Sink.
+ * * Nach dem letzten Schritt schiebt rs_sink_end_segment() den Resampler-Nachlauf aus.
+ */
+static void advance(rs_generator* gen) {
+  int more;
+  switch (gen->kind) {
+    case GENERATOR_POCSAG: more = step_pocsag(gen); break;
+    case GENERATOR_DTMF: more = rs_dtmf_step(&gen->u.dtmf); break;
+    case GENERATOR_MORSE:
+      more = morse_streamStep(&gen->u.morse);
+      if (!more && morse_streamFinish(&gen->u.morse) == 0) {
+        fprintf(stderr, "Fehler: Morse-Kodierung erzeugte kein Signal.\n");
+        gen->result = RS_FAILED;
+      }
+      break;
+    case GENERATOR_AFSK1200: more = rs_afsk1200_step(&gen->u.afsk1200); break;
+    case GENERATOR_FSK9600: more = rs_fsk9600_step(&gen->u.fsk9600); break;
+    default: more = rs_ufsk1200_step(&gen->u.ufsk1200); break;
+  }
+
+  if (more && gen->sink.error == 0) {
+    rs_sink_flush(&gen->sink);
+  } else {
+    rs_sink_end_segment(&gen->sink);
+    gen->running = 0;
+  }
+  if (gen->sink.error != 0) {
+    gen->running = 0;
+    gen->result = RS_FAILED;
+  }
+}
+
+/**
+ * @brief Schreibt die nächsten (höchstens count) Samples der Übertragung nach out.
+ */
+size_t rs_generator_render(rs_generator* gen, int16_t* out, size_t count) {
+  size_t done = 0;
+  while (done < count) {
+    size_t available = (gen->sink.memoryFill - gen->position) / sizeof(int16_t);
+    if (available == 0) {
+      if (!gen->running || gen->result != RS_OK) {
+        break;
+      }
+      rs_sink_reset_memory(&gen->sink);
+      gen->position = 0;
+      advance(gen);
+      continue;
+    }
+
+    size_t n = (count - done < available) ? count - done : available;
+    memcpy(out + done, gen->sink.memory + gen->position, n * sizeof(int16_t));
+    gen->position += n * sizeof(int16_t);
+    done += n;
+  }
+  return done;
+}
+
+/**
+ * @brief Zustand eines Generators (RS_OK oder RS_FAILED).
+ */
+int rs_generator_status(const rs_generator* gen) {
+  return gen->result;
+}
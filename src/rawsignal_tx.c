@@ -1,22 +1,22 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <time.h>
-#include <strings.h>
-#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
 
 #include "../include/signal_generator.h"
-#include "../include/encoders/pocsag.h"
-#include "../include/encoders/tones.h" 
-#include "../include/encoders/morse.h" 
-#include "../include/encoders/afsk1200.h"
-#include "../include/encoders/fsk9600.h"
-#include "../include/encoders/ufsk1200.h"
+#include "../include/sink.h"
+#include "../include/job.h"
+#include "../include/batch.h"
+#include "../include/server.h"
+#include "../include/realtime.h"
 
-// Standardwerte
-#define MAX_DELAY 10 // Sekunden
-#define MIN_DELAY 1 // Sekunden
+// Standardwerte (nur für die Hilfe; die Jobs nutzen dieselben Werte)
 #define DTMF_TONE_MS 50
 #define DTMF_PAUSE_MS 50
 #define MORSE_WPM_DEFAULT 20
@@ -27,10 +27,29 @@
  * @brief Gibt eine Fehlermeldung zur korrekten Nutzung des Programms aus.
  */
 static void print_usage(const char* progName) {
-  fprintf(stderr, "Nutzung: %s <MODULATOR> <PARAMETER>\n", progName);
+  fprintf(stderr, "Nutzung: %s [--seed N] [-r RATE] [-L|-B] [-o DATEI] <MODULATOR> <PARAMETER>\n", progName);
+  fprintf(stderr, "\nOptionen:\n");
+  fprintf(stderr, " -r RATE  Ausgabe-Abtastrate in Hz (Standard: %d, z.B. 48000 oder 8000)\n", SAMPLE_RATE);
+  fprintf(stderr, " -L / -B  Ausgabe als S16_LE (Standard) / S16_BE\n");
+  fprintf(stderr, " -o DATEI In Datei statt stdout schreiben (*.wav: mit WAV-Header, Stille als Loch)\n");
+  fprintf(stderr, " --seed N Startwert für die zufällige End-Stille (Standard: Uhrzeit)\n");
+  fprintf(stderr, " --repeat N    Übertragung einmal rendern und N-mal ausgeben (Baken)\n");
+  fprintf(stderr, " --interval S  Pause zwischen den Wiederholungen in Sekunden (Standard: 0)\n");
+  fprintf(stderr, " --cache DIR   Gerenderte Übertragungen in DIR ablegen und wiederverwenden\n");
+  fprintf(stderr, " --realtime    Ausgabe im Takt der Ausgaberate freigeben (SDR, Soundkarte)\n");
+  fprintf(stderr, "               (Takt = globale -r; Batch-Zeilen mit anderem -r nur mit eigenem -o, ungetaktet)\n");
+  fprintf(stderr, " --mlock       Mit --realtime: Speicher per mlockall sperren\n");
+  fprintf(stderr, "\nBatch-Modus: %s [-j N] [--unordered] [--realtime] [OPTIONEN] --batch [JOBDATEI|-]\n", progName);
+  fprintf(stderr, " Je Zeile ein Job: [OPTIONEN] <MODULATOR> <PARAMETER> (# = Kommentar)\n");
+  fprintf(stderr, " (-r/-L/-B abweichend von den globalen Werten nur zusammen mit -o)\n");
+  fprintf(stderr, " -j N         N Worker-Threads (Standard: 1)\n");
+  fprintf(stderr, " --unordered  Gemeinsame Ausgabe in Fertigstellungs- statt Eingabereihenfolge\n");
+  fprintf(stderr, "\nDienst:  %s [--seed N] [OPTIONEN] --serve SOCKET\n", progName);
+  fprintf(stderr, "Client:  %s --connect SOCKET [<MODULATOR> <PARAMETER>]  (ohne Job: Jobzeilen von stdin)\n", progName);
   fprintf(stderr, "\nVerfügbare Modulatoren:\n");
-  fprintf(stderr, " POCSAG [BAUD] [ADRESSE]:[FUNKTION]:[NACHRICHT]\n");
+  fprintf(stderr, " POCSAG [BAUD] [ADRESSE[,ADRESSE...]]:[FUNKTION]:[NACHRICHT] [...]\n");
   fprintf(stderr, " Beispiel: %s POCSAG 512 1234567:3:HALLO\n", progName);
+  fprintf(stderr, " (Mehrere Seiten bzw. Adressen: eine gemeinsame Übertragung)\n");
   fprintf(stderr, "\n DTMF [SEQUENZ] [TON_DAUER_MS] [PAUSE_DAUER_MS]\n");
   fprintf(stderr, " Beispiel: %s DTMF 123456# 50 50\n", progName);
   fprintf(stderr, " (Standarddauern: Ton=%dms, Pause=%dms)\n", DTMF_TONE_MS, DTMF_PAUSE_MS);
@@ -38,284 +57,191 @@ static void print_usage(const char* progName) {
   fprintf(stderr, " Beispiel: %s MORSE_CW CQDX 20\n", progName);
   fprintf(stderr, " (Standard WPM: %d)\n", MORSE_WPM_DEFAULT);
   
-  fprintf(stderr, "\n AFSK1200 [TX_CALL] [DEST_CALL] [NACHRICHT]\n");
+  fprintf(stderr, "\n AFSK1200 [TX_CALL] [DEST_CALL] [NACHRICHT] [NACHRICHT...]\n");
   fprintf(stderr, " Beispiel: %s AFSK1200 DL1ABC APRS 'Hallo Welt'\n", progName);
+  fprintf(stderr, " (Jede weitere Nachricht wird ein eigener Frame derselben Übertragung)\n");
   fprintf(stderr, " (Standard: Sender=%s, Empfänger=%s)\n", AFSK_DEFAULT_TX_CALL, AFSK_DEFAULT_DEST_CALL);
   
-  fprintf(stderr, "\n FSK9600 [NACHRICHT]\n");
-  fprintf(stderr, " Beispiel: %s FSK9600 'Hallo'\n", progName);
+  fprintf(stderr, "\n FSK9600 [TX_CALL] [DEST_CALL] [NACHRICHT]\n");
+  fprintf(stderr, " Beispiel: %s FSK9600 DL1ABC APRS 'Hallo'\n", progName);
+  fprintf(stderr, " (AX.25-UI-Frame als G3RUH-Basisband: Bit-Stuffing, NRZI, Scrambler, Raised-Cosine-Pulsformung)\n");
   
   fprintf(stderr, "\n UFSK1200 [NACHRICHT]\n");
   fprintf(stderr, " Beispiel: %s UFSK1200 'Hallo'\n", progName);
 }
 
 
-// --- HILFSFUNKTIONEN FÜR DIE MORSE-GENERIERUNG ---
+// --- HAUPTPROGRAMM ---
+
+typedef struct {
+  rs_job* job;
+  FILE* input;                         // Jobdatei (nur Batch-Modus)
+  const rs_batch_options* batchOptions;
+  int result;                          // Roh-Ergebnis von rs_job_render
+} output_context;
 
 /**
- * @brief Führt die Kodierung und Ausgabe für Morse durch.
+ * @brief Rendert die ganze Ausgabe (Einzeljob oder Batch) in sink.
+ * * Direkt oder als Erzeuger von rs_realtime_run aufgerufen.
  */
-static int handle_morse_encoding(const char* message, uint32_t wpm) {
-  // 1. Puffergröße berechnen
-  size_t requiredSamples = morse_messageLength(message, wpm);
-  if (requiredSamples == 0) {
-    fprintf(stderr, "Fehler: Puffergröße für Morsecode konnte nicht berechnet werden.\n");
-    return 1;
-  }
-
-  // 2. Speicher zuweisen (int16_t = 2 Bytes pro Sample)
-  int16_t* pcm = (int16_t*) malloc(sizeof(int16_t) * requiredSamples);
-  if (pcm == NULL) {
-    fprintf(stderr, "Fehler: Speicherzuweisung für Morse-PCM-Puffer fehlgeschlagen.\n");
-    return 1;
-  }
-
-  // 3. Kodierung
-  size_t actualSamples = morse_encodeTransmission(message, wpm, pcm, requiredSamples);
-
-  // 4. Ausgabe
-  if (actualSamples > 0) {
-    // Ausgabe als Signed 16-bit Little-Endian (S16_LE)
-    fwrite(pcm, sizeof(int16_t), actualSamples, stdout);
-  } else {
-    fprintf(stderr, "Fehler: Morse-Kodierung erzeugte kein Signal.\n");
+static int render_output(void* user, rs_sink* sink) {
+  output_context* ctx = (output_context*) user;
+  if (ctx->input != NULL) {
+    ctx->result = rs_batch_run(ctx->input, ctx->job, sink, ctx->batchOptions);
+    return ctx->result;
   }
 
-  free(pcm);
-  return (actualSamples > 0) ? 0 : 1;
+  rs_job_buffers buffers = { 0 };
+  ctx->result = rs_job_render(ctx->job, sink, &buffers);
+  rs_job_buffers_free(&buffers);
+  return (ctx->result == RS_JOB_OK) ? 0 : 1;
 }
 
-// --- HAUPTPROGRAMM ---
-
 /**
  * @brief Hauptfunktion des Programms.
  */
 int main(int argc, char* argv[]) {
-  srand(time(NULL));
-
-  if (argc < 3) {
-    print_usage(argv[0]);
-    return 1;
+  const char* progName = argv[0];
+  const char* batchPath = NULL;
+  const char* servePath = NULL;
+  int batch = 0;
+  int realtime = 0;
+  int lockMemory = 0;
+  rs_batch_options batchOptions = { 1, 1 };
+  rs_job job = {
+    .outputRate = SAMPLE_RATE,
+    .order = RS_BYTE_ORDER_LE,
+    .seed = (unsigned int) time(NULL),
+    .repeat = 1,
+  };
+
+  // Client für einen laufenden Dienst: alle weiteren Argumente bilden den Job
+  if (argc > 2 && strcmp(argv[1], "--connect") == 0) {
+    signal(SIGPIPE, SIG_IGN);
+    return rs_client_run(argv[2], argc - 3, argv + 3);
   }
 
-  const char* modulator = argv[1];
-  int result = 0; // Ergebnis der Kodierung
-
-  // --- 1. POCSAG-Logik ---
-  if (strcasecmp(modulator, "POCSAG") == 0) {
-    if (argc < 4) {
-      fprintf(stderr, "Fehler: POCSAG benötigt BAUD und ADRESSE:NACHRICHT.\n");
-      print_usage(argv[0]);
-      return 1;
-    }
-    
-    uint32_t baudRate = (uint32_t) strtol(argv[2], NULL, 10);
-    char* input_string = argv[3];
-
-    if (baudRate != 512 && baudRate != 1200 && baudRate != 2400) {
-      fprintf(stderr, "Fehler: Ungültige POCSAG-Baudrate. Erlaubt: 512, 1200, 2400.\n");
-      return 1;
-    }
-
-    uint32_t address = 0;
-    FunctionCode functionCode = FUNC_ALPHA_TEXT;
-    char* message = NULL;
-    // Puffer für strtok Kopie
-    char inputCopy[65536]; 
-
-    strncpy(inputCopy, input_string, sizeof(inputCopy) - 1);
-    inputCopy[sizeof(inputCopy) - 1] = '\0';
-
-    char* token = strtok(inputCopy, ":");
-    if (token == NULL) {
-      fprintf(stderr, "Fehler: Ungültiges POCSAG-Nachrichtenformat. Erwarte ADDR:MSG.\n");
-      return 1;
+  // Batch-Modus und Dienst: globale Optionen davor gelten als Standard für alle Jobs
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--batch") == 0) {
+      batch = 1;
+      batchPath = (i + 1 < argc) ? argv[i + 1] : NULL;
+      argc = i;
+      break;
     }
-    address = (uint32_t) strtol(token, NULL, 10);
-
-    char* funcOrMsgToken = strtok(NULL, ":");
-    if (funcOrMsgToken == NULL) {
-      fprintf(stderr, "Fehler: Nachrichtenteil fehlt.\n");
-      return 1;
+    if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+      batch = 1;
+      servePath = argv[i + 1];
+      argc = i;
+      break;
     }
+  }
 
-    char* messageToken = strtok(NULL, ":");
-
-    if (messageToken != NULL) {
-      // Format: ADDR:FUNC:MSG
-      functionCode = (FunctionCode) strtol(funcOrMsgToken, NULL, 10);
-      message = messageToken;
+  // Programmweite Optionen (vor den Job-Optionen)
+  while (argc > 1) {
+    if (strcmp(argv[1], "-j") == 0 && argc > 2) {
+      long threads = strtol(argv[2], NULL, 10);
+      if (threads < 1 || threads > RS_BATCH_MAX_THREADS) {
+        fprintf(stderr, "Fehler: Ungültige Thread-Anzahl. Erlaubt: 1-%d.\n", RS_BATCH_MAX_THREADS);
+        return 1;
+      }
+      batchOptions.threads = (unsigned int) threads;
+    } else if (strcmp(argv[1], "--seed") == 0 && argc > 2) {
+      job.seed = (unsigned int) strtoul(argv[2], NULL, 10);
+    } else if (strcmp(argv[1], "--unordered") == 0) {
+      batchOptions.ordered = 0;
+      argv++;
+      argc--;
+      continue;
+    } else if (strcmp(argv[1], "--realtime") == 0) {
+      realtime = 1;
+      argv++;
+      argc--;
+      continue;
+    } else if (strcmp(argv[1], "--mlock") == 0) {
+      lockMemory = 1;
+      argv++;
+      argc--;
+      continue;
     } else {
-      // Format: ADDR:MSG
-      message = funcOrMsgToken;
-      functionCode = FUNC_ALPHA_TEXT;
-    }
-
-    if (address > 2097151) {
-      fprintf(stderr, "Fehler: Adresse überschreitet 21 Bits: %u\n", address);
-      return 1;
-    }
-    if (functionCode > 3) {
-      fprintf(stderr, "Fehler: Ungültiger Funktionscode: %u. Erlaubt: 0-3.\n", functionCode);
-      return 1;
-    }
-    fprintf(stderr, "Info: POCSAG-Kodierung: Adresse %u, Baud %u, Code %u.\n", address, baudRate, functionCode);
-
-
-    // Kodierung
-    size_t requiredMessageLength = pocsag_messageLength(address, strlen(message), functionCode);
-    uint32_t* transmission = (uint32_t*) malloc(sizeof(uint32_t) * requiredMessageLength);
-    
-    if (transmission == NULL) {
-      fprintf(stderr, "Fehler: Speicherzuweisung für POCSAG-Wörter fehlgeschlagen.\n");
-      return 1;
-    }
-
-    pocsag_encodeTransmission(address, message, transmission, functionCode);
-
-    // Signalerzeugung und Ausgabe
-    size_t pcmLength = pcmTransmissionLength(SAMPLE_RATE, baudRate, requiredMessageLength) * sizeof(int16_t); // Länge in Bytes
-    int16_t* pcm = (int16_t*) malloc(pcmLength); // Größe in int16_t Samples
-    
-    if (pcm == NULL) {
-      fprintf(stderr, "Fehler: Speicherzuweisung für PCM-Puffer fehlgeschlagen.\n");
-      free(transmission);
-      return 1;
-    }
-
-    // Annahme: pcmEncodeTransmission ist jetzt für int16_t optimiert
-    pcmEncodeTransmission(SAMPLE_RATE, baudRate, transmission, requiredMessageLength, pcm);
-    fwrite(pcm, sizeof(int16_t), pcmLength / sizeof(int16_t), stdout);
-
-    free(transmission);
-    free(pcm);
-    
-    result = 0; // Erfolg
-
-  // --- 2. DTMF-Logik ---
-  } else if (strcasecmp(modulator, "DTMF") == 0) {
-    if (argc < 3) {
-      fprintf(stderr, "Fehler: DTMF benötigt mindestens die Ton-Sequenz.\n");
-      print_usage(argv[0]);
-      return 1;
+      break;
     }
+    argv += 2;
+    argc -= 2;
+  }
+  argv[0] = (char*) progName;
 
-    const char* digits = argv[2];
-    int tone_duration = DTMF_TONE_MS;
-    int pause_duration = DTMF_PAUSE_MS;
+  int parsed = batch
+      ? ((rs_job_parse_options(&job, argc - 1, argv + 1) == argc - 1) ? RS_JOB_OK : RS_JOB_INVALID)
+      : rs_job_parse(&job, argc - 1, argv + 1);
+  if (parsed != RS_JOB_OK) {
+    print_usage(progName);
+    return 1;
+  }
 
-    if (argc >= 4) {
-      tone_duration = (int) strtol(argv[3], NULL, 10);
-    }
-    if (argc >= 5) {
-      pause_duration = (int) strtol(argv[4], NULL, 10);
-    }
+  // Schreibfehler (z.B. geschlossene Pipe) als EPIPE melden statt per Signal abzubrechen
+  signal(SIGPIPE, SIG_IGN);
 
-    if (tone_duration <= 0 || pause_duration <= 0) {
-      fprintf(stderr, "Fehler: Ton- und Pausendauer müssen positiv sein.\n");
+  if (servePath != NULL) {
+    if (job.outputPath != NULL) {
+      fprintf(stderr, "Fehler: -o ist im Dienst nur je Anfrage möglich.\n");
       return 1;
     }
-
-    fprintf(stderr, "Info: DTMF-Kodierung: '%s' (Ton: %dms, Pause: %dms)\n", 
-            digits, tone_duration, pause_duration);
-
-    // Der DTMF-Encoder schreibt die Samples direkt an stdout (als S16_LE)
-    result = rs_encode_dtmf(digits, tone_duration, pause_duration);
-    
-  // --- 3. MORSE_CW-Logik ---
-  } else if (strcasecmp(modulator, "MORSE_CW") == 0) {
-    if (argc < 3) {
-      fprintf(stderr, "Fehler: MORSE_CW benötigt die Nachricht.\n");
-      print_usage(argv[0]);
+    if (realtime) {
+      fprintf(stderr, "Fehler: --realtime ist im Dienst nicht möglich.\n");
       return 1;
     }
-    
-    const char* message = argv[2];
-    uint32_t wpm = MORSE_WPM_DEFAULT;
+    return rs_serve(servePath, &job);
+  }
 
-    if (argc >= 4) {
-      wpm = (uint32_t) strtol(argv[3], NULL, 10);
-    }
-    
-    if (wpm == 0 || wpm > 60) {
-      fprintf(stderr, "Fehler: Ungültige WPM. Erlaubt: 1-60.\n");
-      return 1;
-    }
+  rs_sink out;
+  int opened = (job.outputPath != NULL)
+      ? rs_sink_open_file(&out, job.outputPath, job.order, job.outputRate)
+      : rs_sink_init_fd(&out, STDOUT_FILENO, job.order);
+  if (opened != 0) {
+    return 1;
+  }
 
-    fprintf(stderr, "Info: MORSE_CW-Kodierung: '%s' bei %u WPM.\n", message, wpm);
-    
-    result = handle_morse_encoding(message, wpm);
+  output_context ctx = { &job, NULL, &batchOptions, RS_JOB_OK };
+  if (batch) {
+    ctx.input = stdin;
+    if (batchPath != NULL && strcmp(batchPath, "-") != 0) {
+      ctx.input = fopen(batchPath, "r");
+      if (ctx.input == NULL) {
+        fprintf(stderr, "Fehler: Jobdatei '%s' konnte nicht geöffnet werden: %s\n", batchPath, strerror(errno));
+        rs_sink_close(&out);
+        return 1;
+      }
+    }
+    job.quiet = 1;
+  }
 
-  
-  // --- 4. AFSK1200-Logik (NEU) ---
-  } else if (strcasecmp(modulator, "AFSK1200") == 0) {
-    
-    if (argc < 4) {
-      fprintf(stderr, "Fehler: AFSK1200 benötigt mindestens Sender-Call und Nachricht.\n");
-      print_usage(argv[0]);
-      return 1;
-    }
+  int result;
+  if (realtime) {
+    // Takt nach der globalen Ausgaberate; Batch-Zeilen mit abweichendem -r ohne
+    // eigenes -o lehnt rs_job_run_line ab, mit -o gehen sie ungetaktet in ihre Datei
+    rs_realtime_options options;
+    rs_realtime_stats stats;
+    rs_realtime_defaults(&options, job.outputRate, job.order);
+    options.lockMemory = lockMemory;
+    result = rs_realtime_run(&out, &options, render_output, &ctx, &stats);
+    rs_realtime_report(&stats, job.outputRate);
+  } else {
+    result = render_output(&ctx, &out);
+  }
 
-    // Argumente: [0]prog | [1]AFSK1200 | [2]TX_CALL | [3]DEST_CALL | [4]MESSAGE
-    
-    const char* tx_call = argv[2];
-    const char* dest_call = argv[3];
-    const char* message = (argc >= 5) ? argv[4] : ""; 
+  if (ctx.input != NULL && ctx.input != stdin) {
+    fclose(ctx.input);
+  }
+  if (!batch && ctx.result == RS_JOB_INVALID) {
+    print_usage(progName);
+  }
 
-    // Rudimentäre Validierung
-    if (strlen(tx_call) > 10 || strlen(dest_call) > 10) {
-      fprintf(stderr, "Fehler: Callsigns dürfen 10 Zeichen nicht überschreiten (AX.25-Limit).\n");
-      return 1;
-    }
-    
-    fprintf(stderr, "Info: AFSK1200: %s an %s, Nachricht: '%.20s...'\n", 
-        tx_call, dest_call, message);
-    
-    // Aufruf der AFSK1200 Hauptfunktion
-    result = rs_encode_afsk1200(tx_call, dest_call, message);
-    
-  } else if (strcasecmp(modulator, "FSK9600") == 0) {
-    if (argc < 3) {
-      fprintf(stderr, "Fehler: FSK9600 benötigt eine Nachricht.\n");
-      print_usage(argv[0]);
-      return 1;
-    }
-    
-    const char* message = argv[2];
-    result = rs_encode_fsk9600(message);
-    
-  } else if (strcasecmp(modulator, "UFSK1200") == 0) {
-    if (argc < 3) {
-      fprintf(stderr, "Fehler: UFSK1200 benötigt eine Nachricht.\n");
-      print_usage(argv[0]);
-      return 1;
-    }
-    
-    const char* message = argv[2];
-    result = rs_encode_ufsk1200(message);
-    
-  } else {
-    fprintf(stderr, "Fehler: Unbekannter Modulator '%s'.\n", modulator);
-    print_usage(argv[0]);
+  // Letzter Flush-Punkt: Restpuffer ausgeben, Datei abschließen
+  if (rs_sink_close(&out) != 0 && out.error != 0) {
+    fprintf(stderr, "Fehler: Ausgabe fehlgeschlagen: %s\n", strerror(out.error));
     result = 1;
   }
 
-  // --- ZUFÄLLIGE END-STILLE (Wird nur bei Erfolg hinzugefügt) ---
-  if (result == 0) {
-    // Füge zufällige Stille am Ende hinzu (für SDR-Tools oft nützlich)
-    // Die Berechnung ergibt die Anzahl der Samples (int16_t)
-    size_t silenceSamples = rand() % (SAMPLE_RATE * (MAX_DELAY - MIN_DELAY)) + (SAMPLE_RATE * MIN_DELAY);
-    
-    uint16_t* silence = (uint16_t*) malloc(sizeof(uint16_t) * silenceSamples); 
-    
-    if (silence != NULL) {
-      // Fülle den Puffer mit Nullen (Stille)
-      memset(silence, 0, sizeof(uint16_t) * silenceSamples);
-      // Schreibe die Samples (int16_t)
-      fwrite(silence, sizeof(uint16_t), silenceSamples, stdout);
-      free(silence);
-    }
-  }
-  
   return result;
-}
\ No newline at end of file
+}
@@ -0,0 +1,302 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "../include/realtime.h"
+
+#define RT_CACHE_LINE 64
+#define RT_POLL_NS 500000 // Warteschritt beim Vorlauf (0.5 ms)
+
+// --- SPSC-RING ---
+// head schreibt nur der Erzeuger, tail nur die Freigabe; beide zählen Bytes
+// fortlaufend (Position im Puffer = Zähler & (capacity - 1)). Die Größe ist
+// eine gerade Zweierpotenz und alle Schritte sind ganze Samples, Samples
+// liegen daher nie über der Grenze eines Abschnitts.
+typedef struct {
+  uint8_t* data;
+  size_t capacity;
+  long waitNs;                          // Schlaf des Erzeugers bei vollem Ring
+  char pad0[RT_CACHE_LINE];
+  uint64_t head;                        // atomar, vom Erzeuger geschrieben
+  char pad1[RT_CACHE_LINE];
+  uint64_t tail;                        // atomar, von der Freigabe geschrieben
+  char pad2[RT_CACHE_LINE];
+  int done;                             // atomar: Erzeuger fertig, head endgültig
+  int abort;                            // atomar: Ausgabe fehlgeschlagen
+} rt_ring;
+
+typedef struct {
+  rt_ring* ring;
+  const rs_realtime_options* options;
+  rs_realtime_producer producer;
+  void* user;
+  int result;
+} rt_producer_args;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static void sleep_ns(long ns) {
+  struct timespec ts = { 0, ns };
+  nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief Schläft bis zum absoluten Termin (CLOCK_MONOTONIC), auch über Signale hinweg.
+ */
+static void sleep_until(uint64_t deadline) {
+  struct timespec ts = { (time_t) (deadline / 1000000000u), (long) (deadline % 1000000000u) };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+}
+
+/**
+ * @brief Zeitpunkt von Sample samples relativ zum Start (ns), ohne Überlauf bei langen Läufen.
+ */
+static uint64_t sample_offset_ns(uint64_t samples, uint32_t rate) {
+  return (samples / rate) * 1000000000u + (samples % rate) * 1000000000u / rate;
+}
+
+/**
+ * @brief Callback des Erzeuger-Sinks: kopiert einen Block in den Ring und
+ * wartet, solange er voll ist.
+ */
+static int ring_push(void* user, const uint8_t* data, size_t len) {
+  rt_ring* ring = (rt_ring*) user;
+  uint64_t head = ring->head;
+
+  while (len > 0) {
+    if (__atomic_load_n(&ring->abort, __ATOMIC_ACQUIRE)) {
+      return EPIPE;
+    }
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    size_t space = ring->capacity - (size_t) (head - tail);
+    if (space == 0) {
+      sleep_ns(ring->waitNs);
+      continue;
+    }
+
+    size_t n = (len < space) ? len : space;
+    size_t offset = (size_t) head & (ring->capacity - 1);
+    size_t first = (n < ring->capacity - offset) ? n : ring->capacity - offset;
+    memcpy(ring->data + offset, data, first);
+    memcpy(ring->data, data + first, n - first);
+
+    head += n;
+    __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    data += n;
+    len -= n;
+  }
+  return 0;
+}
+
+/**
+ * @brief Gibt len Bytes aus dem Ring an out weiter und macht den Platz frei.
+ */
+static void ring_release(rt_ring* ring, rs_sink* out, size_t len) {
+  uint64_t tail = ring->tail;
+  size_t offset = (size_t) tail & (ring->capacity - 1);
+  size_t first = (len < ring->capacity - offset) ? len : ring->capacity - offset;
+  rs_sink_write_bytes(out, ring->data + offset, first);
+  if (len > first) {
+    rs_sink_write_bytes(out, ring->data, len - first);
+  }
+  __atomic_store_n(&ring->tail, tail + len, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Erzeuger-Thread: rendert über einen Callback-Sink in den Ring.
+ */
+static void* producer_main(void* arg) {
+  rt_producer_args* args = (rt_producer_args*) arg;
+  rs_sink feed;
+
+  if (rs_sink_init_callback(&feed, args->options->order, ring_push, args->ring) != 0) {
+    args->result = 1;
+  } else {
+    args->result = args->producer(args->user, &feed);
+    if (rs_sink_close(&feed) != 0) {
+      args->result = 1;
+    }
+  }
+
+  __atomic_store_n(&args->ring->done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+/**
+ * @brief Setzt die Standardwerte (RS_REALTIME_*) für rate und order.
+ */
+void rs_realtime_defaults(rs_realtime_options* options, uint32_t rate, rs_byte_order order) {
+  options->rate = rate;
+  options->order = order;
+  options->blockMs = RS_REALTIME_BLOCK_MS;
+  options->bufferMs = RS_REALTIME_BUFFER_MS;
+  options->prefillMs = RS_REALTIME_PREFILL_MS;
+  options->lockMemory = 0;
+}
+
+/**
+ * @brief Rendert per producer in einen Ring und gibt ihn getaktet an out aus.
+ */
+int rs_realtime_run(rs_sink* out, const rs_realtime_options* options, rs_realtime_producer producer,
+                    void* user, rs_realtime_stats* stats) {
+  uint64_t start = now_ns();
+  memset(stats, 0, sizeof(*stats));
+
+  size_t blockSamples = (size_t) ((uint64_t) options->rate * options->blockMs / 1000);
+  if (blockSamples == 0) {
+    blockSamples = 1;
+  }
+  size_t blockBytes = blockSamples * sizeof(int16_t);
+  size_t prefillBytes = (size_t) ((uint64_t) options->rate * options->prefillMs / 1000) * sizeof(int16_t);
+
+  // Ring: Zweierpotenz, mindestens zwei volle Sink-Blöcke und zwei Freigabe-Blöcke
+  size_t want = (size_t) ((uint64_t) options->rate * options->bufferMs / 1000) * sizeof(int16_t);
+  if (want < 2 * RS_SINK_BUFFER_BYTES) want = 2 * RS_SINK_BUFFER_BYTES;
+  if (want < 2 * blockBytes) want = 2 * blockBytes;
+  if (prefillBytes > want - RS_SINK_BUFFER_BYTES) prefillBytes = want - RS_SINK_BUFFER_BYTES;
+
+  rt_ring ring;
+  memset(&ring, 0, sizeof(ring));
+  ring.capacity = RS_SINK_BUFFER_BYTES;
+  while (ring.capacity < want) {
+    ring.capacity *= 2;
+  }
+  ring.waitNs = (long) (options->blockMs * 1000000L / 2);
+  if (ring.waitNs <= 0) {
+    ring.waitNs = RT_POLL_NS;
+  }
+  ring.data = (uint8_t*) malloc(ring.capacity);
+  if (ring.data == NULL) {
+    fprintf(stderr, "Fehler: Speicherzuweisung für den Echtzeit-Puffer fehlgeschlagen.\n");
+    return 1;
+  }
+  memset(ring.data, 0, ring.capacity); // Seiten vorab einblenden
+  stats->capacity = ring.capacity / sizeof(int16_t);
+  stats->minFill = SIZE_MAX;
+
+  if (options->lockMemory) {
+    stats->locked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+    if (!stats->locked) {
+      fprintf(stderr, "Hinweis: mlockall nicht möglich: %s\n", strerror(errno));
+    }
+  }
+
+  // Erzeuger vor dem Anheben der Priorität starten, damit er normal geplant wird
+  rt_producer_args args = { &ring, options, producer, user, 0 };
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, producer_main, &args) != 0) {
+    fprintf(stderr, "Fehler: Erzeuger-Thread konnte nicht gestartet werden.\n");
+    if (stats->locked) munlockall();
+    free(ring.data);
+    return 1;
+  }
+
+  int oldPolicy;
+  struct sched_param oldParam;
+  pthread_getschedparam(pthread_self(), &oldPolicy, &oldParam);
+  struct sched_param param;
+  memset(&param, 0, sizeof(param));
+  param.sched_priority = sched_get_priority_max(SCHED_FIFO) / 2;
+  stats->fifo = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+
+  // Vorlauf: erster Block erst, wenn prefillMs gerendert sind (oder alles)
+  while (!__atomic_load_n(&ring.done, __ATOMIC_ACQUIRE) &&
+         __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) < prefillBytes) {
+    sleep_ns(RT_POLL_NS);
+  }
+
+  uint64_t t0 = now_ns();
+  stats->latencyNs = t0 - start;
+
+  for (uint64_t scheduled = 0; ; scheduled += blockSamples) {
+    uint64_t deadline = t0 + sample_offset_ns(scheduled, options->rate);
+    sleep_until(deadline);
+    uint64_t now = now_ns();
+
+    // done vor head lesen: ist der Erzeuger fertig, ist head danach endgültig
+    int done = __atomic_load_n(&ring.done, __ATOMIC_ACQUIRE);
+    size_t avail = (size_t) (__atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) - ring.tail);
+    if (done && avail == 0) {
+      break;
+    }
+
+    uint64_t late = (now > deadline) ? now - deadline : 0;
+    if (late > stats->maxJitterNs) stats->maxJitterNs = late;
+    stats->sumJitterNs += late;
+    // Füllstand nur, solange der Erzeuger läuft (am Ende leert sich der Ring ohnehin)
+    size_t fill = avail / sizeof(int16_t);
+    if (!done) {
+      if (fill < stats->minFill) stats->minFill = fill;
+      if (fill > stats->maxFill) stats->maxFill = fill;
+      stats->sumFill += fill;
+      stats->fillBlocks++;
+    }
+    stats->blocks++;
+
+    if (avail >= blockBytes) {
+      ring_release(&ring, out, blockBytes);
+      stats->samples += blockSamples;
+    } else {
+      // Letzter, kürzerer Block oder Unterlauf (dann mit Stille auffüllen)
+      ring_release(&ring, out, avail);
+      stats->samples += fill;
+      if (!done) {
+        rs_sink_write_silence(out, blockSamples - fill);
+        stats->samples += blockSamples - fill;
+        stats->underruns++;
+        stats->silence += blockSamples - fill;
+      }
+    }
+
+    if (rs_sink_flush(out) != 0) {
+      __atomic_store_n(&ring.abort, 1, __ATOMIC_RELEASE);
+      break;
+    }
+  }
+
+  if (stats->fifo) {
+    pthread_setschedparam(pthread_self(), oldPolicy, &oldParam);
+  }
+  pthread_join(thread, NULL);
+  if (stats->locked) {
+    munlockall();
+  }
+  if (stats->fillBlocks == 0) {
+    stats->minFill = 0;
+  }
+  free(ring.data);
+
+  return (out->error != 0) ? 1 : args.result;
+}
+
+/**
+ * @brief Gibt die Statistik als "Info:"-Zeilen auf stderr aus.
+ */
+void rs_realtime_report(const rs_realtime_stats* stats, uint32_t rate) {
+  uint64_t blocks = (stats->blocks > 0) ? stats->blocks : 1;
+  uint64_t fillBlocks = (stats->fillBlocks > 0) ? stats->fillBlocks : 1;
+  double capacity = (double) stats->capacity;
+
+  fprintf(stderr, "Info: Echtzeit: %llu Blöcke, %.2f s, Latenz bis zum ersten Block %.3f ms, SCHED_FIFO %s, mlockall %s.\n",
+          (unsigned long long) stats->blocks, (double) stats->samples / rate, stats->latencyNs / 1e6,
+          stats->fifo ? "ja" : "nein", stats->locked ? "ja" : "nein");
+  fprintf(stderr, "Info: Echtzeit: %llu Unterläufe (%llu Samples Stille), Jitter max %.3f ms, Mittel %.3f ms.\n",
+          (unsigned long long) stats->underruns, (unsigned long long) stats->silence,
+          stats->maxJitterNs / 1e6, (double) stats->sumJitterNs / blocks / 1e6);
+  fprintf(stderr, "Info: Echtzeit: Ring-Füllstand min %.0f%% / Mittel %.0f%% / max %.0f%% von %.0f ms.\n",
+          100.0 * stats->minFill / capacity, 100.0 * ((double) stats->sumFill / fillBlocks) / capacity,
+          100.0 * stats->maxFill / capacity, 1000.0 * capacity / rate);
+}
@@ -0,0 +1,375 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/signal_generator.h"
+#include "../include/resampler.h"
+#include "../include/kernels.h"
+
+/**
+ * @brief Größter gemeinsamer Teiler (zum Kürzen von L/M).
+ */
+static uint32_t gcd_u32(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Modifizierte Bessel-Funktion erster Art, Ordnung 0 (für das Kaiser-Fenster).
+ */
+static double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = x / 2.0;
+
+    for (int k = 1; k < 50; k++) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+/**
+ * @brief Berechnet das Prototyp-Tiefpassfilter als Polyphasen-Bank in double.
+ * * Phase p enthält die Koeffizienten h[p + k*L] in umgekehrter Reihenfolge, damit
+ * die Faltung als Skalarprodukt über aufeinanderfolgende Eingangs-Samples läuft.
+ */
+static void design_filter_bank(const rs_resampler* rs, double* bank) {
+    const uint32_t L = rs->upFactor;
+    const uint32_t M = rs->downFactor;
+    const uint32_t K = rs->tapsPerPhase;
+    const size_t N = (size_t)K * L;
+
+    // Grenzfrequenz normiert auf die überabgetastete Rate L * inRate
+    double cutoff = 0.5 * RS_RESAMPLER_PASSBAND / (double)((L > M) ? L : M);
+    double center = (double)(N - 1) / 2.0;
+    double i0Beta = bessel_i0(RS_RESAMPLER_KAISER_BETA);
+
+    for (size_t i = 0; i < N; i++) {
+        double x = (double)i - center;
+        double sinc = (x == 0.0) ? 1.0 : sin(2.0 * M_PI * cutoff * x) / (2.0 * M_PI * cutoff * x);
+        double r = x / (center + 0.5);
+        double window = bessel_i0(RS_RESAMPLER_KAISER_BETA * sqrt(1.0 - r * r)) / i0Beta;
+
+        // Verstärkung L gleicht die durch das Einfügen von Nullen verlorene Energie aus
+        double h = 2.0 * cutoff * sinc * window * (double)L;
+
+        uint32_t phase = (uint32_t)(i % L);
+        uint32_t k = (uint32_t)(i / L);
+        bank[(size_t)phase * K + (K - 1 - k)] = h;
+    }
+}
+
+/**
+ * @brief Rundet die Bank auf Festkomma (Q15, notfalls gröber) und legt die Zeilen in Ausgabereihenfolge ab.
+ * * Nach dem Zurücksetzen beginnt die Ausgabe bei Phase p0 = delay % L, jedes
+ * Ausgangs-Sample rückt die Phase um M weiter. Zeile r gehört daher zu Phase
+ * (p0 + r * M) % L; die ersten RS_RESAMPLER_BLOCK - 1 Zeilen werden am Ende
+ * wiederholt, damit jeder Kernel-Aufruf zusammenhängende Zeilen bekommt.
+ */
+static void quantize_filter_bank(rs_resampler* rs, const double* bank, uint32_t firstPhase) {
+    const uint32_t L = rs->upFactor;
+    const uint32_t K = rs->tapsPerPhase;
+    const uint32_t taps = rs->tapsQ15;
+
+    // fir_q15 verlangt Σ|c| < 65536 je Zeile (nach der Rundung, daher + K/2).
+    // Die Sinc-Nebenkeulen bringen die Betragssumme auf etwa 2, je nach
+    // Verhältnis knapp darüber; dann wird ein Bit Genauigkeit abgegeben
+    double maxSum = 0.0;
+    for (uint32_t p = 0; p < L; p++) {
+        double sum = 0.0;
+        for (uint32_t k = 0; k < K; k++) {
+            sum += fabs(bank[(size_t)p * K + k]);
+        }
+        if (sum > maxSum) maxSum = sum;
+    }
+    rs->fracBits = 15;
+    while (rs->fracBits > 1 && maxSum * (double)(1 << rs->fracBits) + K / 2.0 >= 65536.0) {
+        rs->fracBits--;
+    }
+    double scale = (double)(1 << rs->fracBits);
+
+    for (uint32_t r = 0; r < L + RS_RESAMPLER_BLOCK - 1; r++) {
+        uint32_t phase = (uint32_t)((firstPhase + (uint64_t)r * rs->downFactor) % L);
+        int16_t* row = rs->bankQ15 + (size_t)r * taps;
+        for (uint32_t k = 0; k < K; k++) {
+            double c = floor(bank[(size_t)phase * K + k] * scale + 0.5);
+            if (c > 32767.0) c = 32767.0;
+            if (c < -32767.0) c = -32767.0;
+            row[k] = (int16_t)c;
+        }
+        memset(row + K, 0, (taps - K) * sizeof(int16_t));
+    }
+}
+
+/**
+ * @brief Legt einen Resampler an und berechnet die Filterbank.
+ */
+rs_resampler* rs_resampler_create(uint32_t inRate, uint32_t outRate) {
+    return rs_resampler_create_arith(inRate, outRate, RS_RESAMPLER_DEFAULT_ARITH);
+}
+
+/**
+ * @brief Wie rs_resampler_create(), aber mit festem Rechenweg.
+ */
+rs_resampler* rs_resampler_create_arith(uint32_t inRate, uint32_t outRate, rs_resampler_arith arith) {
+    if (inRate == 0 || outRate == 0) {
+        return NULL;
+    }
+
+    rs_resampler* rs = (rs_resampler*) calloc(1, sizeof(rs_resampler));
+    if (rs == NULL) {
+        return NULL;
+    }
+
+    uint32_t g = gcd_u32(inRate, outRate);
+    rs->inRate = inRate;
+    rs->outRate = outRate;
+    rs->upFactor = outRate / g;
+    rs->downFactor = inRate / g;
+    rs->arith = arith;
+
+    // Filterlänge: RS_RESAMPLER_ZERO_CROSSINGS Nulldurchgänge je Seite bei der
+    // niedrigeren der beiden Raten, verteilt auf L Phasen
+    double ratio = (double)rs->downFactor / (double)rs->upFactor;
+    if (ratio < 1.0) ratio = 1.0;
+    rs->tapsPerPhase = (uint32_t)ceil(2.0 * RS_RESAMPLER_ZERO_CROSSINGS * ratio / RS_RESAMPLER_PASSBAND);
+    rs->tapsQ15 = (rs->tapsPerPhase + 7) & ~7u;
+
+    const uint32_t K = rs->tapsPerPhase;
+    const size_t capacity = (size_t)K - 1 + RS_RESAMPLER_CHUNK;
+    double* design = (double*) malloc(sizeof(double) * (size_t)K * rs->upFactor);
+    if (arith == RS_RESAMPLER_Q15) {
+        rs->bankQ15 = (int16_t*) malloc(sizeof(int16_t) * rs->tapsQ15 *
+                                        ((size_t)rs->upFactor + RS_RESAMPLER_BLOCK - 1));
+        rs->historyQ15 = (int16_t*) calloc(capacity + rs->tapsQ15 - K, sizeof(int16_t));
+    } else {
+        rs->bank = (float*) malloc(sizeof(float) * (size_t)K * rs->upFactor);
+        rs->history = (float*) calloc(capacity, sizeof(float));
+    }
+
+    if (design == NULL || (arith == RS_RESAMPLER_Q15 ? (rs->bankQ15 == NULL || rs->historyQ15 == NULL)
+                                                     : (rs->bank == NULL || rs->history == NULL))) {
+        free(design);
+        rs_resampler_free(rs);
+        return NULL;
+    }
+
+    design_filter_bank(rs, design);
+    rs_resampler_reset(rs);
+    if (arith == RS_RESAMPLER_Q15) {
+        quantize_filter_bank(rs, design, rs->phase);
+    } else {
+        for (size_t i = 0; i < (size_t)K * rs->upFactor; i++) {
+            rs->bank[i] = (float)design[i];
+        }
+    }
+    free(design);
+
+    return rs;
+}
+
+/**
+ * @brief Setzt den Stream-Zustand zurück, die Filterbank bleibt erhalten.
+ */
+void rs_resampler_reset(rs_resampler* rs) {
+    const uint32_t K = rs->tapsPerPhase;
+
+    // Die ersten K-1 Verlaufswerte sind Nullen (Signal vor dem ersten Sample).
+    // Start bei der Gruppenlaufzeit des Filters, damit Ausgang und Eingang
+    // zeitlich deckungsgleich sind.
+    if (rs->arith == RS_RESAMPLER_Q15) {
+        memset(rs->historyQ15, 0, sizeof(int16_t) * ((size_t)K - 1));
+    } else {
+        memset(rs->history, 0, sizeof(float) * ((size_t)K - 1));
+    }
+    size_t delay = ((size_t)K * rs->upFactor - 1) / 2;
+    rs->historyFill = K - 1;
+    rs->inputPos = delay / rs->upFactor;
+    rs->phase = (uint32_t)(delay % rs->upFactor);
+    rs->slot = 0;
+    rs->totalIn = 0;
+    rs->totalOut = 0;
+}
+
+/**
+ * @brief Gibt den Resampler und seine Filterbank frei.
+ */
+void rs_resampler_free(rs_resampler* rs) {
+    if (rs == NULL) {
+        return;
+    }
+    free(rs->bank);
+    free(rs->history);
+    free(rs->bankQ15);
+    free(rs->historyQ15);
+    free(rs);
+}
+
+/**
+ * @brief Obere Schranke für die Anzahl Ausgangs-Samples bei inCount Eingangs-Samples.
+ */
+size_t rs_resampler_max_output(const rs_resampler* rs, size_t inCount) {
+    return (size_t)(((uint64_t)inCount * rs->upFactor) / rs->downFactor) + 2;
+}
+
+/**
+ * @brief Verwirft verbrauchte Eingangswerte, nur die letzten K-1 Samples bleiben stehen.
+ */
+static void discard_consumed(rs_resampler* rs) {
+    if (rs->inputPos > 0) {
+        size_t keep = (rs->inputPos < rs->historyFill) ? rs->historyFill - rs->inputPos : 0;
+        size_t shift = rs->historyFill - keep;
+        if (rs->arith == RS_RESAMPLER_Q15) {
+            memmove(rs->historyQ15, rs->historyQ15 + shift, sizeof(int16_t) * keep);
+        } else {
+            memmove(rs->history, rs->history + shift, sizeof(float) * keep);
+        }
+        rs->historyFill = keep;
+        rs->inputPos -= shift;
+    }
+}
+
+/**
+ * @brief Erzeugt alle Ausgangs-Samples, für die der Verlauf genug Eingangswerte enthält.
+ * @param limit Höchstzahl zu erzeugender Samples.
+ */
+static size_t produce(rs_resampler* rs, int16_t* out, size_t limit) {
+    const uint32_t L = rs->upFactor;
+    const uint32_t M = rs->downFactor;
+    const uint32_t K = rs->tapsPerPhase;
+    const rs_kernel_table* kernels = rs_kernels();
+    float acc[RS_RESAMPLER_BLOCK];
+    size_t pending = 0;
+    size_t written = 0;
+
+    while (written + pending < limit && rs->inputPos + K <= rs->historyFill) {
+        const float* coeffs = rs->bank + (size_t)rs->phase * K;
+        const float* x = rs->history + rs->inputPos;
+        float sum = 0.0f;
+
+        for (uint32_t k = 0; k < K; k++) {
+            sum += coeffs[k] * x[k];
+        }
+        acc[pending++] = sum;
+
+        if (pending == RS_RESAMPLER_BLOCK) {
+            kernels->float_to_s16(out + written, acc, pending);
+            written += pending;
+            pending = 0;
+        }
+
+        rs->phase += M;
+        rs->inputPos += rs->phase / L;
+        rs->phase %= L;
+    }
+
+    // Gerundet und gesättigt nach int16
+    kernels->float_to_s16(out + written, acc, pending);
+    written += pending;
+
+    discard_consumed(rs);
+    rs->totalOut += written;
+    return written;
+}
+
+/**
+ * @brief Wie produce(), aber in Q15 über den fir_q15-Kernel.
+ * * Je Block werden zuerst die Startpositionen bestimmt; die Koeffizienten-
+ * zeilen liegen ab rs->slot bereits in Ausgabereihenfolge.
+ */
+static size_t produce_q15(rs_resampler* rs, int16_t* out, size_t limit) {
+    const uint32_t L = rs->upFactor;
+    const uint32_t M = rs->downFactor;
+    const uint32_t K = rs->tapsPerPhase;
+    const rs_kernel_table* kernels = rs_kernels();
+    uint32_t start[RS_RESAMPLER_BLOCK];
+    size_t written = 0;
+
+    while (written < limit && rs->inputPos + K <= rs->historyFill) {
+        size_t max = (limit - written < RS_RESAMPLER_BLOCK) ? limit - written : RS_RESAMPLER_BLOCK;
+        size_t pos = rs->inputPos;
+        uint32_t phase = rs->phase;
+        size_t n = 0;
+
+        while (n < max && pos + K <= rs->historyFill) {
+            start[n++] = (uint32_t)pos;
+            phase += M;
+            pos += phase / L;
+            phase %= L;
+        }
+
+        kernels->fir_q15(out + written, rs->historyQ15, start, rs->bankQ15 + (size_t)rs->slot * rs->tapsQ15,
+                         rs->tapsQ15, rs->fracBits, n);
+        written += n;
+        rs->inputPos = pos;
+        rs->phase = phase;
+        rs->slot = (uint32_t)((rs->slot + n) % L);
+    }
+
+    discard_consumed(rs);
+    rs->totalOut += written;
+    return written;
+}
+
+/**
+ * @brief Verarbeitet einen Block Eingangs-Samples (Streaming).
+ */
+size_t rs_resampler_process(rs_resampler* rs, const int16_t* in, size_t inCount, int16_t* out) {
+    const size_t capacity = (size_t)rs->tapsPerPhase - 1 + RS_RESAMPLER_CHUNK;
+    size_t written = 0;
+
+    while (inCount > 0) {
+        size_t room = capacity - rs->historyFill;
+        size_t n = (inCount < room) ? inCount : room;
+
+        if (rs->arith == RS_RESAMPLER_Q15) {
+            memcpy(rs->historyQ15 + rs->historyFill, in, n * sizeof(int16_t));
+        } else {
+            float* dst = rs->history + rs->historyFill;
+            for (size_t i = 0; i < n; i++) {
+                dst[i] = (float)in[i];
+            }
+        }
+        rs->historyFill += n;
+        rs->totalIn += n;
+        in += n;
+        inCount -= n;
+
+        written += (rs->arith == RS_RESAMPLER_Q15) ? produce_q15(rs, out + written, SIZE_MAX)
+                                                   : produce(rs, out + written, SIZE_MAX);
+    }
+
+    return written;
+}
+
+/**
+ * @brief Schiebt den Filter-Nachlauf aus (Ende des Streams).
+ */
+size_t rs_resampler_flush(rs_resampler* rs, int16_t* out) {
+    const size_t capacity = (size_t)rs->tapsPerPhase - 1 + RS_RESAMPLER_CHUNK;
+    uint64_t target = (rs->totalIn * rs->upFactor + rs->downFactor / 2) / rs->downFactor;
+    size_t written = 0;
+
+    while (rs->totalOut < target) {
+        // Mit Nullen auffüllen, bis der Nachlauf vollständig ausgegeben ist
+        size_t room = capacity - rs->historyFill;
+        if (rs->arith == RS_RESAMPLER_Q15) {
+            memset(rs->historyQ15 + rs->historyFill, 0, sizeof(int16_t) * room);
+        } else {
+            memset(rs->history + rs->historyFill, 0, sizeof(float) * room);
+        }
+        rs->historyFill += room;
+
+        size_t limit = (size_t)(target - rs->totalOut);
+        written += (rs->arith == RS_RESAMPLER_Q15) ? produce_q15(rs, out + written, limit)
+                                                   : produce(rs, out + written, limit);
+    }
+
+    return written;
+}
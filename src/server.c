@@ -0,0 +1,613 @@
+#define _GNU_SOURCE // accept4(), SOCK_NONBLOCK, MSG_NOSIGNAL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "../include/server.h"
+#include "../include/sink.h"
+#include "../include/kernels.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+
+#define SERVE_MAX_EVENTS 64
+#define SERVE_READ_CHUNK 4096
+
+typedef struct serve_client {
+  struct serve_client* next;  // Liste aller offenen Verbindungen
+  struct serve_client* prev;
+  int fd;
+  char* in;              // Empfangene, noch nicht verarbeitete Bytes
+  size_t inFill;
+  size_t inCapacity;
+  char header[64];       // "OK <BYTES>\n" bzw. "ERR ...\n"
+  size_t headerLen;
+  size_t headerSent;
+  rs_sink memory;        // PCM der laufenden Antwort (bleibt zwischen Anfragen reserviert)
+  size_t memorySent;
+  int sending;           // 1 = Antwort unterwegs, keine weiteren Anfragen verarbeiten
+  int closing;           // 1 = nach dem Senden schließen (Gegenseite fertig oder Protokollfehler)
+  uint32_t watched;      // Aktuell bei epoll angemeldete Ereignisse
+} serve_client;
+
+typedef struct {
+  int epollFd;
+  const rs_job* defaults;
+  rs_job_buffers buffers;       // Von allen Anfragen gemeinsam genutzt (ein Thread)
+  unsigned long requests;
+  size_t clients;
+  serve_client* head;           // Offene Verbindungen (zum Aufräumen beim Beenden)
+} serve_state;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void on_stop_signal(int sig) {
+  (void)sig;
+  stopRequested = 1;
+}
+
+/**
+ * @brief Legt den lauschenden, nicht-blockierenden Socket unter path an.
+ * @return Dateideskriptor oder -1 bei Fehler.
+ */
+static int open_listener(const char* path) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "Fehler: Socket-Pfad ist zu lang: %s\n", path);
+    return -1;
+  }
+  strcpy(addr.sun_path, path);
+
+  // Veraltete Socket-Datei eines früheren Laufs ersetzen, andere Dateien nie
+  struct stat st;
+  if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+    unlink(path);
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    fprintf(stderr, "Fehler: Socket konnte nicht angelegt werden: %s\n", strerror(errno));
+    return -1;
+  }
+  if (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+    fprintf(stderr, "Fehler: Socket '%s' nicht verfügbar: %s\n", path, strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static void client_close(serve_state* state, serve_client* client) {
+  if (client->prev != NULL) {
+    client->prev->next = client->next;
+  } else {
+    state->head = client->next;
+  }
+  if (client->next != NULL) {
+    client->next->prev = client->prev;
+  }
+  epoll_ctl(state->epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+  close(client->fd);
+  rs_sink_close(&client->memory);
+  free(client->in);
+  free(client);
+  state->clients--;
+}
+
+/**
+ * @brief Wartet je nach Zustand auf Lesbarkeit (neue Anfrage) oder Schreibbarkeit (Antwort).
+ */
+static void client_watch(serve_state* state, serve_client* client) {
+  uint32_t events = client->sending ? EPOLLOUT : EPOLLIN;
+  if (events == client->watched) {
+    return;
+  }
+  struct epoll_event ev;
+  ev.events = events;
+  ev.data.ptr = client;
+  epoll_ctl(state->epollFd, EPOLL_CTL_MOD, client->fd, &ev);
+  client->watched = events;
+}
+
+/**
+ * @brief Sendet so viel der ausstehenden Antwort wie möglich.
+ * @return 0 = alles gesendet, 1 = Socket voll (auf EPOLLOUT warten), -1 = Verbindungsfehler.
+ */
+static int client_send(serve_client* client) {
+  while (client->headerSent < client->headerLen ||
+         client->memorySent < client->memory.memoryFill) {
+    const char* data;
+    size_t len;
+    if (client->headerSent < client->headerLen) {
+      data = client->header + client->headerSent;
+      len = client->headerLen - client->headerSent;
+    } else {
+      data = (const char*) client->memory.memory + client->memorySent;
+      len = client->memory.memoryFill - client->memorySent;
+    }
+
+    ssize_t n = send(client->fd, data, len, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return (errno == EAGAIN || errno == EWOULDBLOCK) ? 1 : -1;
+    }
+    if (client->headerSent < client->headerLen) {
+      client->headerSent += (size_t) n;
+    } else {
+      client->memorySent += (size_t) n;
+    }
+  }
+  client->sending = 0;
+  return 0;
+}
+
+/**
+ * @brief Rendert eine Anfragezeile in den Speicher-Sink des Clients und bereitet die Antwort vor.
+ */
+static void handle_request(serve_state* state, serve_client* client, char* line) {
+  char* args[RS_JOB_MAX_ARGS];
+  rs_job job;
+  uint64_t samples;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  rs_sink_reset_memory(&client->memory);
+  int result = rs_job_run_line(line, state->requests + 1, state->defaults, &job, args,
+                               &client->memory, 0, &state->buffers, &samples);
+  if (result == RS_JOB_SKIPPED) {
+    return; // Leerzeile oder Kommentar: keine Antwort
+  }
+  state->requests++;
+
+  if (result == RS_JOB_OK) {
+    if (job.outputPath != NULL) {
+      client->memory.memoryFill = 0; // Ausgabe liegt in der Datei
+    }
+    client->headerLen = (size_t) snprintf(client->header, sizeof(client->header), "OK %llu\n",
+                                          (unsigned long long) client->memory.memoryFill);
+  } else {
+    client->memory.memoryFill = 0;
+    client->headerLen = (size_t) snprintf(client->header, sizeof(client->header), "ERR %s\n",
+                                          rs_job_result_text(result));
+  }
+  client->headerSent = 0;
+  client->memorySent = 0;
+  client->sending = 1;
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  rs_job_report(state->requests, &job, result, samples,
+                (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6);
+}
+
+/**
+ * @brief Verarbeitet gepufferte Anfragen, bis eine Antwort auf den Socket warten muss.
+ * @return 0 = Verbindung bleibt offen, -1 = Verbindung schließen.
+ */
+static int client_process(serve_state* state, serve_client* client) {
+  for (;;) {
+    if (client->sending) {
+      int sent = client_send(client);
+      if (sent < 0) {
+        return -1;
+      }
+      if (sent > 0) {
+        client_watch(state, client);
+        return 0;
+      }
+    }
+
+    char* newline = (client->inFill > 0) ? memchr(client->in, '\n', client->inFill) : NULL;
+    if (newline == NULL) {
+      if (client->inFill > RS_SERVE_MAX_REQUEST) {
+        // Zeile zu lang: Fehler melden und die Verbindung danach schließen
+        client->headerLen = (size_t) snprintf(client->header, sizeof(client->header), "ERR ungültig\n");
+        client->headerSent = 0;
+        client->memory.memoryFill = 0;
+        client->memorySent = 0;
+        client->sending = 1;
+        client->closing = 1;
+        client->inFill = 0;
+        continue;
+      }
+      if (client->closing) {
+        return -1; // Alles beantwortet, Gegenseite sendet nichts mehr
+      }
+      client_watch(state, client);
+      return 0;
+    }
+
+    *newline = '\0';
+    size_t consumed = (size_t)(newline - client->in) + 1;
+    handle_request(state, client, client->in);
+
+    // Die Jobargumente zeigen in den Eingabepuffer, daher erst jetzt nachrücken
+    memmove(client->in, client->in + consumed, client->inFill - consumed);
+    client->inFill -= consumed;
+  }
+}
+
+/**
+ * @brief Liest verfügbare Bytes einer Verbindung.
+ * @return 0 = ok, -1 = Verbindung beendet oder Fehler.
+ */
+static int client_read(serve_client* client) {
+  for (;;) {
+    if (client->inCapacity - client->inFill < SERVE_READ_CHUNK) {
+      if (client->inFill > RS_SERVE_MAX_REQUEST) {
+        return 0; // Überlange Zeile, client_process meldet den Fehler
+      }
+      size_t capacity = client->inCapacity ? client->inCapacity * 2 : 2 * SERVE_READ_CHUNK;
+      char* grown = (char*) realloc(client->in, capacity);
+      if (grown == NULL) {
+        return -1;
+      }
+      client->in = grown;
+      client->inCapacity = capacity;
+    }
+
+    ssize_t n = recv(client->fd, client->in + client->inFill, client->inCapacity - client->inFill, 0);
+    if (n > 0) {
+      client->inFill += (size_t) n;
+      continue;
+    }
+    if (n == 0) {
+      return -1;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+  }
+}
+
+static void accept_clients(serve_state* state, int listenFd) {
+  for (;;) {
+    int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return; // EAGAIN: keine weiteren Verbindungen
+    }
+    if (state->clients >= RS_SERVE_MAX_CLIENTS) {
+      close(fd);
+      continue;
+    }
+
+    serve_client* client = (serve_client*) calloc(1, sizeof(serve_client));
+    if (client == NULL || rs_sink_init_memory(&client->memory, RS_BYTE_ORDER_LE) != 0) {
+      free(client);
+      close(fd);
+      continue;
+    }
+    client->fd = fd;
+    client->watched = EPOLLIN;
+    client->next = state->head;
+    if (state->head != NULL) {
+      state->head->prev = client;
+    }
+    state->head = client;
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = client;
+    state->clients++;
+    if (epoll_ctl(state->epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+      client_close(state, client);
+    }
+  }
+}
+
+/**
+ * @brief Startet den Dienst auf dem Socket path (bis SIGINT/SIGTERM).
+ */
+int rs_serve(const char* path, const rs_job* defaults) {
+  int listenFd = open_listener(path);
+  if (listenFd < 0) {
+    return 1;
+  }
+
+  serve_state state;
+  memset(&state, 0, sizeof(state));
+  state.defaults = defaults;
+  state.epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL; // NULL = lauschender Socket
+  if (state.epollFd < 0 || epoll_ctl(state.epollFd, EPOLL_CTL_ADD, listenFd, &ev) != 0) {
+    fprintf(stderr, "Fehler: epoll konnte nicht eingerichtet werden: %s\n", strerror(errno));
+    close(listenFd);
+    unlink(path);
+    return 1;
+  }
+
+  // Ohne SA_RESTART, damit epoll_wait bei SIGINT/SIGTERM zurückkehrt
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_stop_signal;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+
+  rs_kernels();
+  fprintf(stderr, "Info: Dienst lauscht auf %s\n", path);
+
+  struct epoll_event events[SERVE_MAX_EVENTS];
+  while (!stopRequested) {
+    int count = epoll_wait(state.epollFd, events, SERVE_MAX_EVENTS, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "Fehler: epoll_wait: %s\n", strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < count; i++) {
+      serve_client* client = (serve_client*) events[i].data.ptr;
+      if (client == NULL) {
+        accept_clients(&state, listenFd);
+        continue;
+      }
+
+      // Während eine Antwort unterwegs ist, wird nur auf EPOLLOUT gewartet. Nach
+      // dem Ende der Eingabe werden gepufferte Anfragen noch beantwortet.
+      if (!client->sending && client_read(client) != 0) {
+        client->closing = 1;
+      }
+      if (client_process(&state, client) != 0) {
+        client_close(&state, client);
+      }
+    }
+  }
+
+  while (state.head != NULL) {
+    client_close(&state, state.head);
+  }
+  fprintf(stderr, "Info: Dienst beendet nach %lu Anfragen.\n", state.requests);
+  close(state.epollFd);
+  close(listenFd);
+  unlink(path);
+  rs_job_buffers_free(&state.buffers);
+  return 0;
+}
+
+#else
+
+int rs_serve(const char* path, const rs_job* defaults) {
+  (void)path;
+  (void)defaults;
+  fprintf(stderr, "Fehler: --serve wird nur unter Linux (epoll) unterstützt.\n");
+  return 1;
+}
+
+#endif // __linux__
+
+// --- CLIENT ---
+
+typedef struct {
+  int fd;
+  uint8_t buffer[64 * 1024];
+  size_t pos;
+  size_t len;
+} client_reader;
+
+/**
+ * @brief Füllt den Lesepuffer neu (nur wenn er leer ist).
+ * @return 0 bei Erfolg, -1 bei Verbindungsende/Fehler.
+ */
+static int reader_fill(client_reader* r) {
+  while (r->pos == r->len) {
+    ssize_t n = read(r->fd, r->buffer, sizeof(r->buffer));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return -1;
+    }
+    r->pos = 0;
+    r->len = (size_t) n;
+  }
+  return 0;
+}
+
+/**
+ * @brief Liefert das nächste Byte der Verbindung.
+ * @return Byte (0-255) oder -1 bei Verbindungsende/Fehler.
+ */
+static int reader_byte(client_reader* r) {
+  if (reader_fill(r) != 0) {
+    return -1;
+  }
+  return r->buffer[r->pos++];
+}
+
+/**
+ * @brief Sendet eine Anfragezeile und gibt das PCM der Antwort in out aus.
+ * @return 0 bei "OK", 1 bei "ERR", -1 bei Verbindungsfehler.
+ */
+static int client_request(int fd, client_reader* reader, const char* line, size_t len, rs_sink* out) {
+  while (len > 0) {
+    ssize_t n = send(fd, line, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      return -1;
+    }
+    line += n;
+    len -= (size_t) n;
+  }
+
+  char header[128];
+  size_t headerLen = 0;
+  for (;;) {
+    int c = reader_byte(reader);
+    if (c < 0) {
+      return -1;
+    }
+    if (c == '\n') {
+      break;
+    }
+    if (headerLen < sizeof(header) - 1) {
+      header[headerLen++] = (char) c;
+    }
+  }
+  header[headerLen] = '\0';
+
+  if (strncmp(header, "OK ", 3) != 0) {
+    fprintf(stderr, "Fehler: Dienst meldet: %s\n", header);
+    return 1;
+  }
+
+  unsigned long long remaining = strtoull(header + 3, NULL, 10);
+  while (remaining > 0) {
+    if (reader_fill(reader) != 0) {
+      return -1;
+    }
+    size_t n = reader->len - reader->pos;
+    if (n > remaining) {
+      n = (size_t) remaining;
+    }
+    rs_sink_write_bytes(out, reader->buffer + reader->pos, n);
+    reader->pos += n;
+    remaining -= n;
+  }
+  return 0;
+}
+
+/**
+ * @brief Hängt ein Argument in einfachen Anführungszeichen an line an (' wird zu '\'').
+ * @return 0 bei Erfolg, 1 wenn line voll ist oder das Argument einen Zeilenumbruch enthält.
+ */
+static int append_quoted(char* line, size_t* len, size_t capacity, const char* arg) {
+  if (*len + 1 >= capacity) {
+    return 1;
+  }
+  line[(*len)++] = '\'';
+
+  for (const char* p = arg; *p != '\0'; p++) {
+    if (*p == '\n') {
+      return 1; // Zeilenumbrüche sind im Protokoll nicht darstellbar
+    }
+    const char* piece = (*p == '\'') ? "'\\''" : NULL;
+    size_t n = (piece != NULL) ? strlen(piece) : 1;
+    if (*len + n >= capacity) {
+      return 1;
+    }
+    if (piece != NULL) {
+      memcpy(line + *len, piece, n);
+    } else {
+      line[*len] = *p;
+    }
+    *len += n;
+  }
+
+  if (*len + 2 >= capacity) {
+    return 1;
+  }
+  line[(*len)++] = '\'';
+  line[(*len)++] = ' ';
+  return 0;
+}
+
+/**
+ * @brief Kleiner Client: sendet Jobs an einen laufenden Dienst und schreibt das PCM nach stdout.
+ */
+int rs_client_run(const char* path, int argc, char** argv) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "Fehler: Socket-Pfad ist zu lang: %s\n", path);
+    return 1;
+  }
+  strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || connect(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+    fprintf(stderr, "Fehler: Verbindung zu '%s' fehlgeschlagen: %s\n", path, strerror(errno));
+    if (fd >= 0) {
+      close(fd);
+    }
+    return 1;
+  }
+
+  rs_sink out;
+  client_reader* reader = (client_reader*) calloc(1, sizeof(client_reader));
+  if (reader == NULL || rs_sink_init_fd(&out, STDOUT_FILENO, RS_BYTE_ORDER_LE) != 0) {
+    free(reader);
+    close(fd);
+    return 1;
+  }
+  reader->fd = fd;
+
+  int failed = 0;
+  int result = 0;
+
+  if (argc > 0) {
+    // Argumente als eine Jobzeile, jedes in einfachen Anführungszeichen
+    char line[RS_SERVE_MAX_REQUEST];
+    size_t len = 0;
+    for (int i = 0; i < argc && result == 0; i++) {
+      result = append_quoted(line, &len, sizeof(line) - 1, argv[i]);
+    }
+    if (result != 0) {
+      fprintf(stderr, "Fehler: Anfrage zu lang oder enthält Zeilenumbrüche.\n");
+      failed = 1;
+    } else {
+      line[len++] = '\n';
+      result = client_request(fd, reader, line, len, &out);
+    }
+  } else {
+    char* line = NULL;
+    size_t capacity = 0;
+    ssize_t len;
+    while (result >= 0 && out.error == 0 && (len = getline(&line, &capacity, stdin)) >= 0) {
+      if (len == 0 || line[len - 1] != '\n') {
+        // Letzte Zeile ohne Zeilenumbruch
+        char* grown = (char*) realloc(line, (size_t) len + 2);
+        if (grown == NULL) {
+          break;
+        }
+        line = grown;
+        line[len++] = '\n';
+      }
+      // Leerzeilen und Kommentare beantwortet der Dienst nicht
+      const char* p = line;
+      while (*p == ' ' || *p == '\t' || *p == '\r') {
+        p++;
+      }
+      if (*p == '\n' || *p == '#') {
+        continue;
+      }
+      result = client_request(fd, reader, line, (size_t) len, &out);
+      failed |= (result != 0);
+    }
+    free(line);
+  }
+
+  if (result < 0) {
+    fprintf(stderr, "Fehler: Verbindung zum Dienst abgebrochen.\n");
+  }
+  failed |= (result != 0);
+
+  if (rs_sink_close(&out) != 0 && out.error != 0) {
+    fprintf(stderr, "Fehler: Ausgabe fehlgeschlagen: %s\n", strerror(out.error));
+    failed = 1;
+  }
+  free(reader);
+  close(fd);
+  return failed ? 1 : 0;
+}
@@ -1,26 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
+#include <pthread.h>
 
 #include "../include/signal_generator.h"
-
-/**
- * @brief Generiert ein 16-bit PCM Sample bei einer bestimmten Frequenz und Zeit.
- * * @param frequency Die Frequenz des Tons (Hz).
- * @param time_index Das aktuelle Sample-Index (0, 1, 2, ...).
- * @param sample_rate Die Abtastrate.
- * @return int16_t Das generierte PCM-Sample.
- */
-int16_t rs_generate_tone_sample(double frequency, size_t time_index, uint32_t sample_rate) {
-    // 2 * PI * Frequenz * (Aktuelle Zeit)
-    // Zeit = time_index / sample_rate
-    double angle = 2.0 * M_PI * frequency * ((double)time_index / sample_rate);
-    
-    // Generiert ein Sinus-Sample und skaliert es auf den 16-Bit-Bereich
-    return (int16_t)(sin(angle) * MAX_PCM_VALUE);
-}
-
+#include "../include/kernels.h"
+#include "../include/encoders/pocsag.h"
 
 /**
  * @brief Berechnet die Länge der PCM-Übertragung in SAMPLES.
@@ -34,9 +19,75 @@ size_t pcmTransmissionLength(
     return transmissionLength * 32 * sampleRate / baudRate;
 }
 
+/**
+ * @brief Initialisiert den Streaming-Renderer für eine POCSAG-Übertragung.
+ * * Statt eines Zwischenpuffers bei SYMRATE läuft ein ganzzahliger, gebrochener
+ * Bit-Takt direkt auf der Ziel-Abtastrate. Zeiteinheit ist
+ * 1 / (2 * SYMRATE * sampleRate * baudRate) Sekunden, damit alle Schritte ganzzahlig
+ * bleiben. Der Startversatz von einem halben SYMRATE-Sample entspricht exakt dem
+ * Abtastzeitpunkt des früheren Nearest-Neighbour-Mappings (round()), die Ausgabe
+ * ist daher bit-identisch.
+ */
+void pcmStreamInit(
+    pcmStream* stream,
+    uint32_t sampleRate,
+    uint32_t baudRate,
+    const uint32_t* transmission,
+    size_t transmissionLength) {
+
+    stream->transmission = transmission;
+    stream->totalBits = transmissionLength * 32;
+    stream->totalSamples = pcmTransmissionLength(sampleRate, baudRate, transmissionLength);
+    stream->sampleIndex = 0;
+    stream->bitIndex = 0;
+
+    stream->clockStep = 2ull * SYMRATE * baudRate;
+    stream->clockPeriod = 2ull * SYMRATE * sampleRate;
+    stream->clock = (uint64_t)sampleRate * baudRate;
+}
+
+/**
+ * @brief Erzeugt die nächsten (höchstens maxSamples) PCM-Samples der Übertragung.
+ * * POCSAG Rechteckwellen-FSK-Simulation: Bit 0 = +MAX, Bit 1 = -MAX, MSB zuerst.
+ * @return size_t Anzahl geschriebener Samples (0 = Übertragung vollständig).
+ */
+size_t pcmStreamRender(pcmStream* stream, int16_t* out, size_t maxSamples) {
+    size_t remaining = stream->totalSamples - stream->sampleIndex;
+    size_t count = (maxSamples < remaining) ? maxSamples : remaining;
+    size_t written = 0;
+
+    while (written < count) {
+        // Samples bis zur nächsten Bitgrenze (mindestens 1)
+        uint64_t run = (stream->clockPeriod - stream->clock + stream->clockStep - 1) / stream->clockStep;
+        if (run > count - written) {
+            run = count - written;
+        }
+
+        int16_t sample = 0;
+        if (stream->bitIndex < stream->totalBits) {
+            uint32_t val = stream->transmission[stream->bitIndex / 32];
+            int bit = (val >> (31 - (stream->bitIndex % 32))) & 1;
+            sample = bit ? -MAX_PCM_VALUE : MAX_PCM_VALUE;
+        }
+
+        rs_kernels()->fill(out + written, sample, (size_t)run);
+        written += (size_t)run;
+
+        stream->clock += run * stream->clockStep;
+        while (stream->clock >= stream->clockPeriod) {
+            stream->clock -= stream->clockPeriod;
+            stream->bitIndex++;
+        }
+    }
+
+    stream->sampleIndex += written;
+    return written;
+}
+
 /**
  * @brief Kodiert die 32-Bit-Wörter in ein rohes PCM-Audiosignal (Signed 16-bit, Little Endian).
- * * POCSAG Rechteckwellen-FSK-Simulation.
+ * * POCSAG Rechteckwellen-FSK-Simulation. Rendert die gesamte Übertragung am Stück;
+ * für Ausgaben ohne vollständigen Puffer siehe pcmStreamRender().
  */
 void pcmEncodeTransmission(
     uint32_t sampleRate,
@@ -45,63 +96,88 @@ void pcmEncodeTransmission(
     size_t transmissionLength,
     int16_t* out) { 
 
-    // Die Anzahl der Wiederholungen jedes Bits, die wir benötigen, um SYMRATE (38400 Hz) zu erreichen
-    int repeatsPerBit = SYMRATE / baudRate;
+    pcmStream stream;
+    pcmStreamInit(&stream, sampleRate, baudRate, transmission, transmissionLength);
 
-    // Berechnung der Größe des Zwischenpuffers bei SYMRATE
-    size_t inputSize = transmissionLength * 32 * repeatsPerBit;
-
-    // Zwischenpuffer für Samples bei SYMRATE (16-Bit Signed)
-    int16_t* samples =
-        (int16_t*) malloc(sizeof(int16_t) * inputSize);
+    while (pcmStreamRender(&stream, out, PCM_BLOCK_SAMPLES) > 0) {
+        out += PCM_BLOCK_SAMPLES;
+    }
+}
 
-    if (samples == NULL) {
-        fprintf(stderr, "Fehler: Speicherzuweisung für Zwischen-PCM-Puffer fehlgeschlagen.\n");
-        return;
+// --- VORAB GERENDERTE PRÄAMBEL ---
+// Je Baudrate die Samples, die ausschließlich aus Präambel-Bits entstehen, und
+// der Stream-Zustand danach. Wird einmal je Prozess angelegt und danach nur
+// gelesen (auch aus mehreren Threads).
+
+#define PREAMBLE_WORDS (PREAMBLE_LENGTH / 32)
+#define PREAMBLE_WORD 0xAAAAAAAAu
+
+typedef struct {
+    uint32_t baudRate;
+    int16_t* pcm;       // NULL = nicht verfügbar (Speichermangel)
+    size_t samples;
+    pcmStream end;      // Zustand nach den Präambel-Samples
+} preamble_block;
+
+static preamble_block preambles[] = { { 512, NULL, 0, { 0 } }, { 1200, NULL, 0, { 0 } }, { 2400, NULL, 0, { 0 } } };
+static pthread_once_t preamblesOnce = PTHREAD_ONCE_INIT;
+
+static void render_preambles(void) {
+    // Ein zusätzliches Wort, damit totalSamples die Präambel nicht abschneidet
+    uint32_t words[PREAMBLE_WORDS + 1];
+    for (size_t i = 0; i < PREAMBLE_WORDS + 1; i++) {
+        words[i] = PREAMBLE_WORD;
     }
 
-    int16_t* psamples = samples;
-    for (size_t i = 0; i < transmissionLength; i++) {
-        uint32_t val = *(transmission + i);
-        
-        // POCSAG sendet Bits MSB zuerst für die Kodierung der Wörter.
-        for (int bitNum = 0; bitNum < 32; bitNum++) {
-
-            // Kodierung vom höchstwertigen zum niedrigstwertigen Bit
-            int bit = (val >> (31 - bitNum)) & 1;
-            int16_t sample;
-            
-            // Rechteckwelle FSK-Simulation:
-            if (bit == 0) {
-                sample = MAX_PCM_VALUE; 
-            } else {
-                sample = -MAX_PCM_VALUE;
-            }
-
-            // Wiederhole so oft, wie für die aktuelle Baudrate nötig
-            for (int r = 0; r < repeatsPerBit; r++) {
-                *psamples = sample;
-                psamples++;
-            }
+    for (size_t b = 0; b < sizeof(preambles) / sizeof(preambles[0]); b++) {
+        preamble_block* block = &preambles[b];
+        pcmStream stream;
+        pcmStreamInit(&stream, SAMPLE_RATE, block->baudRate, words, PREAMBLE_WORDS + 1);
+
+        // Obergrenze: Präambeldauer plus ein Sample
+        size_t capacity = pcmTransmissionLength(SAMPLE_RATE, block->baudRate, PREAMBLE_WORDS) + 1;
+        int16_t* pcm = (int16_t*) malloc(sizeof(int16_t) * capacity);
+        if (pcm == NULL) {
+            continue;
         }
-    }
 
-    // Resampling auf die Ziel-Abtastrate (22050 Hz) mit Nearest Neighbor
-    size_t outputSamples =
-        pcmTransmissionLength(sampleRate, baudRate, transmissionLength);
+        // Nur Samples, deren Bit noch zur Präambel gehört (bitIndex gilt für das nächste Sample)
+        size_t n = 0;
+        while (stream.bitIndex < PREAMBLE_LENGTH && n < capacity) {
+            n += pcmStreamRender(&stream, pcm + n, 1);
+        }
 
-    for (size_t i = 0; i < outputSamples; i++) {
-        
-        // Mapping vom Ziel-Sample-Index auf den Quell-Sample-Index
-        size_t input_index = (size_t)round((double)i * ((double)SYMRATE / sampleRate));
+        block->pcm = pcm;
+        block->samples = n;
+        block->end = stream;
+    }
+}
 
-        if (input_index < inputSize) {
-             // Schreibe das Sample direkt in den int16_t Puffer
-             *(out + i) = *(samples + input_index);
-        } else {
-             *(out + i) = 0;
+/**
+ * @brief Übernimmt die vorab gerenderte POCSAG-Präambel.
+ */
+const int16_t* pcmStreamSkipPreamble(pcmStream* stream, uint32_t sampleRate, uint32_t baudRate, size_t* count) {
+    if (sampleRate != SAMPLE_RATE || stream->sampleIndex != 0 || stream->totalBits <= PREAMBLE_LENGTH) {
+        return NULL;
+    }
+    for (size_t i = 0; i < PREAMBLE_WORDS; i++) {
+        if (stream->transmission[i] != PREAMBLE_WORD) {
+            return NULL;
         }
     }
 
-    free(samples);
-}
\ No newline at end of file
+    pthread_once(&preamblesOnce, render_preambles);
+
+    for (size_t b = 0; b < sizeof(preambles) / sizeof(preambles[0]); b++) {
+        const preamble_block* block = &preambles[b];
+        if (block->baudRate != baudRate || block->pcm == NULL || block->samples > stream->totalSamples) {
+            continue;
+        }
+        stream->sampleIndex = block->end.sampleIndex;
+        stream->bitIndex = block->end.bitIndex;
+        stream->clock = block->end.clock;
+        *count = block->samples;
+        return block->pcm;
+    }
+    return NULL;
+}
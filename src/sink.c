@@ -0,0 +1,539 @@
+#define _GNU_SOURCE // fallocate(), FALLOC_FL_*
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "../include/sink.h"
+
+/**
+ * @brief Schreibt len Bytes vollständig (wiederholt bei kurzen Writes und EINTR).
+ * @return 0 bei Erfolg, sonst errno.
+ */
+static int write_all(int fd, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static const int16_t zeros[1024] = { 0 };
+
+static void put_le16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    put_le16(p, (uint16_t)(v & 0xFFFF));
+    put_le16(p + 2, (uint16_t)(v >> 16));
+}
+
+/**
+ * @brief Baut den 44-Byte-WAV-Header (PCM, mono, 16 Bit) für dataBytes Nutzdaten.
+ */
+static void wav_header(uint8_t* h, uint32_t sampleRate, uint64_t dataBytes) {
+    // RIFF-Längenfelder sind 32 Bit breit; größere Dateien werden gekappt
+    uint32_t data = (dataBytes > 0xFFFFFFFFu - 36) ? 0xFFFFFFFFu - 36 : (uint32_t)dataBytes;
+
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, 36 + data);
+    memcpy(h + 8, "WAVE", 4);
+    memcpy(h + 12, "fmt ", 4);
+    put_le32(h + 16, 16);               // Länge des fmt-Chunks
+    put_le16(h + 20, 1);                // PCM
+    put_le16(h + 22, 1);                // Mono
+    put_le32(h + 24, sampleRate);
+    put_le32(h + 28, sampleRate * 2);   // Bytes pro Sekunde
+    put_le16(h + 32, 2);                // Block-Ausrichtung
+    put_le16(h + 34, 16);               // Bits pro Sample
+    memcpy(h + 36, "data", 4);
+    put_le32(h + 40, data);
+}
+
+/**
+ * @brief Reserviert [offset, offset + len) ohne die Dateilänge zu ändern.
+ * * Schlägt fallocate fehl (z.B. Dateisystem ohne Unterstützung), wird die
+ * Vorabreservierung für diesen Sink abgeschaltet; das ist kein Ausgabefehler.
+ */
+static void preallocate(rs_sink* sink, uint64_t offset, uint64_t len) {
+#ifdef __linux__
+    if (sink->preallocate && fallocate(sink->fd, FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)len) != 0) {
+        sink->preallocate = 0;
+    }
+    if (sink->preallocate && offset + len > sink->reserved) {
+        sink->reserved = offset + len;
+    }
+#else
+    (void)sink; (void)offset; (void)len;
+#endif
+}
+
+/**
+ * @brief Hängt len Bytes an die Ausgabe eines Speicher-Sinks an.
+ * @return 0 bei Erfolg, sonst ENOMEM.
+ */
+static int memory_append(rs_sink* sink, const uint8_t* data, size_t len) {
+    if (sink->memoryFill + len > sink->memoryCapacity) {
+        size_t capacity = (sink->memoryCapacity > 0) ? sink->memoryCapacity : RS_SINK_BUFFER_BYTES;
+        while (capacity < sink->memoryFill + len) {
+            capacity *= 2;
+        }
+        uint8_t* grown = (uint8_t*) realloc(sink->memory, capacity);
+        if (grown == NULL) {
+            return ENOMEM;
+        }
+        sink->memory = grown;
+        sink->memoryCapacity = capacity;
+    }
+    memcpy(sink->memory + sink->memoryFill, data, len);
+    sink->memoryFill += len;
+    return 0;
+}
+
+/**
+ * @brief Schreibt den Puffer an die aktuelle Position (ohne ausstehende Null-Folge).
+ */
+static int flush_buffer(rs_sink* sink) {
+    if (sink->error != 0) {
+        return 1;
+    }
+    if (sink->fill > 0 && sink->callback != NULL) {
+        sink->error = sink->callback(sink->callbackUser, sink->buffer, sink->fill);
+        sink->fill = 0;
+    } else if (sink->fill > 0 && sink->fd < 0) {
+        sink->error = memory_append(sink, sink->buffer, sink->fill);
+        sink->fill = 0;
+    } else if (sink->fill > 0) {
+        if (sink->regular && sink->offset + sink->fill > sink->reserved) {
+            uint64_t start = (sink->reserved > sink->offset) ? sink->reserved : sink->offset;
+            preallocate(sink, start, RS_SINK_PREALLOC_BYTES);
+        }
+        sink->error = write_all(sink->fd, sink->buffer, sink->fill);
+        sink->offset += sink->fill;
+        sink->fill = 0;
+    }
+    return sink->error != 0;
+}
+
+/**
+ * @brief Gibt reservierte Blöcke in [offset, end) wieder frei.
+ * * Hinter dem Dateiende ignoriert ext4 PUNCH_HOLE, daher wird die Datei vorher
+ * bis end verlängert (der Bereich liest sich ohnehin als Nullen).
+ */
+static void release(rs_sink* sink, uint64_t offset, uint64_t end) {
+#ifdef __linux__
+    if (end > sink->reserved) {
+        end = sink->reserved;
+    }
+    if (end <= offset || ftruncate(sink->fd, (off_t)end) != 0) {
+        return;
+    }
+    fallocate(sink->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)(end - offset));
+#else
+    (void)sink; (void)offset; (void)end;
+#endif
+}
+
+/**
+ * @brief Überspringt count Null-Samples per lseek und hinterlässt ein Loch.
+ */
+static int skip_zeros(rs_sink* sink, size_t count) {
+    if (flush_buffer(sink) != 0) {
+        return 1;
+    }
+
+    uint64_t bytes = (uint64_t)count * sizeof(int16_t);
+    if (lseek(sink->fd, (off_t)bytes, SEEK_CUR) < 0) {
+        sink->error = errno;
+        return 1;
+    }
+
+    // Bereits reservierte Blöcke im Loch freigeben, sonst bliebe es belegt
+    release(sink, sink->offset, sink->offset + bytes);
+
+    sink->offset += bytes;
+    sink->samplesWritten += count;
+    return 0;
+}
+
+static int append(rs_sink* sink, const int16_t* samples, size_t count);
+
+/**
+ * @brief Gibt die ausstehende Null-Folge aus: als Loch, falls lang genug, sonst als Daten.
+ */
+static int commit_zeros(rs_sink* sink) {
+    size_t count = sink->zeroRun;
+    sink->zeroRun = 0;
+
+    if (count >= RS_SINK_HOLE_MIN_SAMPLES) {
+        return skip_zeros(sink, count);
+    }
+    while (count > 0) {
+        size_t n = (count < 1024) ? count : 1024;
+        if (append(sink, zeros, n) != 0) {
+            return 1;
+        }
+        count -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Initialisiert einen Sink auf einen offenen Dateideskriptor.
+ */
+int rs_sink_init_fd(rs_sink* sink, int fd, rs_byte_order order) {
+    memset(sink, 0, sizeof(*sink));
+    sink->fd = fd;
+    sink->order = order;
+
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, RS_SINK_ALIGNMENT, RS_SINK_BUFFER_BYTES) != 0) {
+        fprintf(stderr, "Fehler: Speicherzuweisung für Ausgabepuffer fehlgeschlagen.\n");
+        return 1;
+    }
+    sink->buffer = (uint8_t*) buffer;
+    return 0;
+}
+
+/**
+ * @brief Initialisiert einen Sink, der die Ausgabe im Speicher sammelt.
+ */
+int rs_sink_init_memory(rs_sink* sink, rs_byte_order order) {
+    if (rs_sink_init_fd(sink, -1, order) != 0) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Initialisiert einen Sink, der jeden vollen Block an callback übergibt.
+ */
+int rs_sink_init_callback(rs_sink* sink, rs_byte_order order, rs_sink_callback callback, void* user) {
+    if (rs_sink_init_fd(sink, -1, order) != 0) {
+        return 1;
+    }
+    sink->callback = callback;
+    sink->callbackUser = user;
+    return 0;
+}
+
+/**
+ * @brief Leert einen Speicher-Sink (Puffer bleiben reserviert).
+ */
+void rs_sink_reset_memory(rs_sink* sink) {
+    sink->fill = 0;
+    sink->memoryFill = 0;
+    sink->error = 0;
+    sink->samplesWritten = 0;
+}
+
+/**
+ * @brief Öffnet eine Datei als Ziel, optional mit WAV-Container.
+ */
+int rs_sink_open_file(rs_sink* sink, const char* path, rs_byte_order order, uint32_t sampleRate) {
+    size_t len = strlen(path);
+    int wav = (len >= 4 && strcasecmp(path + len - 4, ".wav") == 0);
+
+    if (wav && order != RS_BYTE_ORDER_LE) {
+        fprintf(stderr, "Fehler: WAV-Dateien unterstützen nur S16_LE.\n");
+        return 1;
+    }
+
+    // Geräte und FIFOs nicht abschneiden (O_TRUNC ist dort undefiniert bzw. wirkungslos)
+    struct stat st;
+    int stream = (stat(path, &st) == 0 && (S_ISCHR(st.st_mode) || S_ISFIFO(st.st_mode)));
+    int fd = open(path, O_WRONLY | O_CREAT | (stream ? 0 : O_TRUNC), 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Fehler: Ausgabedatei '%s' konnte nicht geöffnet werden: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    if (rs_sink_init_fd(sink, fd, order) != 0) {
+        close(fd);
+        return 1;
+    }
+    // Löcher, fallocate und ftruncate nur bei regulären Dateien (lseek auf einer
+    // Pipe scheitert mit ESPIPE, ftruncate auf /dev/null mit EINVAL)
+    int regular = (fstat(fd, &st) == 0 && S_ISREG(st.st_mode));
+    sink->isFile = 1;
+    sink->regular = regular;
+    sink->wav = wav;
+    sink->sparse = regular;
+    sink->preallocate = regular;
+    sink->rate = sampleRate;
+
+    if (wav) {
+        // Platzhalter; die Längenfelder setzt rs_sink_close() (ohne reguläre
+        // Datei bleibt die größtmögliche Länge stehen)
+        uint8_t header[RS_WAV_HEADER_BYTES];
+        wav_header(header, sampleRate, regular ? 0 : UINT64_MAX);
+        sink->error = write_all(fd, header, sizeof(header));
+        sink->offset = sizeof(header);
+        if (sink->error != 0) {
+            fprintf(stderr, "Fehler: WAV-Header konnte nicht geschrieben werden: %s\n", strerror(sink->error));
+            rs_sink_close(sink);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reserviert Platz für die nächsten count Samples (nur Datei-Sinks).
+ */
+void rs_sink_reserve(rs_sink* sink, size_t count) {
+    if (!sink->regular) {
+        return;
+    }
+    if (sink->resampler != NULL) {
+        count = rs_resampler_max_output(sink->resampler, count);
+    }
+    uint64_t start = sink->offset + sink->fill;
+    preallocate(sink, start, (uint64_t)count * sizeof(int16_t));
+}
+
+/**
+ * @brief Schaltet einen Resampler vor die Ausgabe (inRate -> outRate).
+ */
+int rs_sink_set_rate(rs_sink* sink, uint32_t inRate, uint32_t outRate) {
+    // Gleiche Raten wie bisher: Filterbank und Puffer wiederverwenden
+    if (sink->resampler != NULL && sink->resampler->inRate == inRate &&
+        sink->resampler->outRate == outRate) {
+        rs_resampler_reset(sink->resampler);
+        sink->rate = outRate;
+        return 0;
+    }
+
+    rs_resampler_free(sink->resampler);
+    free(sink->resampled);
+    sink->resampler = NULL;
+    sink->resampled = NULL;
+
+    sink->rate = outRate;
+    if (inRate == outRate) {
+        return 0;
+    }
+
+    sink->resampler = rs_resampler_create(inRate, outRate);
+    if (sink->resampler == NULL) {
+        fprintf(stderr, "Fehler: Resampler für %u Hz konnte nicht angelegt werden.\n", outRate);
+        return 1;
+    }
+
+    sink->resampled = (int16_t*) malloc(sizeof(int16_t) *
+        rs_resampler_max_output(sink->resampler, RS_RESAMPLER_CHUNK));
+    if (sink->resampled == NULL) {
+        fprintf(stderr, "Fehler: Speicherzuweisung für Resampler-Puffer fehlgeschlagen.\n");
+        rs_resampler_free(sink->resampler);
+        sink->resampler = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Expliziter Flush-Punkt: schreibt den Puffer vollständig aus.
+ */
+int rs_sink_flush(rs_sink* sink) {
+    if (sink->zeroRun > 0 && commit_zeros(sink) != 0) {
+        return 1;
+    }
+    return flush_buffer(sink);
+}
+
+/**
+ * @brief Kopiert Samples in den Puffer (mit Byte-Tausch, falls nötig).
+ */
+static int append(rs_sink* sink, const int16_t* samples, size_t count) {
+    while (count > 0) {
+        if (sink->error != 0) {
+            return 1;
+        }
+
+        size_t room = (RS_SINK_BUFFER_BYTES - sink->fill) / sizeof(int16_t);
+        if (room == 0) {
+            flush_buffer(sink);
+            continue;
+        }
+
+        size_t n = (count < room) ? count : room;
+        uint8_t* dst = sink->buffer + sink->fill;
+
+        if (sink->order == RS_BYTE_ORDER_HOST) {
+            memcpy(dst, samples, n * sizeof(int16_t));
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                uint16_t v = (uint16_t)samples[i];
+                dst[2 * i] = (uint8_t)(v >> 8);
+                dst[2 * i + 1] = (uint8_t)(v & 0xFF);
+            }
+        }
+
+        sink->fill += n * sizeof(int16_t);
+        sink->samplesWritten += n;
+        samples += n;
+        count -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Wie append(), sammelt bei Datei-Sinks aber Null-Folgen für Löcher.
+ * * Null-Folgen werden über Aufrufgrenzen hinweg in zeroRun gezählt und erst beim
+ * nächsten Nicht-Null-Sample (oder Flush) als Loch bzw. Daten ausgegeben.
+ */
+static int emit(rs_sink* sink, const int16_t* samples, size_t count) {
+    if (!sink->sparse) {
+        return append(sink, samples, count);
+    }
+
+    size_t i = 0;
+    while (i < count) {
+        size_t start = i;
+        while (i < count && samples[i] == 0) {
+            i++;
+        }
+        sink->zeroRun += i - start;
+        if (i == count) {
+            break;
+        }
+
+        start = i;
+        while (i < count && samples[i] != 0) {
+            i++;
+        }
+        if ((sink->zeroRun > 0 && commit_zeros(sink) != 0) ||
+            append(sink, samples + start, i - start) != 0) {
+            return 1;
+        }
+    }
+    return sink->error != 0;
+}
+
+/**
+ * @brief Übernimmt count Samples (Host-Byte-Reihenfolge) in den Puffer.
+ */
+int rs_sink_write(rs_sink* sink, const int16_t* samples, size_t count) {
+    if (sink->resampler == NULL) {
+        return emit(sink, samples, count);
+    }
+
+    while (count > 0) {
+        size_t n = (count < RS_RESAMPLER_CHUNK) ? count : RS_RESAMPLER_CHUNK;
+        size_t produced = rs_resampler_process(sink->resampler, samples, n, sink->resampled);
+        if (emit(sink, sink->resampled, produced) != 0) {
+            return 1;
+        }
+        samples += n;
+        count -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Übernimmt bereits fertig kodierte Bytes unverändert.
+ */
+int rs_sink_write_bytes(rs_sink* sink, const uint8_t* data, size_t len) {
+    if (rs_sink_flush(sink) != 0) {
+        return 1;
+    }
+    if (sink->callback != NULL) {
+        sink->error = sink->callback(sink->callbackUser, data, len);
+    } else {
+        sink->error = (sink->fd < 0) ? memory_append(sink, data, len) : write_all(sink->fd, data, len);
+    }
+    if (sink->isFile && sink->error == 0) {
+        sink->offset += len;
+    }
+    sink->samplesWritten += len / sizeof(int16_t);
+    return sink->error != 0;
+}
+
+/**
+ * @brief Schreibt count Samples Stille.
+ * * Ohne Resampler landet die Stille bei Datei-Sinks direkt in der Null-Folge;
+ * mit Resampler läuft sie durch den Filter, dessen Ausgabe nach dem Nachlauf
+ * exakt null ist und von emit() ebenso erkannt wird.
+ */
+int rs_sink_write_silence(rs_sink* sink, size_t count) {
+    if (sink->sparse && sink->resampler == NULL) {
+        sink->zeroRun += count;
+        return sink->error != 0;
+    }
+
+    while (count > 0) {
+        size_t n = (count < 1024) ? count : 1024;
+        if (rs_sink_write(sink, zeros, n) != 0) {
+            return 1;
+        }
+        count -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Schiebt den Resampler-Nachlauf aus und flusht (Ende eines Abschnitts).
+ */
+int rs_sink_end_segment(rs_sink* sink) {
+    if (sink->resampler != NULL) {
+        size_t produced = rs_resampler_flush(sink->resampler, sink->resampled);
+        emit(sink, sink->resampled, produced);
+        rs_resampler_reset(sink->resampler);
+    }
+    return rs_sink_flush(sink);
+}
+
+/**
+ * @brief Schiebt den Resampler-Nachlauf aus, flusht und gibt die Puffer frei.
+ */
+int rs_sink_close(rs_sink* sink) {
+    int result = rs_sink_end_segment(sink);
+
+    if (sink->isFile) {
+        if (sink->regular) {
+            // Überschüssige Reservierung freigeben, dann die Länge setzen (deckt
+            // auch ein Loch am Dateiende ab)
+            release(sink, sink->offset, sink->reserved);
+            if (sink->error == 0 && ftruncate(sink->fd, (off_t)sink->offset) != 0) {
+                sink->error = errno;
+            }
+            if (sink->error == 0 && sink->wav) {
+                uint8_t header[RS_WAV_HEADER_BYTES];
+                wav_header(header, sink->rate, sink->offset - RS_WAV_HEADER_BYTES);
+                if (pwrite(sink->fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+                    sink->error = errno ? errno : EIO;
+                }
+            }
+        }
+        if (close(sink->fd) != 0 && sink->error == 0) {
+            sink->error = errno;
+        }
+        sink->fd = -1;
+        result = sink->error != 0;
+    }
+
+    rs_resampler_free(sink->resampler);
+    free(sink->resampled);
+    free(sink->buffer);
+    free(sink->memory);
+    sink->resampler = NULL;
+    sink->resampled = NULL;
+    sink->buffer = NULL;
+    sink->memory = NULL;
+
+    return result;
+}